@@ -0,0 +1,114 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <Barrier.hpp>
+#include "Bench.hpp"
+
+using simons_lib::barrier::SpinBarrier;
+
+namespace
+{
+constexpr auto PHASES = std::uint64_t(20000);
+
+// Generation counting barrier on std::mutex and std::condition_variable,
+// the behavior of std::barrier (C++20) without spinning.
+class CondVarBarrier
+{
+public:
+    explicit CondVarBarrier(unsigned count)
+        : m_count(count)
+    {
+    }
+
+    void arrive_and_wait(void)
+    {
+        auto lock = std::unique_lock<std::mutex>(m_mutex);
+        auto const generation = m_generation;
+        if (++m_arrived == m_count)
+        {
+            m_arrived = 0;
+            ++m_generation;
+            m_cond.notify_all();
+            return;
+        }
+        m_cond.wait(lock, [this, generation] () { return m_generation != generation; });
+    }
+
+private:
+    std::mutex              m_mutex;
+    std::condition_variable m_cond;
+    unsigned const          m_count;
+    unsigned                m_arrived = 0;
+    std::uint64_t           m_generation = 0;
+};
+} // namespace
+
+BENCHMARK(Barrier, phaseLatency)
+{
+    auto maxThreads = std::max(2u, std::thread::hardware_concurrency());
+    auto counts = std::vector<unsigned>();
+    for (auto threads = 2u; threads < maxThreads; threads *= 2u)
+    {
+        counts.push_back(threads);
+    }
+    counts.push_back(maxThreads);
+
+    for (auto threads : counts)
+    {
+        auto const suffix = " threads=" + std::to_string(threads);
+
+        auto condVar = CondVarBarrier(threads);
+        bench::measureParallel("std::mutex + std::condition_variable" + suffix, threads, PHASES, [&condVar] ()
+        {
+            condVar.arrive_and_wait();
+        });
+
+        auto parking = SpinBarrier(threads, std::chrono::nanoseconds(0));
+        bench::measureParallel("SpinBarrier spin=0" + suffix, threads, PHASES, [&parking] ()
+        {
+            parking.arrive_and_wait();
+        });
+
+        auto spinning = SpinBarrier(threads);
+        bench::measureParallel("SpinBarrier spin=50us" + suffix, threads, PHASES, [&spinning] ()
+        {
+            spinning.arrive_and_wait();
+        });
+    }
+}
@@ -0,0 +1,246 @@
+/**
+ * @file      Bench.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Minimal benchmark registry and timing helpers.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BENCH_HPP_20190301080000
+#define BENCH_HPP_20190301080000
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace bench
+{
+
+/**
+ * @brief Prevent the compiler from optimizing away a computed value.
+ * @param[in] value   Value that must be materialized.
+ */
+template<typename T>
+inline void doNotOptimize(T const& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @brief A registered benchmark.
+ */
+struct Benchmark
+{
+    std::string           name; ///< Benchmark name (Suite.Case).
+    std::function<void()> func; ///< Benchmark body.
+};
+
+/**
+ * @brief Access the process wide benchmark registry.
+ * @returns Reference to all registered benchmarks.
+ */
+inline std::vector<Benchmark>& registry(void)
+{
+    static auto benchmarks = std::vector<Benchmark>();
+    return benchmarks;
+}
+
+/**
+ * @brief Helper whose construction registers a benchmark.
+ */
+struct Registrar
+{
+    Registrar(std::string name, std::function<void()> func)
+    {
+        registry().push_back(Benchmark{std::move(name), std::move(func)});
+    }
+};
+
+/**
+ * @brief Run a callable @p ops times and report throughput.
+ * @param[in] label   Label printed in front of the result.
+ * @param[in] ops     Number of iterations.
+ * @param[in] func    Callable executed once per iteration.
+ * @param[in] items   Number of items processed per iteration.
+ * @returns Measured nanoseconds per item.
+ */
+template<typename F>
+double measure(std::string const& label, std::uint64_t ops, F&& func, std::uint64_t items = 1)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (auto i = std::uint64_t(0); i < ops; ++i)
+    {
+        func();
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    auto ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+    auto nsPerOp = ns / static_cast<double>(ops * items);
+    std::printf("  %-72s %8.2f ns/op %10.2f Mops/s\n", label.c_str(), nsPerOp, 1e3 / nsPerOp);
+    return nsPerOp;
+}
+
+/**
+ * @brief Read the time stamp counter of the CPU.
+ * @note On x86 this counts reference cycles, which differ from core cycles
+ *       if the clock frequency is scaled.
+ * @returns Current counter value, 0 if the target has no supported counter.
+ */
+inline std::uint64_t cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Run a callable @p ops times and report time stamp counter cycles per iteration.
+ * @param[in] label   Label printed in front of the result.
+ * @param[in] ops     Number of iterations.
+ * @param[in] func    Callable executed once per iteration.
+ * @returns Measured cycles per iteration, 0 if the target has no supported counter.
+ */
+template<typename F>
+double measureCycles(std::string const& label, std::uint64_t ops, F&& func)
+{
+    auto start = cycles();
+    for (auto i = std::uint64_t(0); i < ops; ++i)
+    {
+        func();
+    }
+    auto stop = cycles();
+
+    auto cyclesPerOp = static_cast<double>(stop - start) / static_cast<double>(ops);
+    std::printf("  %-72s %8.2f cycles/op\n", label.c_str(), cyclesPerOp);
+    return cyclesPerOp;
+}
+
+/**
+ * @brief Run a callable @p ops times on each of @p threads threads and report throughput.
+ * @param[in] label     Label printed in front of the result.
+ * @param[in] threads   Number of threads executing @p func concurrently.
+ * @param[in] ops       Number of iterations per thread.
+ * @param[in] func      Callable executed once per iteration.
+ * @returns Wall-clock nanoseconds per operation per thread: the elapsed time divided
+ *          by @p ops. Equals the cost of one operation if all threads run in parallel
+ *          without contention, higher otherwise.
+ */
+template<typename F>
+double measureParallel(std::string const& label, unsigned threads, std::uint64_t ops, F const& func)
+{
+    auto ready = std::atomic<unsigned>(0);
+    auto work = [&ready, threads, ops, &func] ()
+    {
+        // Start all threads at the same time.
+        ready.fetch_add(1);
+        while (ready.load() < threads)
+        {
+        }
+        for (auto i = std::uint64_t(0); i < ops; ++i)
+        {
+            func();
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    auto workers = std::vector<std::thread>();
+    for (auto i = 1u; i < threads; ++i)
+    {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    auto ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+    auto wallNsPerOpPerThread = ns / static_cast<double>(ops);
+    auto mops = 1e3 * static_cast<double>(ops * threads) / ns;
+    std::printf("  %-72s %8.2f wall ns/op/thread %10.2f Mops/s\n", label.c_str(), wallNsPerOpPerThread, mops);
+    return wallNsPerOpPerThread;
+}
+
+/**
+ * @brief Access the process wide number of failed checks.
+ * @returns Reference to the failure counter.
+ */
+inline int& failures(void)
+{
+    static auto count = 0;
+    return count;
+}
+
+/**
+ * @brief Report the outcome of a check. Failed checks make the benchmark run fail.
+ * @param[in] label    Label printed in front of the result.
+ * @param[in] passed   Outcome of the check.
+ * @param[in] detail   Additional information printed behind the result.
+ */
+inline void check(std::string const& label, bool passed, std::string const& detail)
+{
+    if (!passed)
+    {
+        ++failures();
+    }
+    std::printf("  %-72s %s %s\n", label.c_str(), passed ? "PASS" : "FAIL", detail.c_str());
+}
+
+} // namespace bench
+
+/**
+ * @brief Define and register a benchmark.
+ * @param suite   Benchmark suite name.
+ * @param name    Benchmark case name.
+ */
+#define BENCHMARK(suite, name)                                               \
+    static void bench_##suite##_##name(void);                                \
+    static bench::Registrar const registrar_##suite##_##name(                \
+        #suite "." #name, bench_##suite##_##name);                           \
+    static void bench_##suite##_##name(void)
+
+#endif // BENCH_HPP_20190301080000
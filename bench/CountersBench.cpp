@@ -0,0 +1,92 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <Counters.hpp>
+#include <LockGuard.hpp>
+#include "Bench.hpp"
+
+using simons_lib::counters::ShardedCounter;
+using simons_lib::counters::ShardedHistogram;
+using simons_lib::lock::LockGuard;
+
+namespace
+{
+constexpr auto OPS_PER_THREAD = std::uint64_t(2000000);
+} // namespace
+
+BENCHMARK(Counters, increment)
+{
+    auto maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    auto counts = std::vector<unsigned>();
+    for (auto threads = 1u; threads < maxThreads; threads *= 2u)
+    {
+        counts.push_back(threads);
+    }
+    counts.push_back(maxThreads);
+
+    for (auto threads : counts)
+    {
+        auto const suffix = " threads=" + std::to_string(threads);
+
+        auto mutex = std::mutex();
+        auto locked = std::uint64_t(0);
+        bench::measureParallel("std::mutex + counter" + suffix, threads, OPS_PER_THREAD, [&mutex, &locked] ()
+        {
+            auto guard = LockGuard<std::mutex>(mutex);
+            ++locked;
+        });
+
+        auto shared = std::atomic<std::uint64_t>(0);
+        bench::measureParallel("std::atomic<std::uint64_t>" + suffix, threads, OPS_PER_THREAD, [&shared] ()
+        {
+            shared.fetch_add(1, std::memory_order_relaxed);
+        });
+
+        auto sharded = ShardedCounter();
+        bench::measureParallel("ShardedCounter" + suffix, threads, OPS_PER_THREAD, [&sharded] ()
+        {
+            sharded.add();
+        });
+
+        auto histogram = ShardedHistogram();
+        bench::measureParallel("ShardedHistogram" + suffix, threads, OPS_PER_THREAD, [&histogram] ()
+        {
+            histogram.record(42u);
+        });
+    }
+}
@@ -0,0 +1,211 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include <Distributions.hpp>
+#include "Bench.hpp"
+
+using simons_lib::distributions::BoundedIntDistribution;
+using simons_lib::distributions::ZigguratNormalDistribution;
+using simons_lib::distributions::ZigguratExponentialDistribution;
+using simons_lib::distributions::AliasDistribution;
+using simons_lib::distributions::UniformRealDistribution;
+
+namespace
+{
+constexpr auto OPS = std::uint64_t(20000000);
+
+template<typename E, typename T>
+void compareBoundedInt(std::string const& engineName, T upperBound)
+{
+    auto suffix = engineName + " [0, " + std::to_string(upperBound) + "]";
+
+    auto engine = E(42);
+    auto stdDist = std::uniform_int_distribution<T>(0, upperBound);
+    bench::measure("std::uniform_int_distribution " + suffix, OPS, [&] ()
+    {
+        bench::doNotOptimize(stdDist(engine));
+    });
+
+    auto dist = BoundedIntDistribution<T>(0, upperBound);
+    bench::measure("BoundedIntDistribution " + suffix, OPS, [&] ()
+    {
+        bench::doNotOptimize(dist(engine));
+    });
+
+    auto values = std::vector<T>(1024);
+    auto stdValues = std::vector<T>(1024);
+    bench::measure("std::uniform_int_distribution x1024 " + suffix, OPS / 1024, [&] ()
+    {
+        for (auto& value : stdValues)
+        {
+            value = stdDist(engine);
+        }
+        bench::doNotOptimize(stdValues.data());
+    }, 1024);
+    bench::measure("BoundedIntDistribution::generate x1024 " + suffix, OPS / 1024, [&] ()
+    {
+        dist.generate(values.begin(), values.end(), engine);
+        bench::doNotOptimize(values.data());
+    }, 1024);
+}
+
+template<typename StdDist, typename Dist>
+void compareReal(std::string const& name, StdDist stdDist, Dist dist)
+{
+    auto engine = std::mt19937_64(42);
+    bench::measure("std::" + name, OPS, [&] ()
+    {
+        bench::doNotOptimize(stdDist(engine));
+    });
+    bench::measure("Ziggurat " + name, OPS, [&] ()
+    {
+        bench::doNotOptimize(dist(engine));
+    });
+
+    auto values = std::vector<double>(1024);
+    bench::measure("Ziggurat " + name + "::generate x1024", OPS / 1024, [&] ()
+    {
+        dist.generate(values.begin(), values.end(), engine);
+        bench::doNotOptimize(values.data());
+    }, 1024);
+}
+}
+
+BENCHMARK(BoundedIntDistribution, smallRange)
+{
+    compareBoundedInt<std::mt19937, std::uint32_t>("mt19937", 5u);
+    compareBoundedInt<std::mt19937_64, std::uint32_t>("mt19937_64", 5u);
+    compareBoundedInt<std::mt19937_64, std::uint32_t>("mt19937_64", 999u);
+}
+
+BENCHMARK(BoundedIntDistribution, largeRange)
+{
+    compareBoundedInt<std::mt19937, std::uint32_t>("mt19937", 3000000000u);
+    compareBoundedInt<std::mt19937_64, std::uint64_t>("mt19937_64", 12000000000000000000u);
+}
+
+BENCHMARK(Ziggurat, normal)
+{
+    compareReal("normal_distribution", std::normal_distribution<double>(), ZigguratNormalDistribution<double>());
+}
+
+BENCHMARK(Ziggurat, exponential)
+{
+    compareReal("exponential_distribution", std::exponential_distribution<double>(),
+                ZigguratExponentialDistribution<double>());
+}
+
+BENCHMARK(UniformRealDistribution, unitInterval)
+{
+    auto engine = std::mt19937_64(42);
+    bench::measure("mt19937_64 raw", OPS, [&] ()
+    {
+        bench::doNotOptimize(engine());
+    });
+
+    auto stdDouble = std::uniform_real_distribution<double>(0.0, 1.0);
+    bench::measure("std::uniform_real_distribution<double>", OPS, [&] ()
+    {
+        bench::doNotOptimize(stdDouble(engine));
+    });
+
+    auto stdFloat = std::uniform_real_distribution<float>(0.0f, 1.0f);
+    bench::measure("std::uniform_real_distribution<float>", OPS, [&] ()
+    {
+        bench::doNotOptimize(stdFloat(engine));
+    });
+
+    auto doubles = UniformRealDistribution<double>(0.0, 1.0);
+    bench::measure("UniformRealDistribution<double>", OPS, [&] ()
+    {
+        bench::doNotOptimize(doubles(engine));
+    });
+
+    auto floats = UniformRealDistribution<float>(0.0f, 1.0f);
+    bench::measure("UniformRealDistribution<float>", OPS, [&] ()
+    {
+        bench::doNotOptimize(floats(engine));
+    });
+
+    auto values = std::vector<double>(1024);
+    bench::measure("std::uniform_real_distribution<double> x1024", OPS / 1024, [&] ()
+    {
+        for (auto& value : values)
+        {
+            value = stdDouble(engine);
+        }
+        bench::doNotOptimize(values.data());
+    }, 1024);
+    bench::measure("UniformRealDistribution<double>::generate x1024", OPS / 1024, [&] ()
+    {
+        doubles.generate(values.begin(), values.end(), engine);
+        bench::doNotOptimize(values.data());
+    }, 1024);
+}
+
+BENCHMARK(AliasDistribution, categories)
+{
+    for (auto categories : {16u, 1024u, 131072u, 1048576u})
+    {
+        auto weights = std::vector<double>(categories);
+        auto weightEngine = std::mt19937_64(1);
+        for (auto& weight : weights)
+        {
+            weight = std::uniform_real_distribution<double>(0.0, 1.0)(weightEngine);
+        }
+
+        auto suffix = " n=" + std::to_string(categories);
+        auto engine = std::mt19937_64(42);
+        auto stdDist = std::discrete_distribution<std::uint32_t>(weights.begin(), weights.end());
+        bench::measure("std::discrete_distribution" + suffix, OPS / 4, [&] ()
+        {
+            bench::doNotOptimize(stdDist(engine));
+        });
+
+        auto dist = AliasDistribution<std::uint32_t>(weights.begin(), weights.end());
+        bench::measure("AliasDistribution" + suffix, OPS / 4, [&] ()
+        {
+            bench::doNotOptimize(dist(engine));
+        });
+
+        auto index = std::size_t(0);
+        bench::measure("AliasDistribution::updateWeight" + suffix, 1000, [&] ()
+        {
+            dist.updateWeight(index, weights[index] * 1.01);
+            index = (index + 1) % categories;
+        });
+    }
+}
@@ -0,0 +1,73 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <Engines.hpp>
+#include "Bench.hpp"
+
+using simons_lib::engines::Pcg32;
+using simons_lib::engines::XorShift32;
+using simons_lib::engines::XorShift64;
+using simons_lib::engines::SplitMix64;
+
+namespace
+{
+constexpr auto OPS = std::uint64_t(50000000);
+
+template<typename E>
+void measureEngine(std::string const& name)
+{
+    auto engine = E();
+    auto label = name + " (" + std::to_string(sizeof(E)) + " bytes state)";
+    bench::measure(label, OPS, [&] ()
+    {
+        bench::doNotOptimize(engine());
+    });
+    bench::measureCycles(label, OPS, [&] ()
+    {
+        bench::doNotOptimize(engine());
+    });
+}
+}
+
+BENCHMARK(Engines, compact)
+{
+    measureEngine<std::mt19937>("std::mt19937");
+    measureEngine<std::mt19937_64>("std::mt19937_64");
+    measureEngine<std::minstd_rand>("std::minstd_rand");
+    measureEngine<Pcg32>("Pcg32");
+    measureEngine<XorShift32>("XorShift32");
+    measureEngine<XorShift64>("XorShift64");
+    measureEngine<SplitMix64>("SplitMix64");
+}
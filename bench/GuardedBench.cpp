@@ -0,0 +1,149 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <Guarded.hpp>
+#include <LockGuard.hpp>
+#include <Stack.hpp>
+#include "Bench.hpp"
+
+using simons_lib::guarded::FlatCombined;
+using simons_lib::guarded::Guarded;
+using simons_lib::guarded::ShardedArray;
+using simons_lib::lock::LockGuard;
+using simons_lib::stack::Stack;
+
+namespace
+{
+constexpr auto OPS_PER_THREAD = std::uint64_t(2000000);
+constexpr auto STACK_OPS_PER_THREAD = std::uint64_t(500000);
+
+using BenchStack = Stack<std::uint64_t, 64>;
+
+// Push followed by pop, the stack never overflows.
+inline void pushPop(BenchStack& stack)
+{
+    stack.push(std::uint64_t(1));
+    stack.pop();
+}
+
+// Per-shard mutex and counter without padding, neighbours share cache lines.
+struct PackedShard
+{
+    std::mutex    mutex;
+    std::uint64_t counter = 0;
+};
+
+// Each thread increments the counter of its own shard.
+template<typename F>
+void perThreadShard(std::string const& name, unsigned threads, F&& increment)
+{
+    static auto generation = 0u;
+    auto const run = ++generation;
+    auto next = std::atomic<unsigned>(0);
+    bench::measureParallel(name + " threads=" + std::to_string(threads), threads, OPS_PER_THREAD, [run, &next, &increment] ()
+    {
+        // Assign shards once per thread and run.
+        thread_local auto shard = 0u;
+        thread_local auto shardRun = 0u;
+        if (shardRun != run)
+        {
+            shard = next.fetch_add(1u);
+            shardRun = run;
+        }
+        increment(shard);
+    });
+}
+} // namespace
+
+BENCHMARK(Guarded, falseSharing)
+{
+    auto maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    auto counts = std::vector<unsigned>();
+    for (auto threads = 1u; threads < maxThreads; threads *= 2u)
+    {
+        counts.push_back(threads);
+    }
+    counts.push_back(maxThreads);
+
+    for (auto threads : counts)
+    {
+        auto packed = std::vector<PackedShard>(threads);
+        perThreadShard("packed std::mutex + counter", threads, [&packed] (unsigned shard)
+        {
+            auto guard = LockGuard<std::mutex>(packed[shard].mutex);
+            ++packed[shard].counter;
+        });
+
+        auto sharded = ShardedArray<std::uint64_t, std::mutex>(threads);
+        perThreadShard("ShardedArray<std::uint64_t, std::mutex>", threads, [&sharded] (unsigned shard)
+        {
+            sharded[shard].apply([] (std::uint64_t& counter) { ++counter; });
+        });
+    }
+}
+
+BENCHMARK(Guarded, flatCombining)
+{
+    std::thread([] () {}).join(); // Make glibc take the multi-threaded locking path.
+
+    auto maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    auto counts = std::vector<unsigned>();
+    for (auto threads = 1u; threads < maxThreads; threads *= 2u)
+    {
+        counts.push_back(threads);
+    }
+    counts.push_back(maxThreads);
+
+    for (auto threads : counts)
+    {
+        auto const suffix = " threads=" + std::to_string(threads);
+
+        auto guarded = Guarded<BenchStack, std::mutex>();
+        bench::measureParallel("Guarded<Stack, std::mutex> push+pop" + suffix, threads, STACK_OPS_PER_THREAD, [&guarded] ()
+        {
+            guarded.apply(pushPop);
+        });
+
+        auto combined = FlatCombined<BenchStack, std::mutex>();
+        bench::measureParallel("FlatCombined<Stack, std::mutex> push+pop" + suffix, threads, STACK_OPS_PER_THREAD, [&combined] ()
+        {
+            combined.apply(pushPop);
+        });
+    }
+}
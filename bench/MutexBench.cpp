@@ -0,0 +1,172 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <LockGuard.hpp>
+#include <Mutex.hpp>
+#include "Bench.hpp"
+
+using simons_lib::lock::LockGuard;
+using simons_lib::mutex::SpinLock;
+using simons_lib::mutex::TicketLock;
+using simons_lib::mutex::McsLock;
+using simons_lib::mutex::FutexMutex;
+using simons_lib::mutex::InstrumentedMutex;
+
+namespace
+{
+constexpr auto OPS_PER_THREAD = std::uint64_t(200000);
+
+// Hammer a single lock from several threads. Each thread records the time it
+// waited for every acquisition. Reports throughput and wait time percentiles.
+template<typename M>
+void contend(std::string const& name, unsigned threads)
+{
+    auto mutex = M();
+    auto counter = std::uint64_t(0);
+    auto ready = std::atomic<unsigned>(0);
+    auto waits = std::vector<std::vector<std::uint64_t>>(threads, std::vector<std::uint64_t>(OPS_PER_THREAD));
+
+    auto work = [&] (unsigned id)
+    {
+        auto& samples = waits[id];
+        ready.fetch_add(1);
+        while (ready.load() < threads)
+        {
+        }
+
+        for (auto i = std::uint64_t(0); i < OPS_PER_THREAD; ++i)
+        {
+            auto start = std::chrono::steady_clock::now();
+            auto guard = LockGuard<M>(mutex);
+            auto stop = std::chrono::steady_clock::now();
+            samples[i] = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+
+            // Short critical section of a few nanoseconds.
+            counter = counter + 1u;
+            bench::doNotOptimize(counter);
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    auto workers = std::vector<std::thread>();
+    for (auto id = 1u; id < threads; ++id)
+    {
+        workers.emplace_back(work, id);
+    }
+    work(0);
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    auto all = std::vector<std::uint64_t>();
+    all.reserve(threads * OPS_PER_THREAD);
+    for (auto const& samples : waits)
+    {
+        all.insert(all.end(), samples.begin(), samples.end());
+    }
+    auto percentile = [&all] (double p)
+    {
+        auto index = static_cast<std::size_t>(p * static_cast<double>(all.size() - 1u));
+        std::nth_element(all.begin(), all.begin() + static_cast<std::ptrdiff_t>(index), all.end());
+        return all[index];
+    };
+
+    auto ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+    auto mops = 1e3 * static_cast<double>(threads * OPS_PER_THREAD) / ns;
+    auto label = name + " threads=" + std::to_string(threads);
+    std::printf("  %-40s %8.2f Mops/s  wait p50 %8llu ns  p99 %8llu ns  p99.9 %9llu ns\n", label.c_str(), mops,
+                static_cast<unsigned long long>(percentile(0.5)), static_cast<unsigned long long>(percentile(0.99)),
+                static_cast<unsigned long long>(percentile(0.999)));
+    bench::check(label + " mutual exclusion", counter == threads * OPS_PER_THREAD, "");
+}
+}
+
+BENCHMARK(Mutex, contention)
+{
+    // Powers of two up to the number of hardware threads. Oversubscription is
+    // left out, FIFO locks degrade to the scheduler time slice there.
+    auto maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    auto counts = std::vector<unsigned>();
+    for (auto threads = 1u; threads < maxThreads; threads *= 2u)
+    {
+        counts.push_back(threads);
+    }
+    counts.push_back(maxThreads);
+
+    for (auto threads : counts)
+    {
+        contend<std::mutex>("std::mutex", threads);
+        contend<SpinLock>("SpinLock", threads);
+        contend<TicketLock>("TicketLock", threads);
+        contend<McsLock>("McsLock", threads);
+        contend<FutexMutex>("FutexMutex", threads);
+    }
+}
+
+BENCHMARK(Mutex, uncontended)
+{
+    constexpr auto OPS = std::uint64_t(20000000);
+
+    // glibc skips atomic instructions in std::mutex as long as the process
+    // never started a thread. Mutexes matter in multithreaded processes only.
+    std::thread([] () {}).join();
+
+    auto uncontended = [] (std::string const& name, auto& mutex)
+    {
+        using M = std::remove_reference_t<decltype(mutex)>;
+        bench::measure(name + " lock/unlock (" + std::to_string(sizeof(M)) + " bytes)", OPS, [&mutex] ()
+        {
+            auto guard = LockGuard<M>(mutex);
+            bench::doNotOptimize(mutex);
+        });
+    };
+
+    auto stdMutex = std::mutex();
+    auto spinLock = SpinLock();
+    auto futexMutex = FutexMutex();
+    auto instrumented = InstrumentedMutex<std::mutex>("Mutex.uncontended");
+    uncontended("std::mutex", stdMutex);
+    uncontended("SpinLock", spinLock);
+    uncontended("FutexMutex", futexMutex);
+    uncontended("InstrumentedMutex<std::mutex>", instrumented);
+}
@@ -0,0 +1,158 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <Distributions.hpp>
+#include <NullTypes.hpp>
+#include <RandomNumberGenerator.hpp>
+#include "Bench.hpp"
+#include "Statistics.hpp"
+
+using simons_lib::distributions::BoundedIntDistribution;
+using simons_lib::distributions::ZigguratNormalDistribution;
+using simons_lib::null_types::NullMutex;
+using simons_lib::random_number_generator::RandomNumberGenerator;
+
+namespace
+{
+constexpr auto OPS = std::uint64_t(5000000);
+constexpr auto SAMPLES = 1000000u;
+constexpr auto MIN_P_VALUE = 1e-4;
+constexpr auto MAX_Z_SCORE = 4.0;
+
+// Engine/distribution combinations are measured with NullMutex on a single
+// thread and with std::mutex on 1, 2, 4, ... hardware_concurrency threads.
+template<typename E, typename D>
+void throughput(std::string const& name)
+{
+    auto rng = RandomNumberGenerator<E, D>(42);
+    bench::measure(name + " NullMutex threads=1", OPS, [&] ()
+    {
+        bench::doNotOptimize(rng());
+    });
+
+    auto syncRng = RandomNumberGenerator<E, D, std::mutex>(42);
+    auto maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (auto threads = 1u; threads <= maxThreads; threads *= 2u)
+    {
+        bench::measureParallel(name + " std::mutex threads=" + std::to_string(threads), threads, OPS / threads, [&] ()
+        {
+            bench::doNotOptimize(syncRng());
+        });
+    }
+}
+
+// Chi-square test over 64 equally likely buckets of an integer distribution.
+template<typename E, typename D>
+void uniformQuality(std::string const& name)
+{
+    auto rng = RandomNumberGenerator<E, D>(42);
+    rng.setBoundries(0, 63);
+
+    auto counts = std::vector<std::uint64_t>(64);
+    for (auto i = 0u; i < SAMPLES; ++i)
+    {
+        ++counts[static_cast<std::size_t>(rng())];
+    }
+    auto pValue = bench::chiSquarePValue(bench::chiSquareUniform(counts), 63.0);
+    bench::check(name + " chi-square 64 buckets", pValue > MIN_P_VALUE, "p=" + std::to_string(pValue));
+}
+
+// Chi-square test over 32 equally likely buckets of a standard normal distribution.
+template<typename E, typename D>
+void normalQuality(std::string const& name)
+{
+    auto rng = RandomNumberGenerator<E, D>(42);
+    auto counts = std::vector<std::uint64_t>(32);
+    for (auto i = 0u; i < SAMPLES; ++i)
+    {
+        auto bucket = static_cast<std::size_t>(bench::normalCdf(static_cast<double>(rng())) * 32.0);
+        ++counts[(bucket < 32u) ? bucket : 31u];
+    }
+    auto pValue = bench::chiSquarePValue(bench::chiSquareUniform(counts), 31.0);
+    bench::check(name + " chi-square 32 quantiles", pValue > MIN_P_VALUE, "p=" + std::to_string(pValue));
+}
+
+// Birthday spacings test on the full 32 bit output of an engine.
+template<typename E>
+void engineQuality(std::string const& name)
+{
+    auto rng = RandomNumberGenerator<E, BoundedIntDistribution<std::uint32_t>>(42);
+    auto z = bench::birthdaySpacingsZScore([&rng] ()
+    {
+        return rng();
+    }, 4000u);
+    bench::check(name + " birthday spacings", std::abs(z) < MAX_Z_SCORE, "z=" + std::to_string(z));
+}
+
+template<typename E>
+void engineSuite(std::string const& name)
+{
+    throughput<E, std::uniform_int_distribution<int>>(name + " std::uniform_int");
+    throughput<E, BoundedIntDistribution<int>>(name + " BoundedInt");
+    throughput<E, std::uniform_real_distribution<double>>(name + " std::uniform_real");
+    throughput<E, std::normal_distribution<double>>(name + " std::normal");
+    throughput<E, ZigguratNormalDistribution<double>>(name + " ZigguratNormal");
+}
+
+template<typename E>
+void qualitySuite(std::string const& name)
+{
+    engineQuality<E>(name);
+    uniformQuality<E, std::uniform_int_distribution<int>>(name + " std::uniform_int");
+    uniformQuality<E, BoundedIntDistribution<int>>(name + " BoundedInt");
+    normalQuality<E, std::normal_distribution<double>>(name + " std::normal");
+    normalQuality<E, ZigguratNormalDistribution<double>>(name + " ZigguratNormal");
+}
+}
+
+BENCHMARK(RandomNumberGenerator, throughput)
+{
+    engineSuite<std::minstd_rand>("minstd_rand");
+    engineSuite<std::mt19937>("mt19937");
+    engineSuite<std::mt19937_64>("mt19937_64");
+    engineSuite<std::ranlux48>("ranlux48");
+}
+
+BENCHMARK(RandomNumberGenerator, quality)
+{
+    qualitySuite<std::minstd_rand>("minstd_rand");
+    qualitySuite<std::mt19937>("mt19937");
+    qualitySuite<std::mt19937_64>("mt19937_64");
+    qualitySuite<std::ranlux48>("ranlux48");
+}
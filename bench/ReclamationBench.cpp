@@ -0,0 +1,119 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <LockGuard.hpp>
+#include <Reclamation.hpp>
+#include "Bench.hpp"
+
+using simons_lib::lock::LockGuard;
+using simons_lib::lock::SharedLockGuard;
+using simons_lib::reclamation::Rcu;
+
+namespace
+{
+constexpr auto READS_PER_THREAD = std::uint64_t(1000000);
+
+// Large configuration object, readers look at a single field.
+struct Config
+{
+    std::array<std::uint64_t, 64> limits;
+};
+
+// Reference implementation: shared_ptr to the current version guarded by a lock.
+template<typename M, template<typename> class G>
+class Guarded
+{
+public:
+    std::uint64_t read(void)
+    {
+        auto guard = G<M>(m_mutex);
+        return m_config->limits[7];
+    }
+
+private:
+    M                             m_mutex;
+    std::shared_ptr<Config const> m_config = std::make_shared<Config const>();
+};
+
+class RcuHolder
+{
+public:
+    std::uint64_t read(void)
+    {
+        return m_config.read()->limits[7];
+    }
+
+private:
+    Rcu<Config> m_config = Rcu<Config>(std::make_unique<Config const>());
+};
+
+template<typename H>
+void readConfig(std::string const& name, unsigned threads)
+{
+    auto holder = H();
+    bench::measureParallel(name + " threads=" + std::to_string(threads), threads, READS_PER_THREAD, [&holder] ()
+    {
+        bench::doNotOptimize(holder.read());
+    });
+}
+} // namespace
+
+BENCHMARK(Rcu, read)
+{
+    // glibc skips atomic instructions in std::mutex as long as the process
+    // never started a thread. Mutexes matter in multithreaded processes only.
+    std::thread([] () {}).join();
+
+    auto maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    auto counts = std::vector<unsigned>();
+    for (auto threads = 1u; threads < maxThreads; threads *= 2u)
+    {
+        counts.push_back(threads);
+    }
+    counts.push_back(maxThreads);
+
+    for (auto threads : counts)
+    {
+        readConfig<Guarded<std::mutex, LockGuard>>("LockGuard<std::mutex>", threads);
+        readConfig<Guarded<std::shared_mutex, SharedLockGuard>>("SharedLockGuard<std::shared_mutex>", threads);
+        readConfig<RcuHolder>("Rcu", threads);
+    }
+}
@@ -0,0 +1,139 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <RandomNumberGenerator.hpp>
+#include <Sampling.hpp>
+#include "Bench.hpp"
+
+using simons_lib::sampling::shuffle;
+using simons_lib::sampling::parallelShuffle;
+using simons_lib::sampling::floydSample;
+using simons_lib::sampling::ReservoirSampler;
+using simons_lib::sampling::WeightedReservoirSampler;
+using simons_lib::random_number_generator::RandomNumberGenerator;
+
+BENCHMARK(Shuffle, largeArray)
+{
+    constexpr auto SIZE = std::size_t(1) << 25;
+    auto values = std::vector<std::uint32_t>(SIZE);
+    std::iota(values.begin(), values.end(), 0u);
+    auto engine = std::mt19937_64(42);
+
+    bench::measure("std::shuffle 2^25 x uint32", 1, [&] ()
+    {
+        std::shuffle(values.begin(), values.end(), engine);
+    }, SIZE);
+
+    bench::measure("sampling::shuffle 2^25 x uint32", 1, [&] ()
+    {
+        shuffle(values.begin(), values.end(), engine);
+    }, SIZE);
+
+    auto maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (auto threads = 1u; threads <= maxThreads; threads *= 2u)
+    {
+        bench::measure("sampling::parallelShuffle 2^25 x uint32 threads=" + std::to_string(threads), 1, [&] ()
+        {
+            parallelShuffle(values.begin(), values.end(), 42u, threads);
+        }, SIZE);
+    }
+}
+
+BENCHMARK(FloydSample, kOutOfN)
+{
+    auto engine = std::mt19937_64(42);
+    for (auto k : {100u, 10000u, 1000000u})
+    {
+        bench::measure("floydSample k=" + std::to_string(k) + " n=2^40", 10, [&] ()
+        {
+            bench::doNotOptimize(floydSample(std::uint64_t(1) << 40, k, engine).size());
+        }, k);
+    }
+}
+
+BENCHMARK(ReservoirSampler, stream)
+{
+    constexpr auto ITEMS = std::uint64_t(1) << 24;
+    constexpr auto K = std::size_t(1000);
+
+    // Algorithm R: one synchronized engine call per item
+    bench::measure("Algorithm R via RandomNumberGenerator<std::mutex> k=1000", 1, [&] ()
+    {
+        using Rng = RandomNumberGenerator<std::mt19937_64, std::uniform_int_distribution<std::uint64_t>, std::mutex>;
+        auto rng = Rng(42);
+        auto reservoir = std::vector<std::uint64_t>();
+        reservoir.reserve(K);
+        for (auto i = std::uint64_t(0); i < ITEMS; ++i)
+        {
+            if (reservoir.size() < K)
+            {
+                reservoir.push_back(i);
+                continue;
+            }
+
+            auto slot = rng(Rng::ParamType(0, i));
+            if (slot < K)
+            {
+                reservoir[static_cast<std::size_t>(slot)] = i;
+            }
+        }
+        bench::doNotOptimize(reservoir.data());
+    }, ITEMS);
+
+    bench::measure("ReservoirSampler (Algorithm L) k=1000", 1, [&] ()
+    {
+        auto sampler = ReservoirSampler<std::uint64_t, std::mt19937_64>(K, std::mt19937_64(42));
+        for (auto i = std::uint64_t(0); i < ITEMS; ++i)
+        {
+            sampler.push(i);
+        }
+        bench::doNotOptimize(sampler.samples().data());
+    }, ITEMS);
+
+    bench::measure("WeightedReservoirSampler (A-ExpJ) k=1000", 1, [&] ()
+    {
+        auto sampler = WeightedReservoirSampler<std::uint64_t, std::mt19937_64>(K, std::mt19937_64(42));
+        for (auto i = std::uint64_t(0); i < ITEMS; ++i)
+        {
+            sampler.push(i, static_cast<double>(1u + (i & 7u)));
+        }
+        bench::doNotOptimize(sampler.samples().data());
+    }, ITEMS);
+}
@@ -0,0 +1,127 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <LockGuard.hpp>
+#include <Mutex.hpp>
+#include <SeqLock.hpp>
+#include "Bench.hpp"
+
+using simons_lib::lock::LockGuard;
+using simons_lib::lock::SharedLockGuard;
+using simons_lib::mutex::DistributedRwLock;
+using simons_lib::mutex::SpinLock;
+using simons_lib::seq_lock::SeqLock;
+
+namespace
+{
+constexpr auto READS_PER_THREAD = std::uint64_t(1000000);
+
+// Small struct published by a rare writer and read by everybody.
+struct Rates
+{
+    double bid;
+    double ask;
+};
+
+// Reference implementation: plain value guarded by a lock.
+template<typename M, template<typename> class G>
+class Guarded
+{
+public:
+    Rates load(void)
+    {
+        auto guard = G<M>(m_mutex);
+        return m_rates;
+    }
+
+    void store(Rates const& rates)
+    {
+        auto guard = LockGuard<M>(m_mutex);
+        m_rates = rates;
+    }
+
+private:
+    M     m_mutex;
+    Rates m_rates = {1.0, 2.0};
+};
+
+// All threads read, thread 0 additionally publishes a new value every 1024 reads.
+template<typename S>
+void readMostly(std::string const& name, unsigned threads)
+{
+    auto store = S();
+    auto counter = std::atomic<std::uint64_t>(0);
+    bench::measureParallel(name + " threads=" + std::to_string(threads), threads, READS_PER_THREAD, [&store, &counter] ()
+    {
+        auto rates = store.load();
+        bench::doNotOptimize(rates);
+
+        thread_local auto reads = std::uint64_t(0);
+        thread_local auto const writer = (counter.fetch_add(1) == 0u);
+        if (writer && ((++reads & 1023u) == 0u))
+        {
+            store.store(Rates{rates.bid + 1.0, rates.ask + 1.0});
+        }
+    });
+}
+} // namespace
+
+BENCHMARK(SeqLock, readMostly)
+{
+    // glibc skips atomic instructions in std::mutex as long as the process
+    // never started a thread. Mutexes matter in multithreaded processes only.
+    std::thread([] () {}).join();
+
+    auto maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    auto counts = std::vector<unsigned>();
+    for (auto threads = 1u; threads < maxThreads; threads *= 2u)
+    {
+        counts.push_back(threads);
+    }
+    counts.push_back(maxThreads);
+
+    for (auto threads : counts)
+    {
+        readMostly<Guarded<std::mutex, LockGuard>>("LockGuard<std::mutex>", threads);
+        readMostly<Guarded<std::shared_mutex, SharedLockGuard>>("SharedLockGuard<std::shared_mutex>", threads);
+        readMostly<Guarded<DistributedRwLock<>, SharedLockGuard>>("SharedLockGuard<DistributedRwLock>", threads);
+        readMostly<SeqLock<Rates, SpinLock>>("SeqLock<SpinLock>", threads);
+    }
+}
@@ -0,0 +1,137 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef STATISTICS_HPP_20190406094530
+#define STATISTICS_HPP_20190406094530
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace bench
+{
+
+/**
+ * @brief Upper tail probability of the chi-square distribution.
+ * @note Uses the Wilson-Hilferty approximation, accurate enough for smoke tests.
+ * @param[in] chiSquare          Test statistic.
+ * @param[in] degreesOfFreedom   Degrees of freedom.
+ * @returns P(X >= chiSquare).
+ */
+inline double chiSquarePValue(double chiSquare, double degreesOfFreedom)
+{
+    auto k = degreesOfFreedom;
+    auto z = (std::cbrt(chiSquare / k) - (1.0 - 2.0 / (9.0 * k))) / std::sqrt(2.0 / (9.0 * k));
+    return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+/**
+ * @brief Chi-square statistic of observed counts against equally likely buckets.
+ * @param[in] counts   Observed counts per bucket.
+ * @returns Test statistic with counts.size() - 1 degrees of freedom.
+ */
+inline double chiSquareUniform(std::vector<std::uint64_t> const& counts)
+{
+    auto total = 0.0;
+    for (auto count : counts)
+    {
+        total += static_cast<double>(count);
+    }
+
+    auto expected = total / static_cast<double>(counts.size());
+    auto result = 0.0;
+    for (auto count : counts)
+    {
+        auto diff = static_cast<double>(count) - expected;
+        result += diff * diff / expected;
+    }
+    return result;
+}
+
+/**
+ * @brief Standard normal cumulative distribution function.
+ * @param[in] x   Argument.
+ * @returns P(X <= x).
+ */
+inline double normalCdf(double x)
+{
+    return 0.5 * std::erfc(-x / std::sqrt(2.0));
+}
+
+/**
+ * @brief Marsaglia's birthday spacings test.
+ * @note Draws m = 512 birthdays out of 2^24 days per round (Diehard parameters).
+ *       The number of duplicated spacings is Poisson distributed with
+ *       lambda = m^3 / (4 * 2^24) = 2.
+ *       The sum over all rounds is compared to its expectation. The Poisson
+ *       approximation overestimates the mean by about 0.7%, which is negligible
+ *       for a smoke test.
+ * @param[in] next     Callable returning uniformly distributed 32 bit words.
+ * @param[in] rounds   Number of rounds.
+ * @returns z-score of the summed duplicate count.
+ */
+template<typename F>
+double birthdaySpacingsZScore(F&& next, unsigned rounds)
+{
+    constexpr auto BIRTHDAYS = 512u;
+    constexpr auto LAMBDA = 2.0;
+
+    auto birthdays = std::vector<std::uint32_t>(BIRTHDAYS);
+    auto duplicates = 0.0;
+    for (auto round = 0u; round < rounds; ++round)
+    {
+        for (auto& birthday : birthdays)
+        {
+            birthday = static_cast<std::uint32_t>(next()) >> 8;
+        }
+        std::sort(birthdays.begin(), birthdays.end());
+
+        for (auto i = BIRTHDAYS - 1u; i > 0u; --i)
+        {
+            birthdays[i] -= birthdays[i - 1];
+        }
+        std::sort(birthdays.begin(), birthdays.end());
+
+        for (auto i = 1u; i < BIRTHDAYS; ++i)
+        {
+            duplicates += (birthdays[i] == birthdays[i - 1]) ? 1.0 : 0.0;
+        }
+    }
+
+    auto expected = LAMBDA * rounds;
+    return (duplicates - expected) / std::sqrt(expected);
+}
+
+} // namespace bench
+
+#endif // STATISTICS_HPP_20190406094530
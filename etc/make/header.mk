@@ -5,10 +5,13 @@
 INC_DIR         := include
 SRC_DIR         := src
 GTEST_DIR       := gtest
+BENCH_DIR       := bench
 OUT_DIR         := bin
 OBJ_DEBUG_DIR   := $(OUT_DIR)/obj_debug
 OBJ_RELEASE_DIR := $(OUT_DIR)/obj_release
 OBJ_GTEST_DIR   := $(OUT_DIR)/obj_gtest
+OBJ_BENCH_DIR   := $(OUT_DIR)/obj_bench
+OBJ_SIZE_DIR    := $(OUT_DIR)/obj_size
 DOC_DIR         := doc
 DOC_HTML_DIR    := $(DOC_DIR)/html
 ETC_DIR         := etc
@@ -61,6 +64,7 @@ BIN_RELEASE_MINOR_VERSION := $(BIN_RELEASE_MAJOR_VERSION).$(VERSION_MINOR)
 BIN_RELEASE_FULL_VERSION  := $(BIN_RELEASE_MINOR_VERSION).$(VERSION_REVISION)
 
 BIN_GTEST := $(OUT_DIR)/$(PROJECT_NAME)_gtest.elf
+BIN_BENCH := $(OUT_DIR)/$(PROJECT_NAME)_bench.elf
 
 # Select Binary name based on Project Type
 ifeq ($(PROJECT_TYPE), binary)
@@ -105,3 +109,4 @@ CMD_RM    := rm -rf
 CMD_CP    := cp
 CMD_LN    := ln -sf
 CMD_CHMOD := chmod 755 -R
+CMD_NM    := nm
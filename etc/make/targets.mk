@@ -12,6 +12,8 @@ include $(ETC_MAKE_DIR)/sanity_checks.mk
         clean_debug \
         clean_release \
         clean_gtest \
+        clean_bench \
+        clean_size \
         clean_doc \
         clean_all \
         install_include \
@@ -27,11 +29,15 @@ include $(ETC_MAKE_DIR)/sanity_checks.mk
          clean_debug \
          clean_release \
          clean_gtest \
+         clean_bench \
+         clean_size \
          clean_doc \
          clean_all \
          exec_debug_bin \
          exec_release_bin \
          exec_gtest_bin \
+         exec_bench_bin \
+         exec_size_report \
          install_include \
          install_debug \
          install_release \
@@ -63,14 +69,21 @@ $(OBJ_GTEST_DIR)/%.o: $(GTEST_DIR)/%.cpp
 	$(info $(info )Compiling: "$<"")
 	$(CC) -c $(STD) $(CPPFLAGS) $(CPPFLAGS_GTEST) $(INCLUDES) $(DEFINES) $(WARNINGS) $< -o $@
 
+# 2.4) Benchmark build pattern rule
+$(OBJ_BENCH_DIR)/%.o: $(BENCH_DIR)/%.cpp
+	$(info $(info )Compiling: "$<"")
+	$(CC) -c $(STD) $(CPPFLAGS) $(CPPFLAGS_BENCH) $(INCLUDES) $(DEFINES) $(WARNINGS) $< -o $@
+
 # 2) Generate Object file names via substitution.
 OBJ       := $(SRC:%.cpp=%.o)
 GTEST_OBJ := $(GTEST_SRC:%.cpp=%.o)
+BENCH_OBJ := $(BENCH_SRC:%.cpp=%.o)
 
 # 3) Generate Paths to the plain object, source files and dist locations.
 OBJ_DEBUG   := $(OBJ:%=$(OBJ_DEBUG_DIR)/%)
 OBJ_RELEASE := $(OBJ:%=$(OBJ_RELEASE_DIR)/%)
 OBJ_GTEST   := $(GTEST_OBJ:%=$(OBJ_GTEST_DIR)/%)
+OBJ_BENCH   := $(BENCH_OBJ:%=$(OBJ_BENCH_DIR)/%)
 
 INSTALL_INC_DIR := $(INSTALL_INC_DIR)/$(PROJECT_NAME)
 
@@ -109,12 +122,19 @@ $(BIN_GTEST): $(OBJ_GTEST)
 	$(info $(info )Linking: "$@")
 	$(CC) $(LDFLAGS) $(LDFLAGS_GTEST) $(OBJ_GTEST) -o $(BIN_GTEST) $(LIBS_GTEST)
 
+$(BIN_BENCH): $(OBJ_BENCH)
+	$(info $(info )Linking: "$@")
+	$(CC) $(LDFLAGS) $(LDFLAGS_BENCH) $(OBJ_BENCH) -o $(BIN_BENCH) $(LIBS_BENCH)
+
 # 5) Basic build targets
 create_project_structure:
 	$(CMD_MKDIR) $(INC_DIR)
 	$(CMD_MKDIR) $(GTEST_DIR)
 	$(CMD_MKDIR) $(OUT_DIR)
+	$(CMD_MKDIR) $(BENCH_DIR)
 	$(CMD_MKDIR) $(OBJ_GTEST_DIR)
+	$(CMD_MKDIR) $(OBJ_BENCH_DIR)
+	$(CMD_MKDIR) $(OBJ_SIZE_DIR)
 	$(CMD_MKDIR) $(DOC_DIR)
 	$(CMD_MKDIR) $(DOC_HTML_DIR)
 	$(CMD_MKDIR) $(ETC_DIR)
@@ -144,6 +164,8 @@ build_gtest: prebuild $(BIN) $(BIN_GTEST) postbuild
 
 build_debug_gtest: prebuild $(BIN_DEBUG) $(BIN_GTEST) postbuild
 
+build_bench: prebuild $(BIN) $(BIN_BENCH) postbuild
+
 build_doc: prebuild_doc
 	$(DOCTOOL) $(DOC_CFG)
 
@@ -156,6 +178,12 @@ clean_release:
 clean_gtest:
 	$(CMD_RM) $(OBJ_GTEST_DIR) $(BIN_GTEST)
 
+clean_bench:
+	$(CMD_RM) $(OBJ_BENCH_DIR) $(BIN_BENCH)
+
+clean_size:
+	$(CMD_RM) $(OBJ_SIZE_DIR)
+
 clean_doc:
 	$(CMD_RM) $(DOC_HTML_DIR)
 
@@ -171,6 +199,22 @@ exec_gtest_bin: build_gtest
 	$(info Executing: $(BIN_GTEST) $(TEST_ARGS))
 	$(BIN_GTEST) $(TEST_ARGS)
 
+exec_bench_bin: build_bench
+	$(info Executing: $(BIN_BENCH) $(BENCH_ARGS))
+	$(BIN_BENCH) $(BENCH_ARGS)
+
+# Compile SIZE_SRC once per SIZE_VARIANTS entry and sum the sizes of all
+# code symbols reported by nm.
+exec_size_report: prebuild
+	echo "Code size of $(SIZE_SRC) ($(CPPFLAGS_SIZE)):"
+	for variant in $(SIZE_VARIANTS); do \
+	    obj=$(OBJ_SIZE_DIR)/$$(echo $$variant | tr -c '[:alnum:]\n' '_').o; \
+	    $(CC) -c $(STD) $(CPPFLAGS) $(CPPFLAGS_SIZE) $(INCLUDES) $(DEFINES) $(WARNINGS) \
+	        -D$(SIZE_DEFINE)=$$variant $(BENCH_DIR)/$(SIZE_SRC) -o $$obj || exit 1; \
+	    $(CMD_NM) -S -t d $$obj | awk -v name=$$variant \
+	        '$$3 ~ /^[TtWw]$$/ { size += $$2 } END { printf "%-18s %5d bytes\n", name, size }'; \
+	done
+
 exec_debugger_debug: build_debug
 	$(info Executing in Debugger: $(BIN_DEBUG) $(RUN_ARGS))
 	$(DEBUGGER) --args $(RUN_ARGS) $(BIN_DEBUG)
@@ -319,6 +363,8 @@ build:      build_gtest
 clean:      clean_gtest
 test:       exec_gtest_bin
 test_debug: exec_debugger_gtest
+bench:      exec_bench_bin
+size:       exec_size_report
 install:    install_include
 uninstall:  uninstall_include
 all:        clean_gtest build_gtest
@@ -343,6 +389,8 @@ help:
 	$(info | exec_debug      |  X  |  X  |     |     |     |     |     |      | Execute build result in debugger     |)
 	$(info | test            |     |     |  X  |  X  |  X  |  X  |  X  |  X   | Build and run unittests              |)
 	$(info | test_debug      |     |     |  X  |  X  |  X  |  X  |  X  |  X   | Build and run unittests in debugger  |)
+	$(info | bench           |     |     |     |     |     |     |  X  |  X   | Build and run benchmarks             |)
+	$(info | size            |     |     |     |     |     |     |  X  |  X   | Report code size of SIZE_SRC via nm  |)
 	$(info | install         |  X  |  X  |  X  |  X  |  X  |  X  |  X  |  X   | Install build result in host system  |)
 	$(info | uninstall       |  X  |  X  |  X  |  X  |  X  |  X  |  X  |  X   | Remove build result from host system |)
 	$(info | doc             |  X  |  X  |  X  |  X  |  X  |  X  |  X  |  X   | Create documentation in doc          |)
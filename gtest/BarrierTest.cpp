@@ -0,0 +1,179 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <Barrier.hpp>
+
+using simons_lib::barrier::SpinBarrier;
+using simons_lib::barrier::SpinLatch;
+
+namespace
+{
+template<typename F>
+void runThreads(unsigned count, F&& function)
+{
+    auto threads = std::vector<std::thread>();
+    for (auto i = 0u; i < count; ++i)
+    {
+        threads.emplace_back(function, i);
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+// All threads of a phase must observe all writes of the previous phase.
+void runPhases(std::chrono::nanoseconds spin)
+{
+    constexpr auto THREADS = 4u;
+    constexpr auto PHASES = 200u;
+
+    auto barrier = SpinBarrier(THREADS, spin);
+    auto values = std::vector<std::uint32_t>(THREADS, 0u);
+    auto lasts = std::atomic<std::uint32_t>(0);
+    auto errors = std::atomic<std::uint32_t>(0);
+
+    runThreads(THREADS, [&] (unsigned id)
+    {
+        for (auto phase = 1u; phase <= PHASES; ++phase)
+        {
+            values[id] = phase;
+            if (barrier.arrive_and_wait())
+            {
+                lasts.fetch_add(1);
+            }
+            for (auto value : values)
+            {
+                if (value != phase)
+                {
+                    errors.fetch_add(1);
+                }
+            }
+            barrier.arrive_and_wait();
+        }
+    });
+
+    ASSERT_EQ(0u, errors.load());
+    ASSERT_EQ(PHASES, lasts.load());
+    ASSERT_EQ(2u * PHASES, barrier.phase());
+}
+} // namespace
+
+TEST(SpinBarrierTest, singleThread)
+{
+    auto barrier = SpinBarrier(1);
+    ASSERT_EQ(1u, barrier.count());
+    ASSERT_TRUE(barrier.arrive_and_wait());
+    ASSERT_TRUE(barrier.arrive_and_wait());
+    ASSERT_EQ(2u, barrier.phase());
+}
+
+TEST(SpinBarrierTest, phasesWithSpinning)
+{
+    runPhases(SpinBarrier::DEFAULT_SPIN);
+}
+
+TEST(SpinBarrierTest, phasesWithoutSpinning)
+{
+    // Waiting threads sleep immediately
+    runPhases(std::chrono::nanoseconds(0));
+}
+
+TEST(SpinLatchTest, countDown)
+{
+    auto latch = SpinLatch(3);
+    ASSERT_FALSE(latch.try_wait());
+    latch.count_down(2);
+    ASSERT_FALSE(latch.try_wait());
+    latch.arrive_and_wait();
+    ASSERT_TRUE(latch.try_wait());
+    latch.wait();
+}
+
+TEST(SpinLatchTest, releasesSleepingWaiters)
+{
+    constexpr auto THREADS = 4u;
+    auto latch = SpinLatch(1, std::chrono::nanoseconds(0));
+    auto released = std::atomic<unsigned>(0);
+
+    auto waiters = std::thread([&] ()
+    {
+        runThreads(THREADS, [&] (unsigned)
+        {
+            latch.wait();
+            released.fetch_add(1);
+        });
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ASSERT_EQ(0u, released.load());
+    latch.count_down();
+    waiters.join();
+    ASSERT_EQ(THREADS, released.load());
+}
+
+TEST(SpinLatchTest, startTogether)
+{
+    constexpr auto THREADS = 4u;
+    auto latch = SpinLatch(THREADS);
+    auto started = std::atomic<unsigned>(0);
+
+    runThreads(THREADS, [&] (unsigned)
+    {
+        started.fetch_add(1);
+        latch.arrive_and_wait();
+        ASSERT_EQ(THREADS, started.load());
+    });
+}
+
+TEST(SpinLatchTest, waiterMayDestroyLatch)
+{
+    // The waiter frees the latch right after wait() returns, count_down must not touch it afterwards.
+    for (auto round = 0; round < 200; ++round)
+    {
+        auto latch = std::make_unique<SpinLatch>(1, std::chrono::nanoseconds(round % 2));
+        auto raw = latch.get();
+        auto waiter = std::thread([owned = std::move(latch)] () mutable
+        {
+            owned->wait();
+            owned.reset();
+        });
+        raw->count_down();
+        waiter.join();
+    }
+}
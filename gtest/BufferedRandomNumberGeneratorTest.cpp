@@ -0,0 +1,150 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <array>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <BufferedRandomNumberGenerator.hpp>
+#include <Distributions.hpp>
+
+using simons_lib::random_number_generator::BufferedRandomNumberGenerator;
+using simons_lib::distributions::BoundedIntDistribution;
+
+namespace
+{
+template<typename Rng>
+void waitUntilFilled(Rng const& rng, std::uint64_t count)
+{
+    while (rng.metrics().produced < count)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+}
+
+TEST(BufferedRandomNumberGeneratorTest, servesFromBuffer)
+{
+    using Rng = BufferedRandomNumberGenerator<std::mt19937, BoundedIntDistribution<int>, std::mutex, 256>;
+    auto rng = Rng(0, BoundedIntDistribution<int>(-10, 10));
+
+    waitUntilFilled(rng, 256);
+    for (auto i = 0; i < 256; ++i)
+    {
+        auto val = rng();
+        ASSERT_TRUE(-10 <= val && val <= 10);
+    }
+
+    auto metrics = rng.metrics();
+    ASSERT_EQ(256u, metrics.buffered);
+    ASSERT_EQ(0u, metrics.underruns);
+    ASSERT_EQ(0u, metrics.contended);
+}
+
+TEST(BufferedRandomNumberGeneratorTest, sequenceMatchesUnbufferedGenerator)
+{
+    // With a single consumer and no underruns, values are handed out in generation order.
+    using Rng = BufferedRandomNumberGenerator<std::mt19937, std::uniform_int_distribution<int>, std::mutex, 64>;
+    auto rng = Rng(42);
+    auto reference = std::mt19937(42);
+    auto dist = std::uniform_int_distribution<int>();
+
+    waitUntilFilled(rng, 64);
+    for (auto i = 0; i < 64; ++i)
+    {
+        ASSERT_EQ(dist(reference), rng());
+    }
+}
+
+TEST(BufferedRandomNumberGeneratorTest, drainingWakesProducer)
+{
+    // The period is far longer than the test, refilling relies on the wake up.
+    using Rng = BufferedRandomNumberGenerator<std::mt19937, BoundedIntDistribution<int>, std::mutex, 16>;
+    auto rng = Rng(0, BoundedIntDistribution<int>(0, 5), std::chrono::hours(1));
+
+    for (auto round = 1u; round <= 4u; ++round)
+    {
+        waitUntilFilled(rng, round * 16u);
+        for (auto i = 0; i < 16; ++i)
+        {
+            rng();
+        }
+    }
+    ASSERT_EQ(0u, rng.metrics().underruns);
+}
+
+TEST(BufferedRandomNumberGeneratorTest, underrunFallsBack)
+{
+    using Rng = BufferedRandomNumberGenerator<std::mt19937, BoundedIntDistribution<int>, std::mutex, 16>;
+    auto rng = Rng(0, BoundedIntDistribution<int>(0, 5), std::chrono::microseconds(100000));
+
+    // Drain far more values than buffered, the rest must be generated synchronously.
+    for (auto i = 0; i < 10000; ++i)
+    {
+        auto val = rng();
+        ASSERT_TRUE(0 <= val && val <= 5);
+    }
+
+    auto metrics = rng.metrics();
+    ASSERT_EQ(10000u, metrics.buffered + metrics.underruns + metrics.contended);
+}
+
+TEST(BufferedRandomNumberGeneratorTest, synchronized)
+{
+    using Rng = BufferedRandomNumberGenerator<std::mt19937, BoundedIntDistribution<int>, std::mutex, 128>;
+    auto rng = Rng(std::random_device()(), BoundedIntDistribution<int>(0, 100));
+
+    auto threadfunc = [&rng] ()
+    {
+        for (auto i = 0; i < 10000; ++i)
+        {
+            auto val = rng();
+            ASSERT_TRUE(0 <= val && val <= 100);
+        }
+    };
+
+    auto threads = std::array<std::thread, 4>();
+
+    for (auto& handle : threads)
+    {
+        handle = std::thread(threadfunc);
+    }
+
+    for (auto& handle : threads)
+    {
+        handle.join();
+    }
+
+    auto metrics = rng.metrics();
+    ASSERT_EQ(40000u, metrics.buffered + metrics.underruns + metrics.contended);
+}
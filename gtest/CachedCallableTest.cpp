@@ -32,11 +32,23 @@
 
 #include <gtest/gtest.h>
 #include <array>
+#include <atomic>
 #include <thread>
 #include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <type_traits>
 #include <CachedCallable.hpp>
+#include <CachedCallable/AtomicImpl.hpp>
+#include <CachedCallable/SeqLockCachedCallableImpl.hpp>
+#include <Reclamation.hpp>
+#include <SyncPolicy.hpp>
 
 using simons_lib::cached_callable::CachedCallable;
+using simons_lib::cached_callable::SeqLockCachedCallable;
+using simons_lib::reclamation::EpochDomain;
+using simons_lib::sync_policy::Atomic;
+using simons_lib::sync_policy::MutexPolicy;
 
 namespace
 {
@@ -44,6 +56,22 @@ int testFunc(void)
 {
     return 42;
 }
+
+// SharedLockable mutex counting how often each locking mode was used.
+struct CountingSharedMutex
+{
+    static inline int exclusive = 0;
+    static inline int shared = 0;
+
+    void lock(void) { m_mutex.lock(); ++exclusive; }
+    bool try_lock(void) { return m_mutex.try_lock(); }
+    void unlock(void) { m_mutex.unlock(); }
+    void lock_shared(void) { m_mutex.lock_shared(); ++shared; }
+    bool try_lock_shared(void) { return m_mutex.try_lock_shared(); }
+    void unlock_shared(void) { m_mutex.unlock_shared(); }
+
+    std::shared_mutex m_mutex;
+};
 }
 
 TEST(CachedCallableTest, UseLambda)
@@ -130,3 +158,191 @@ TEST(CachedCallableTest, synchronized)
 
     ASSERT_EQ(expected, testObj());
 }
+
+TEST(CachedCallableTest, sharedReadsOnHit)
+{
+    CountingSharedMutex::exclusive = 0;
+    CountingSharedMutex::shared = 0;
+    auto testObj = CachedCallable<int, CountingSharedMutex>([] () { return 42; });
+
+    // Miss: shared lookup fails, result is computed under the exclusive lock
+    ASSERT_EQ(42, testObj());
+    ASSERT_EQ(1, CountingSharedMutex::exclusive);
+    ASSERT_EQ(1, CountingSharedMutex::shared);
+
+    // Hits: served under the shared lock only
+    ASSERT_EQ(42, testObj());
+    ASSERT_EQ(42, testObj());
+    ASSERT_EQ(1, CountingSharedMutex::exclusive);
+    ASSERT_EQ(3, CountingSharedMutex::shared);
+}
+
+TEST(CachedCallableTest, synchronizedSharedMutex)
+{
+    auto execCnt = std::atomic<int>(0);
+    auto testObj = CachedCallable<int, std::shared_mutex>([&execCnt] () { return ++execCnt; });
+
+    auto threads = std::array<std::thread, 8>();
+    for (auto& handle : threads)
+    {
+        handle = std::thread([&testObj] ()
+        {
+            for (auto i = 0; i < 1000; ++i)
+            {
+                ASSERT_EQ(1, testObj());
+            }
+        });
+    }
+
+    for (auto& handle : threads)
+    {
+        handle.join();
+    }
+    ASSERT_EQ(1, execCnt.load());
+}
+
+TEST(CachedCallableTest, seqLockBacked)
+{
+    auto execCnt = 0;
+    auto testObj = SeqLockCachedCallable<int>([&execCnt] () { return ++execCnt; });
+
+    // Execute multiple times. There should be no reevaluation
+    ASSERT_EQ(1, testObj());
+    ASSERT_EQ(1, testObj());
+
+    // Clear cache, next evaluation has to deliver a different result
+    testObj.reset();
+    ASSERT_EQ(2, testObj());
+    ASSERT_EQ(2, execCnt);
+}
+
+TEST(CachedCallableTest, seqLockBackedSynchronized)
+{
+    auto execCnt = std::atomic<int>(0);
+    auto testObj = SeqLockCachedCallable<int, std::mutex>([&execCnt] () { return ++execCnt; });
+
+    auto threads = std::array<std::thread, 8>();
+    for (auto& handle : threads)
+    {
+        handle = std::thread([&testObj] ()
+        {
+            for (auto i = 0; i < 1000; ++i)
+            {
+                ASSERT_EQ(1, testObj());
+            }
+        });
+    }
+
+    for (auto& handle : threads)
+    {
+        handle.join();
+    }
+    ASSERT_EQ(1, execCnt.load());
+}
+
+TEST(CachedCallableTest, mutexPolicy)
+{
+    static_assert(std::is_same_v<std::mutex, CachedCallable<int, MutexPolicy<std::mutex>>::MutexType>);
+    static_assert(std::is_same_v<std::mutex, CachedCallable<int, std::mutex>::MutexType>);
+
+    auto testObj = CachedCallable<int, MutexPolicy<std::mutex>>(testFunc);
+    ASSERT_EQ(42, testObj());
+}
+
+TEST(CachedCallableTest, atomicPublication)
+{
+    auto execCnt = 0;
+    auto testObj = CachedCallable<int, Atomic>([&execCnt] () { return ++execCnt; });
+
+    // Execute multiple times. There should be no reevaluation
+    ASSERT_EQ(1, testObj());
+    ASSERT_EQ(1, testObj());
+
+    // Clear cache, next evaluation has to deliver a different result
+    testObj.reset();
+    testObj.reset();
+    ASSERT_EQ(2, testObj());
+    ASSERT_EQ(2, execCnt);
+}
+
+TEST(CachedCallableTest, atomicPublicationSynchronized)
+{
+    auto execCnt = std::atomic<int>(0);
+    auto testObj = CachedCallable<int, Atomic>([&execCnt] () { return ++execCnt; });
+
+    // Concurrent misses may evaluate more than once, but all readers agree on one result.
+    auto results = std::array<int, 8>();
+    auto threads = std::array<std::thread, 8>();
+    for (auto i = std::size_t(0); i < threads.size(); ++i)
+    {
+        threads[i] = std::thread([&testObj, &results, i] ()
+        {
+            results[i] = testObj();
+            for (auto n = 0; n < 1000; ++n)
+            {
+                ASSERT_EQ(results[i], testObj());
+            }
+        });
+    }
+
+    for (auto& handle : threads)
+    {
+        handle.join();
+    }
+    for (auto result : results)
+    {
+        ASSERT_EQ(results[0], result);
+    }
+    ASSERT_LE(results[0], execCnt.load());
+}
+
+TEST(CachedCallableTest, atomicPublicationConcurrentReset)
+{
+    auto testObj = CachedCallable<std::string, Atomic>([] () { return std::string(64, 'x'); });
+
+    // Readers keep copying results while writers discard them.
+    auto threads = std::array<std::thread, 4>();
+    for (auto i = std::size_t(0); i < threads.size(); ++i)
+    {
+        threads[i] = std::thread([&testObj, i] ()
+        {
+            for (auto n = 0; n < 1000; ++n)
+            {
+                if ((i == 0u) && (n % 4 == 0))
+                {
+                    testObj.reset();
+                }
+                ASSERT_EQ(64u, testObj().size());
+            }
+        });
+    }
+
+    for (auto& handle : threads)
+    {
+        handle.join();
+    }
+}
+
+TEST(CachedCallableTest, atomicPublicationCallableRunsUnpinned)
+{
+    // While the callable runs, other threads must be able to advance the
+    // epoch of the global domain twice, which a pinned reader would block.
+    auto advanced = false;
+    auto testObj = CachedCallable<int, Atomic>([&advanced] ()
+    {
+        std::thread([&advanced] ()
+        {
+            auto& domain = EpochDomain::global();
+            auto start = domain.epoch();
+            for (auto i = 0; i < 3; ++i)
+            {
+                domain.reclaim();
+            }
+            advanced = (domain.epoch() >= start + 2u);
+        }).join();
+        return 42;
+    });
+
+    ASSERT_EQ(42, testObj());
+    ASSERT_TRUE(advanced);
+}
@@ -0,0 +1,192 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include <Counters.hpp>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+using simons_lib::counters::ShardedCounter;
+using simons_lib::counters::ShardedGauge;
+using simons_lib::counters::ShardedHistogram;
+
+namespace
+{
+template<typename F>
+void runThreads(int count, F&& function)
+{
+    auto threads = std::vector<std::thread>();
+    for (auto i = 0; i < count; ++i)
+    {
+        threads.emplace_back(function);
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+} // namespace
+
+TEST(ShardedCounterTest, slotsArePowerOfTwo)
+{
+    ASSERT_EQ(1u, ShardedCounter(0).slots());
+    ASSERT_EQ(1u, ShardedCounter(1).slots());
+    ASSERT_EQ(4u, ShardedCounter(3).slots());
+    ASSERT_EQ(8u, ShardedCounter(8).slots());
+
+    auto slots = ShardedCounter().slots();
+    ASSERT_EQ(0u, slots & (slots - 1u));
+    ASSERT_LE(std::size_t(std::thread::hardware_concurrency()), slots);
+}
+
+TEST(ShardedCounterTest, addAndReset)
+{
+    auto counter = ShardedCounter(4);
+    ASSERT_EQ(0u, counter.value());
+    counter.add();
+    counter.add(41);
+    ASSERT_EQ(42u, counter.value());
+    counter.reset();
+    ASSERT_EQ(0u, counter.value());
+}
+
+TEST(ShardedCounterTest, concurrentAdds)
+{
+    constexpr auto THREADS = 4;
+    constexpr auto INCREMENTS = 10000;
+
+    auto counter = ShardedCounter(2);
+    runThreads(THREADS, [&counter] ()
+    {
+        for (auto n = 0; n < INCREMENTS; ++n)
+        {
+            counter.add();
+        }
+    });
+    ASSERT_EQ(std::uint64_t(THREADS * INCREMENTS), counter.value());
+}
+
+TEST(ShardedCounterTest, slotFollowsCpu)
+{
+    using simons_lib::counters::detail::slotIndex;
+    constexpr auto MASK = std::size_t(7);
+
+#if defined(__linux__)
+    // Retry in case the thread migrated while the slot was looked up.
+    for (auto attempt = 0; attempt < 100; ++attempt)
+    {
+        auto before = sched_getcpu();
+        auto slot = slotIndex(MASK);
+        if ((before >= 0) && (before == sched_getcpu()))
+        {
+            ASSERT_EQ(static_cast<std::size_t>(before) & MASK, slot);
+            return;
+        }
+    }
+#endif
+    ASSERT_LE(slotIndex(MASK), MASK);
+}
+
+TEST(ShardedGaugeTest, upAndDown)
+{
+    auto gauge = ShardedGauge();
+    gauge.sub(3);
+    ASSERT_EQ(-3, gauge.value());
+
+    runThreads(4, [&gauge] ()
+    {
+        for (auto n = 0; n < 10000; ++n)
+        {
+            gauge.add();
+            gauge.sub();
+        }
+        gauge.add(2);
+    });
+    ASSERT_EQ(5, gauge.value());
+}
+
+TEST(ShardedHistogramTest, buckets)
+{
+    ASSERT_EQ(0u, ShardedHistogram::bucketOf(0u));
+    ASSERT_EQ(1u, ShardedHistogram::bucketOf(1u));
+    ASSERT_EQ(2u, ShardedHistogram::bucketOf(2u));
+    ASSERT_EQ(2u, ShardedHistogram::bucketOf(3u));
+    ASSERT_EQ(11u, ShardedHistogram::bucketOf(1024u));
+    ASSERT_EQ(64u, ShardedHistogram::bucketOf(~std::uint64_t(0)));
+
+    ASSERT_EQ(0u, ShardedHistogram::upperBound(0u));
+    ASSERT_EQ(3u, ShardedHistogram::upperBound(2u));
+    ASSERT_EQ(~std::uint64_t(0), ShardedHistogram::upperBound(64u));
+}
+
+TEST(ShardedHistogramTest, snapshot)
+{
+    auto histogram = ShardedHistogram(2);
+    ASSERT_EQ(0u, histogram.snapshot().count());
+    ASSERT_EQ(0u, histogram.snapshot().percentile(0.5));
+    ASSERT_EQ(0.0, histogram.snapshot().mean());
+
+    for (auto value = std::uint64_t(1); value <= 100u; ++value)
+    {
+        histogram.record(value);
+    }
+    auto snapshot = histogram.snapshot();
+    ASSERT_EQ(100u, snapshot.count());
+    ASSERT_EQ(5050u, snapshot.sum);
+    ASSERT_DOUBLE_EQ(50.5, snapshot.mean());
+    ASSERT_EQ(1u, snapshot.percentile(0.0));
+    ASSERT_EQ(63u, snapshot.percentile(0.5));
+    ASSERT_EQ(127u, snapshot.percentile(1.0));
+
+    histogram.reset();
+    ASSERT_EQ(0u, histogram.snapshot().count());
+}
+
+TEST(ShardedHistogramTest, concurrentRecords)
+{
+    auto histogram = ShardedHistogram();
+    runThreads(4, [&histogram] ()
+    {
+        for (auto n = 0u; n < 10000u; ++n)
+        {
+            histogram.record(n % 8u);
+        }
+    });
+    auto snapshot = histogram.snapshot();
+    ASSERT_EQ(40000u, snapshot.count());
+    ASSERT_EQ(5000u, snapshot.buckets[0]);
+    ASSERT_EQ(20000u, snapshot.buckets[3]);
+}
@@ -0,0 +1,601 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+#include <Distributions.hpp>
+#include <RandomNumberGenerator.hpp>
+
+using simons_lib::distributions::BoundedIntDistribution;
+using simons_lib::distributions::ZigguratNormalDistribution;
+using simons_lib::distributions::ZigguratExponentialDistribution;
+using simons_lib::distributions::AliasDistribution;
+using simons_lib::distributions::UniformRealDistribution;
+
+namespace
+{
+// Engine always returning its largest value.
+struct LargestWordEngine
+{
+    using result_type = std::uint64_t;
+
+    static constexpr result_type min(void)
+    {
+        return 0;
+    }
+
+    static constexpr result_type max(void)
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    result_type operator () (void)
+    {
+        return max();
+    }
+};
+
+template<typename Container>
+void computeMoments(Container const& values, double& mean, double& variance)
+{
+    mean = 0.0;
+    for (auto val : values)
+    {
+        mean += val;
+    }
+    mean /= static_cast<double>(values.size());
+
+    variance = 0.0;
+    for (auto val : values)
+    {
+        variance += (val - mean) * (val - mean);
+    }
+    variance /= static_cast<double>(values.size());
+}
+
+template<typename D, typename E>
+double chiSquare(D& dist, E& engine, std::vector<double> const& weights, int samples)
+{
+    auto counts = std::vector<int>(weights.size());
+    for (auto i = 0; i < samples; ++i)
+    {
+        ++counts.at(static_cast<std::size_t>(dist(engine)));
+    }
+
+    auto sum = 0.0;
+    for (auto weight : weights)
+    {
+        sum += weight;
+    }
+
+    auto result = 0.0;
+    for (auto i = std::size_t(0); i < weights.size(); ++i)
+    {
+        auto expected = samples * weights[i] / sum;
+        if (expected == 0.0)
+        {
+            EXPECT_EQ(0, counts[i]);
+            continue;
+        }
+        result += (counts[i] - expected) * (counts[i] - expected) / expected;
+    }
+    return result;
+}
+}
+using simons_lib::random_number_generator::RandomNumberGenerator;
+
+TEST(BoundedIntDistributionTest, staysInBoundaries)
+{
+    auto engine = std::mt19937(0);
+    auto dist = BoundedIntDistribution<int>(-10, 10);
+
+    for (auto i = 0; i < 100000; ++i)
+    {
+        auto val = dist(engine);
+        ASSERT_TRUE(-10 <= val && val <= 10);
+    }
+}
+
+TEST(BoundedIntDistributionTest, singleValueRange)
+{
+    auto engine = std::mt19937_64(0);
+    auto dist = BoundedIntDistribution<std::int64_t>(42, 42);
+
+    for (auto i = 0; i < 1000; ++i)
+    {
+        ASSERT_EQ(42, dist(engine));
+    }
+}
+
+TEST(BoundedIntDistributionTest, fullRange)
+{
+    auto engine = std::mt19937_64(0);
+    auto dist = BoundedIntDistribution<std::uint64_t>();
+    auto seenHighBit = false;
+
+    for (auto i = 0; i < 1000; ++i)
+    {
+        seenHighBit |= (dist(engine) >> 63) != 0u;
+    }
+    ASSERT_TRUE(seenHighBit);
+}
+
+TEST(BoundedIntDistributionTest, nonPowerOfTwoEngine)
+{
+    // minstd_rand covers [1, 2^31 - 2] and has to be adapted internally.
+    auto engine = std::minstd_rand(0);
+    auto dist = BoundedIntDistribution<unsigned>(0u, 3u);
+    auto counts = std::array<int, 4>();
+
+    for (auto i = 0; i < 40000; ++i)
+    {
+        ++counts.at(dist(engine));
+    }
+    for (auto count : counts)
+    {
+        ASSERT_NEAR(10000, count, 500);
+    }
+}
+
+TEST(BoundedIntDistributionTest, isUniform)
+{
+    auto engine = std::mt19937(42);
+    auto dist = BoundedIntDistribution<int>(1, 6);
+    auto counts = std::array<int, 6>();
+    auto samples = 600000;
+
+    for (auto i = 0; i < samples; ++i)
+    {
+        ++counts.at(static_cast<std::size_t>(dist(engine) - 1));
+    }
+
+    // Chi-square test with 5 degrees of freedom, p = 0.001
+    auto expected = samples / 6.0;
+    auto chiSquare = 0.0;
+    for (auto count : counts)
+    {
+        chiSquare += (count - expected) * (count - expected) / expected;
+    }
+    ASSERT_LT(chiSquare, 20.52);
+}
+
+TEST(BoundedIntDistributionTest, generate)
+{
+    auto engine = std::mt19937_64(7);
+    auto dist = BoundedIntDistribution<short>(-3, 3);
+    auto values = std::vector<short>(100003);
+    auto counts = std::array<int, 7>();
+
+    dist.generate(values.begin(), values.end(), engine);
+
+    for (auto val : values)
+    {
+        ASSERT_TRUE(-3 <= val && val <= 3);
+        ++counts.at(static_cast<std::size_t>(val + 3));
+    }
+    for (auto count : counts)
+    {
+        ASSERT_NEAR(100003 / 7, count, 800);
+    }
+}
+
+TEST(BoundedIntDistributionTest, generateLargeRange)
+{
+    auto engine = std::mt19937_64(7);
+    auto dist = BoundedIntDistribution<std::uint64_t>(10u, (std::uint64_t(1) << 40));
+    auto values = std::vector<std::uint64_t>(1000);
+
+    dist.generate(values.begin(), values.end(), engine);
+
+    for (auto val : values)
+    {
+        ASSERT_TRUE(10u <= val && val <= (std::uint64_t(1) << 40));
+    }
+}
+
+TEST(BoundedIntDistributionTest, parameters)
+{
+    auto dist = BoundedIntDistribution<int>(-5, 5);
+    ASSERT_EQ(-5, dist.min());
+    ASSERT_EQ(5, dist.max());
+
+    dist.param(BoundedIntDistribution<int>::param_type(0, 1));
+    ASSERT_EQ(0, dist.a());
+    ASSERT_EQ(1, dist.b());
+    ASSERT_EQ(BoundedIntDistribution<int>(0, 1), dist);
+    ASSERT_NE(BoundedIntDistribution<int>(0, 2), dist);
+}
+
+TEST(BoundedIntDistributionTest, useWithRandomNumberGenerator)
+{
+    auto rng = RandomNumberGenerator<std::mt19937, BoundedIntDistribution<int>>(0);
+
+    ASSERT_TRUE(rng.setBoundries(100, 200));
+    for (auto i = 0; i < 10000; ++i)
+    {
+        auto val = rng();
+        ASSERT_TRUE(100 <= val && val <= 200);
+    }
+}
+
+TEST(ZigguratTest, tablesAreBuiltAtCompileTime)
+{
+    using simons_lib::distributions::detail::ZIGGURAT_NORMAL;
+    using simons_lib::distributions::detail::ZIGGURAT_EXPONENTIAL;
+
+    static_assert(ZIGGURAT_NORMAL.x[1] == 3.6541528853610088);
+    static_assert(ZIGGURAT_NORMAL.x[255] > 0.2 && ZIGGURAT_NORMAL.x[255] < 0.22);
+    static_assert(ZIGGURAT_EXPONENTIAL.x[255] > 0.06 && ZIGGURAT_EXPONENTIAL.x[255] < 0.07);
+
+    for (auto i = 0u; i < 256u; ++i)
+    {
+        ASSERT_GT(ZIGGURAT_NORMAL.x[i], ZIGGURAT_NORMAL.x[i + 1]);
+        ASSERT_NEAR(std::exp(-0.5 * ZIGGURAT_NORMAL.x[i] * ZIGGURAT_NORMAL.x[i]), ZIGGURAT_NORMAL.f[i], 1e-14);
+        ASSERT_NEAR(std::exp(-ZIGGURAT_EXPONENTIAL.x[i]), ZIGGURAT_EXPONENTIAL.f[i], 1e-14);
+    }
+}
+
+TEST(ZigguratNormalDistributionTest, moments)
+{
+    auto engine = std::mt19937_64(1);
+    auto dist = ZigguratNormalDistribution<double>(5.0, 2.0);
+    auto values = std::vector<double>(1000000);
+    auto mean = 0.0;
+    auto variance = 0.0;
+
+    for (auto& val : values)
+    {
+        val = dist(engine);
+    }
+    computeMoments(values, mean, variance);
+
+    ASSERT_NEAR(5.0, mean, 0.01);
+    ASSERT_NEAR(4.0, variance, 0.03);
+}
+
+TEST(ZigguratNormalDistributionTest, tails)
+{
+    auto engine = std::mt19937_64(2);
+    auto dist = ZigguratNormalDistribution<double>();
+    auto samples = 2000000;
+    auto beyondThree = 0;
+    auto negative = 0;
+
+    for (auto i = 0; i < samples; ++i)
+    {
+        auto val = dist(engine);
+        beyondThree += (std::abs(val) > 3.0);
+        negative += (val < 0.0);
+    }
+
+    // P(|X| > 3) = 0.0027
+    ASSERT_NEAR(0.0027, static_cast<double>(beyondThree) / samples, 0.0003);
+    ASSERT_NEAR(0.5, static_cast<double>(negative) / samples, 0.002);
+}
+
+TEST(ZigguratNormalDistributionTest, generate)
+{
+    auto engine = std::mt19937(3);
+    auto dist = ZigguratNormalDistribution<float>(-1.0f, 0.5f);
+    auto values = std::vector<float>(500001);
+    auto mean = 0.0;
+    auto variance = 0.0;
+
+    dist.generate(values.begin(), values.end(), engine);
+    computeMoments(values, mean, variance);
+
+    ASSERT_NEAR(-1.0, mean, 0.01);
+    ASSERT_NEAR(0.25, variance, 0.005);
+}
+
+TEST(ZigguratNormalDistributionTest, useWithRandomNumberGenerator)
+{
+    auto rng = RandomNumberGenerator<std::mt19937_64, ZigguratNormalDistribution<double>>(0);
+    auto values = std::vector<double>(100000);
+    auto mean = 0.0;
+    auto variance = 0.0;
+
+    ASSERT_TRUE(rng.setBoundries(10.0, 20.0));
+    for (auto& val : values)
+    {
+        val = rng();
+    }
+    computeMoments(values, mean, variance);
+
+    ASSERT_NEAR(10.0, mean, 0.5);
+}
+
+TEST(ZigguratExponentialDistributionTest, moments)
+{
+    auto engine = std::mt19937_64(4);
+    auto dist = ZigguratExponentialDistribution<double>(2.0);
+    auto values = std::vector<double>(1000000);
+    auto mean = 0.0;
+    auto variance = 0.0;
+
+    for (auto& val : values)
+    {
+        val = dist(engine);
+        ASSERT_GE(val, 0.0);
+    }
+    computeMoments(values, mean, variance);
+
+    ASSERT_NEAR(0.5, mean, 0.003);
+    ASSERT_NEAR(0.25, variance, 0.005);
+}
+
+TEST(ZigguratExponentialDistributionTest, generate)
+{
+    auto engine = std::mt19937_64(5);
+    auto dist = ZigguratExponentialDistribution<double>(1.0);
+    auto values = std::vector<double>(1000000);
+    auto mean = 0.0;
+    auto variance = 0.0;
+    auto beyondTail = 0;
+
+    dist.generate(values.begin(), values.end(), engine);
+    for (auto val : values)
+    {
+        beyondTail += (val > 8.0);
+    }
+    computeMoments(values, mean, variance);
+
+    ASSERT_NEAR(1.0, mean, 0.005);
+    ASSERT_NEAR(1.0, variance, 0.01);
+    // P(X > 8) = 3.35e-4
+    ASSERT_NEAR(3.35e-4, static_cast<double>(beyondTail) / 1000000.0, 1e-4);
+}
+
+TEST(AliasDistributionTest, matchesWeights)
+{
+    auto engine = std::mt19937_64(6);
+    auto weights = std::vector<double>{1.0, 2.0, 0.0, 4.0, 0.5, 8.0, 3.0, 1.5, 0.0, 6.0};
+    auto dist = AliasDistribution<int>(weights.begin(), weights.end());
+
+    ASSERT_EQ(0, dist.min());
+    ASSERT_EQ(9, dist.max());
+    // Chi-square test with 7 degrees of freedom, p = 0.001
+    ASSERT_LT(chiSquare(dist, engine, weights, 500000), 24.32);
+}
+
+TEST(AliasDistributionTest, probabilities)
+{
+    auto dist = AliasDistribution<int>({1.0, 3.0});
+    auto probs = dist.probabilities();
+
+    ASSERT_EQ(2u, probs.size());
+    ASSERT_DOUBLE_EQ(0.25, probs[0]);
+    ASSERT_DOUBLE_EQ(0.75, probs[1]);
+}
+
+TEST(AliasDistributionTest, degenerateWeights)
+{
+    auto engine = std::mt19937(0);
+    auto empty = std::vector<double>();
+    auto dist = AliasDistribution<int>(empty.begin(), empty.end());
+
+    ASSERT_EQ(0, dist.max());
+    ASSERT_EQ(0, dist(engine));
+
+    auto zeros = AliasDistribution<int>({0.0, -1.0, 0.0});
+    ASSERT_EQ(0, zeros(engine));
+}
+
+TEST(AliasDistributionTest, largeTable)
+{
+    auto engine = std::mt19937_64(7);
+    auto weights = std::vector<double>(100000);
+    for (auto i = std::size_t(0); i < weights.size(); ++i)
+    {
+        weights[i] = static_cast<double>(i % 7 + 1);
+    }
+    auto dist = AliasDistribution<std::uint32_t>(weights.begin(), weights.end());
+
+    // Categories with weight 7 must be drawn about 7 times as often as those with weight 1.
+    auto low = 0;
+    auto high = 0;
+    for (auto i = 0; i < 1000000; ++i)
+    {
+        auto val = dist(engine);
+        low += (val % 7 == 0);
+        high += (val % 7 == 6);
+    }
+    ASSERT_NEAR(7.0, static_cast<double>(high) / low, 0.25);
+}
+
+TEST(AliasDistributionTest, incrementalUpdate)
+{
+    auto engine = std::mt19937_64(8);
+    auto weights = std::vector<double>(100, 1.0);
+    auto dist = AliasDistribution<int>(weights.begin(), weights.end());
+
+    // Small changes are handled without full rebuild.
+    auto updates = std::vector<std::pair<std::size_t, double>>{{3, 5.0}, {10, 0.0}, {42, 0.25}, {99, 4.0}};
+    ASSERT_TRUE(dist.updateWeights(updates.begin(), updates.end()));
+    for (auto const& update : updates)
+    {
+        weights[update.first] = update.second;
+    }
+    // Chi-square test with 98 degrees of freedom, p = 0.001
+    ASSERT_LT(chiSquare(dist, engine, weights, 1000000), 148.0);
+
+    // Large changes trigger a full rebuild.
+    for (auto i = std::size_t(0); i < 50; ++i)
+    {
+        ASSERT_TRUE(dist.updateWeight(i, 2.0));
+        weights[i] = 2.0;
+    }
+    ASSERT_LT(chiSquare(dist, engine, weights, 1000000), 148.0);
+
+    auto probs = dist.probabilities();
+    ASSERT_DOUBLE_EQ(2.0 / 153.0, probs[10]);
+    ASSERT_DOUBLE_EQ(4.0 / 153.0, probs[99]);
+}
+
+TEST(AliasDistributionTest, repeatedUpdateInOneBatch)
+{
+    auto engine = std::mt19937_64(9);
+    auto weights = std::vector<double>(100, 1.0);
+    auto dist = AliasDistribution<int>(weights.begin(), weights.end());
+
+    // Category 3 passes through its base weight within the batch and must
+    // be accounted for only once.
+    auto updates = std::vector<std::pair<std::size_t, double>>{{3, 5.0}, {3, 1.0}, {3, 6.0}, {7, 0.5}, {7, 1.0}};
+    ASSERT_TRUE(dist.updateWeights(updates.begin(), updates.end()));
+    weights[3] = 6.0;
+    // Chi-square test with 99 degrees of freedom, p = 0.001
+    ASSERT_LT(chiSquare(dist, engine, weights, 1000000), 149.0);
+
+    // Returning to the base weight in a later batch keeps the table exact.
+    ASSERT_TRUE(dist.updateWeight(3, 1.0));
+    ASSERT_TRUE(dist.updateWeight(3, 2.0));
+    weights[3] = 2.0;
+    ASSERT_LT(chiSquare(dist, engine, weights, 1000000), 149.0);
+}
+
+TEST(AliasDistributionTest, invalidUpdate)
+{
+    auto dist = AliasDistribution<int>({1.0, 1.0});
+    ASSERT_FALSE(dist.updateWeight(2, 1.0));
+    ASSERT_FALSE(dist.updateWeight(0, -1.0));
+    ASSERT_EQ(AliasDistribution<int>({1.0, 1.0}), dist);
+}
+
+TEST(AliasDistributionTest, useWithRandomNumberGenerator)
+{
+    using Rng = RandomNumberGenerator<std::mt19937_64, AliasDistribution<int>>;
+    auto rng = Rng(0, AliasDistribution<int>({0.0, 1.0, 0.0}));
+
+    for (auto i = 0; i < 1000; ++i)
+    {
+        ASSERT_EQ(1, rng());
+    }
+}
+
+TEST(UniformRealDistributionTest, staysInBoundaries)
+{
+    auto engine = std::mt19937_64(5);
+    auto dist = UniformRealDistribution<double>(-3.0, 7.0);
+    auto values = std::vector<double>(100000);
+    for (auto& val : values)
+    {
+        val = dist(engine);
+        ASSERT_TRUE(-3.0 <= val && val < 7.0);
+    }
+
+    // The largest word must stay below the upper boundary
+    auto largest = LargestWordEngine();
+    ASSERT_LT(UniformRealDistribution<double>()(largest), 1.0);
+    ASSERT_LT(UniformRealDistribution<float>()(largest), 1.0f);
+}
+
+TEST(UniformRealDistributionTest, moments)
+{
+    auto engine = std::mt19937(8);
+    auto floats = UniformRealDistribution<float>(0.0f, 1.0f);
+    auto doubles = UniformRealDistribution<double>(0.0, 1.0);
+    auto floatValues = std::vector<float>(200000);
+    auto doubleValues = std::vector<double>(200000);
+    auto mean = 0.0;
+    auto variance = 0.0;
+
+    for (auto i = std::size_t(0); i < floatValues.size(); ++i)
+    {
+        floatValues[i] = floats(engine);
+        doubleValues[i] = doubles(engine);
+        ASSERT_TRUE(0.0f <= floatValues[i] && floatValues[i] < 1.0f);
+    }
+
+    computeMoments(floatValues, mean, variance);
+    ASSERT_NEAR(0.5, mean, 0.005);
+    ASSERT_NEAR(1.0 / 12.0, variance, 0.002);
+
+    computeMoments(doubleValues, mean, variance);
+    ASSERT_NEAR(0.5, mean, 0.005);
+    ASSERT_NEAR(1.0 / 12.0, variance, 0.002);
+}
+
+TEST(UniformRealDistributionTest, generateMatchesExponentTrick)
+{
+    // The bulk path (SIMD if available) must produce the scalar exponent trick results
+    auto engine = std::mt19937_64(11);
+    auto reference = engine;
+    auto dist = UniformRealDistribution<double>(2.0, 6.0);
+    auto values = std::vector<double>(1001);
+
+    dist.generate(values.begin(), values.end(), engine);
+    for (auto val : values)
+    {
+        auto bits = (reference() >> 12) | 0x3FF0000000000000u;
+        auto unit = double();
+        std::memcpy(&unit, &bits, sizeof(unit));
+        ASSERT_EQ(2.0 + (unit - 1.0) * 4.0, val);
+        ASSERT_TRUE(2.0 <= val && val < 6.0);
+    }
+}
+
+TEST(UniformRealDistributionTest, generate)
+{
+    auto engine = std::mt19937(4);
+    auto floats = UniformRealDistribution<float>(-1.0f, 1.0f);
+    auto values = std::vector<float>(200000);
+    auto mean = 0.0;
+    auto variance = 0.0;
+
+    floats.generate(values.begin(), values.end(), engine);
+    for (auto val : values)
+    {
+        ASSERT_TRUE(-1.0f <= val && val < 1.0f);
+    }
+    computeMoments(values, mean, variance);
+
+    ASSERT_NEAR(0.0, mean, 0.01);
+    ASSERT_NEAR(1.0 / 3.0, variance, 0.005);
+}
+
+TEST(UniformRealDistributionTest, useWithRandomNumberGenerator)
+{
+    auto rng = RandomNumberGenerator<std::mt19937_64, UniformRealDistribution<double>>(0);
+
+    ASSERT_TRUE(rng.setBoundries(10.0, 20.0));
+    for (auto i = 0; i < 10000; ++i)
+    {
+        auto val = rng();
+        ASSERT_TRUE(10.0 <= val && val < 20.0);
+    }
+}
@@ -0,0 +1,163 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <Distributions.hpp>
+#include <Engines.hpp>
+#include <RandomNumberGenerator.hpp>
+
+using simons_lib::engines::Pcg32;
+using simons_lib::engines::XorShift32;
+using simons_lib::engines::XorShift64;
+using simons_lib::engines::SplitMix64;
+using simons_lib::distributions::BoundedIntDistribution;
+using simons_lib::random_number_generator::RandomNumberGenerator;
+
+namespace
+{
+template<typename E>
+void checkDiscard(void)
+{
+    auto drawn = E();
+    auto skipped = E();
+    for (auto i = 0; i < 12345; ++i)
+    {
+        drawn();
+    }
+    skipped.discard(12345u);
+    ASSERT_EQ(drawn, skipped);
+    ASSERT_EQ(drawn(), skipped());
+}
+
+template<typename E>
+void checkUniform(void)
+{
+    // Chi-square test with 63 degrees of freedom, p = 0.001
+    auto rng = RandomNumberGenerator<E, BoundedIntDistribution<int>>(12345u);
+    auto counts = std::vector<int>(64);
+    auto samples = 640000;
+    ASSERT_TRUE(rng.setBoundries(0, 63));
+    for (auto i = 0; i < samples; ++i)
+    {
+        ++counts[static_cast<std::size_t>(rng())];
+    }
+
+    auto expected = samples / 64.0;
+    auto result = 0.0;
+    for (auto count : counts)
+    {
+        result += (count - expected) * (count - expected) / expected;
+    }
+    ASSERT_LT(result, 103.44);
+}
+} // namespace
+
+TEST(EnginesTest, stateSize)
+{
+    ASSERT_EQ(16u, sizeof(Pcg32));
+    ASSERT_EQ(4u, sizeof(XorShift32));
+    ASSERT_EQ(8u, sizeof(XorShift64));
+    ASSERT_EQ(8u, sizeof(SplitMix64));
+}
+
+TEST(EnginesTest, pcg32ReferenceValues)
+{
+    // Output of the reference implementation pcg32-demo (seed 42, stream 54)
+    auto engine = Pcg32(42u, 54u);
+    auto expected = std::vector<std::uint32_t>{0xA15C02B7u, 0x7B47F409u, 0xBA1D3330u,
+                                               0x83D2F293u, 0xBFA4784Bu, 0xCBED606Eu};
+    for (auto value : expected)
+    {
+        ASSERT_EQ(value, engine());
+    }
+
+    // Different streams give different sequences
+    ASSERT_NE(Pcg32(42u, 54u)(), Pcg32(42u, 55u)());
+}
+
+TEST(EnginesTest, xorShiftReferenceValues)
+{
+    // Values from G. Marsaglia, "Xorshift RNGs", 2003
+    ASSERT_EQ(723471715u, XorShift32()());
+
+    auto engine = XorShift64();
+    ASSERT_EQ(8748534153485358512u, engine());
+    ASSERT_EQ(3040900993826735515u, engine());
+    ASSERT_EQ(3453997556048239312u, engine());
+
+    // A zero state would only produce zeros
+    ASSERT_EQ(XorShift32(), XorShift32(0u));
+}
+
+TEST(EnginesTest, splitMix64ReferenceValues)
+{
+    auto engine = SplitMix64(1234567u);
+    ASSERT_EQ(6457827717110365317u, engine());
+    ASSERT_EQ(3203168211198807973u, engine());
+    ASSERT_EQ(9817491932198370423u, engine());
+}
+
+TEST(EnginesTest, discard)
+{
+    checkDiscard<Pcg32>();
+    checkDiscard<XorShift32>();
+    checkDiscard<XorShift64>();
+    checkDiscard<SplitMix64>();
+}
+
+TEST(EnginesTest, useWithRandomNumberGenerator)
+{
+    checkUniform<Pcg32>();
+    checkUniform<XorShift32>();
+    checkUniform<XorShift64>();
+    checkUniform<SplitMix64>();
+
+    // Usable with std distributions as well
+    auto rng = RandomNumberGenerator<Pcg32, std::uniform_real_distribution<double>>(1u);
+    ASSERT_TRUE(rng.setBoundries(-1.0, 1.0));
+    for (auto i = 0; i < 1000; ++i)
+    {
+        auto val = rng();
+        ASSERT_TRUE(-1.0 <= val && val < 1.0);
+    }
+}
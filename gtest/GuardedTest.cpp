@@ -0,0 +1,277 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <Guarded.hpp>
+#include <Mutex.hpp>
+#include <NullTypes.hpp>
+#include <RandomNumberGenerator.hpp>
+#include <Stack.hpp>
+
+using simons_lib::guarded::FlatCombined;
+using simons_lib::guarded::Guarded;
+using simons_lib::guarded::ShardedArray;
+using simons_lib::mutex::SpinLock;
+using simons_lib::mutex::FutexMutex;
+using simons_lib::null_types::NullMutex;
+using simons_lib::random_number_generator::RandomNumberGenerator;
+using simons_lib::stack::Stack;
+
+namespace
+{
+// SharedLockable mutex counting how often each locking mode was used.
+struct CountingSharedMutex
+{
+    static inline int exclusive = 0;
+    static inline int shared = 0;
+
+    void lock(void) { m_mutex.lock(); ++exclusive; }
+    bool try_lock(void) { return m_mutex.try_lock(); }
+    void unlock(void) { m_mutex.unlock(); }
+    void lock_shared(void) { m_mutex.lock_shared(); ++shared; }
+    bool try_lock_shared(void) { return m_mutex.try_lock_shared(); }
+    void unlock_shared(void) { m_mutex.unlock_shared(); }
+
+    std::shared_mutex m_mutex;
+};
+} // namespace
+
+TEST(GuardedTest, occupiesCacheLines)
+{
+    ASSERT_EQ(SIMONS_LIB_CACHE_LINE_SIZE, alignof(Guarded<int, std::mutex>));
+    ASSERT_EQ(SIMONS_LIB_CACHE_LINE_SIZE, sizeof(Guarded<int, FutexMutex>));
+    struct Large
+    {
+        char data[100];
+    };
+    ASSERT_EQ(0u, sizeof(Guarded<Large>) % SIMONS_LIB_CACHE_LINE_SIZE);
+}
+
+TEST(GuardedTest, lockedAccess)
+{
+    auto guarded = Guarded<std::string, std::mutex>("abc");
+    {
+        auto value = guarded.lock();
+        value->append("def");
+        ASSERT_EQ("abcdef", *value);
+    }
+    ASSERT_EQ("abcdef", guarded.load());
+
+    guarded.store("xyz");
+    ASSERT_EQ(3u, guarded.apply([] (std::string& value) { return value.size(); }));
+}
+
+TEST(GuardedTest, constAccessIsShared)
+{
+    CountingSharedMutex::exclusive = 0;
+    CountingSharedMutex::shared = 0;
+
+    auto guarded = Guarded<int, CountingSharedMutex>(42);
+    auto const& readOnly = guarded;
+    ASSERT_EQ(42, readOnly.apply([] (int const& value) { return value; }));
+    ASSERT_EQ(42, guarded.load());
+    ASSERT_EQ(2, CountingSharedMutex::shared);
+    ASSERT_EQ(0, CountingSharedMutex::exclusive);
+
+    guarded.apply([] (int& value) { ++value; });
+    ASSERT_EQ(1, CountingSharedMutex::exclusive);
+}
+
+TEST(GuardedTest, concurrentUpdates)
+{
+    auto guarded = Guarded<std::uint64_t, SpinLock>(0u);
+    auto threads = std::vector<std::thread>();
+    for (auto i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([&guarded] ()
+        {
+            for (auto n = 0; n < 10000; ++n)
+            {
+                auto value = guarded.lock();
+                *value = *value + 1u;
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    ASSERT_EQ(40000u, guarded.load());
+}
+
+TEST(ShardedArrayTest, shardsDoNotShareCacheLines)
+{
+    auto array = ShardedArray<std::uint64_t, std::mutex>(4);
+    ASSERT_EQ(4u, array.size());
+    for (auto i = 1u; i < array.size(); ++i)
+    {
+        auto distance = reinterpret_cast<std::uintptr_t>(&array[i]) - reinterpret_cast<std::uintptr_t>(&array[i - 1u]);
+        ASSERT_LE(std::uintptr_t(SIMONS_LIB_CACHE_LINE_SIZE), distance);
+        ASSERT_EQ(0u, reinterpret_cast<std::uintptr_t>(&array[i]) % SIMONS_LIB_CACHE_LINE_SIZE);
+    }
+
+    // At least one shard
+    ASSERT_EQ(1u, ShardedArray<int>(0).size());
+}
+
+TEST(ShardedArrayTest, shardForKey)
+{
+    auto array = ShardedArray<int>(8);
+    ASSERT_EQ(&array.shardFor(std::string("key")), &array.shardFor(std::string("key")));
+
+    // Consecutive integer keys spread over the shards
+    auto used = std::set<void const*>();
+    for (auto key = 0; key < 64; ++key)
+    {
+        used.insert(&array.shardFor(key));
+    }
+    ASSERT_LT(4u, used.size());
+}
+
+TEST(ShardedArrayTest, shardedCounter)
+{
+    constexpr auto THREADS = 4;
+    constexpr auto INCREMENTS = 10000;
+
+    auto counters = ShardedArray<std::uint64_t, FutexMutex>(THREADS);
+    auto threads = std::vector<std::thread>();
+    for (auto i = 0; i < THREADS; ++i)
+    {
+        threads.emplace_back([&counters] ()
+        {
+            for (auto n = 0; n < INCREMENTS; ++n)
+            {
+                counters.localShard().apply([] (std::uint64_t& value) { ++value; });
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    auto total = std::uint64_t(0);
+    counters.forEach([&total] (std::uint64_t const& value) { total += value; });
+    ASSERT_EQ(std::uint64_t(THREADS * INCREMENTS), total);
+}
+
+TEST(FlatCombinedTest, applyReturnsResult)
+{
+    auto combined = FlatCombined<std::string>("abc");
+    ASSERT_EQ(3u, combined.apply([] (std::string& value) { return value.size(); }));
+    combined.apply([] (std::string& value) { value.append("def"); });
+
+    // References are returned as copies
+    auto copy = combined.apply([] (std::string& value) -> std::string& { return value; });
+    copy.clear();
+    ASSERT_EQ("abcdef", combined.apply([] (std::string& value) { return value; }));
+}
+
+TEST(FlatCombinedTest, singleThreaded)
+{
+    auto combined = FlatCombined<int, NullMutex>(1);
+    ASSERT_EQ(2, combined.apply([] (int& value) { return ++value; }));
+}
+
+TEST(FlatCombinedTest, exceptionReachesPostingThread)
+{
+    auto combined = FlatCombined<int>(1);
+    ASSERT_THROW(combined.apply([] (int&) -> int { throw std::runtime_error("failed"); }), std::runtime_error);
+
+    // Mutex was released and the slot is reusable
+    ASSERT_EQ(2, combined.apply([] (int& value) { return ++value; }));
+}
+
+TEST(FlatCombinedTest, concurrentStack)
+{
+    constexpr auto THREADS = 4;
+    constexpr auto OPERATIONS = 5000;
+
+    auto combined = FlatCombined<Stack<int, 16>, SpinLock>();
+    auto threads = std::vector<std::thread>();
+    for (auto i = 0; i < THREADS; ++i)
+    {
+        threads.emplace_back([&combined] ()
+        {
+            for (auto n = 0; n < OPERATIONS; ++n)
+            {
+                // Each push is followed by a pop, the stack never overflows.
+                ASSERT_TRUE(combined.apply([n] (Stack<int, 16>& stack) { return stack.push(int(n)).isOk(); }));
+                ASSERT_TRUE(combined.apply([] (Stack<int, 16>& stack) { return stack.pop().isOk(); }));
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    ASSERT_TRUE(combined.apply([] (Stack<int, 16>& stack) { return stack.empty(); }));
+}
+
+TEST(FlatCombinedTest, concurrentRandomNumberGenerator)
+{
+    using Rng = RandomNumberGenerator<std::mt19937, std::uniform_int_distribution<int>>;
+    constexpr auto THREADS = 4;
+    constexpr auto DRAWS = 5000;
+
+    auto combined = FlatCombined<Rng>(42u);
+    combined.apply([] (Rng& rng) { rng.setBoundries(0, 9); });
+
+    auto draws = std::atomic<int>(0);
+    auto threads = std::vector<std::thread>();
+    for (auto i = 0; i < THREADS; ++i)
+    {
+        threads.emplace_back([&combined, &draws] ()
+        {
+            for (auto n = 0; n < DRAWS; ++n)
+            {
+                auto value = combined.apply([] (Rng& rng) { return rng(); });
+                ASSERT_TRUE(0 <= value && value <= 9);
+                draws.fetch_add(1);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    ASSERT_EQ(THREADS * DRAWS, draws.load());
+}
@@ -34,8 +34,15 @@
 #include <LockGuard.hpp>
 #include <NullTypes.hpp>
 #include <mutex>
+#include <shared_mutex>
 
 using simons_lib::lock::LockGuard;
+using simons_lib::lock::ADOPT_LOCK;
+using simons_lib::lock::SharedLockGuard;
+using simons_lib::lock::ReadLockGuard;
+using simons_lib::lock::IsSharedLockable;
+using simons_lib::lock::CallSite;
+using simons_lib::lock::IsCallSiteLockable;
 using simons_lib::null_types::NullMutex;
 
 TEST(LockGuardTest, behavior)
@@ -70,8 +77,91 @@ TEST(LockGuardTest, guard_with_std_mutex)
     auto guard = LockGuard<decltype(lock)>(lock);
 }
 
+TEST(LockGuardTest, adopt_locked_mutex)
+{
+    auto lock = std::mutex();
+    ASSERT_TRUE(lock.try_lock());
+    {
+        auto guard = LockGuard<decltype(lock)>(lock, ADOPT_LOCK);
+    }
+    ASSERT_TRUE(lock.try_lock());
+    lock.unlock();
+}
+
 TEST(LockGuardTest, guard_width_dummy_mutex)
 {
     auto lock = NullMutex();
     auto guard = LockGuard<decltype(lock)>(lock);
 }
+
+TEST(LockGuardTest, passes_call_site)
+{
+    struct TestCallSiteLockable
+    {
+        CallSite site = {nullptr, nullptr, 0};
+
+        void lock(CallSite const& where)
+        {
+            site = where;
+        };
+
+        void unlock(void)
+        {
+        };
+    };
+    ASSERT_TRUE(IsCallSiteLockable<TestCallSiteLockable>::value);
+    ASSERT_FALSE(IsCallSiteLockable<std::mutex>::value);
+
+    auto lock = TestCallSiteLockable();
+    auto expectedLine = __LINE__ + 1;
+    auto guard = LockGuard<decltype(lock)>(lock);
+    ASSERT_EQ(expectedLine, lock.site.line);
+}
+
+TEST(SharedLockGuardTest, behavior)
+{
+    struct TestSharedLockable
+    {
+        int exclusive = 0;
+        int shared = 0;
+
+        void lock(void) { ++exclusive; }
+        bool try_lock(void) { return true; }
+        void unlock(void) { ++exclusive; }
+        void lock_shared(void) { ++shared; }
+        bool try_lock_shared(void) { return true; }
+        void unlock_shared(void) { ++shared; }
+    };
+
+    auto lock = TestSharedLockable();
+    {
+        auto guard = SharedLockGuard<decltype(lock)>(lock);
+    }
+    ASSERT_EQ(0, lock.exclusive);
+    ASSERT_EQ(2, lock.shared);
+
+    {
+        auto guard = ReadLockGuard<decltype(lock)>(lock);
+    }
+    ASSERT_EQ(0, lock.exclusive);
+    ASSERT_EQ(4, lock.shared);
+}
+
+TEST(SharedLockGuardTest, guard_with_std_shared_mutex)
+{
+    auto lock = std::shared_mutex();
+    auto guard1 = SharedLockGuard<decltype(lock)>(lock);
+    auto guard2 = SharedLockGuard<decltype(lock)>(lock);
+    ASSERT_FALSE(lock.try_lock());
+}
+
+TEST(SharedLockGuardTest, detectSharedLockable)
+{
+    ASSERT_FALSE(IsSharedLockable<std::mutex>::value);
+    ASSERT_TRUE(IsSharedLockable<std::shared_mutex>::value);
+    ASSERT_TRUE(IsSharedLockable<NullMutex>::value);
+
+    // Read guard falls back to exclusive locking
+    ASSERT_TRUE((std::is_same_v<LockGuard<std::mutex>, ReadLockGuard<std::mutex>>));
+    ASSERT_TRUE((std::is_same_v<SharedLockGuard<std::shared_mutex>, ReadLockGuard<std::shared_mutex>>));
+}
@@ -0,0 +1,129 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <Distributions.hpp>
+#include <MonteCarlo.hpp>
+
+using simons_lib::monte_carlo::MonteCarlo;
+using simons_lib::distributions::UniformRealDistribution;
+
+namespace
+{
+using PiEstimator = MonteCarlo<std::mt19937_64, UniformRealDistribution<double>>;
+
+// Trial: Is a random point of the unit square inside the unit circle?
+double insideCircle(PiEstimator::GeneratorType& rng)
+{
+    auto x = rng();
+    auto y = rng();
+    return (x * x + y * y < 1.0) ? 4.0 : 0.0;
+}
+
+double sum(double lhs, double rhs)
+{
+    return lhs + rhs;
+}
+} // namespace
+
+TEST(MonteCarloTest, estimatesPi)
+{
+    auto trials = std::uint64_t(1000000);
+    auto estimator = PiEstimator(42);
+    auto pi = estimator.run(trials, 0.0, insideCircle, sum) / static_cast<double>(trials);
+
+    ASSERT_NEAR(3.14159265, pi, 0.01);
+}
+
+TEST(MonteCarloTest, bitIdenticalForAnyThreadCount)
+{
+    // Floating point addition is not associative, equality requires a fixed reduction order
+    auto trials = std::uint64_t(300001);
+    auto reference = PiEstimator(7, UniformRealDistribution<double>(), 1000, 1).run(trials, 0.0, insideCircle, sum);
+    for (auto threads : {2u, 3u, 8u, 0u})
+    {
+        auto result = PiEstimator(7, UniformRealDistribution<double>(), 1000, threads).run(trials, 0.0, insideCircle, sum);
+        ASSERT_EQ(reference, result);
+    }
+
+    // A different seed gives a different estimate
+    ASSERT_NE(reference, PiEstimator(8, UniformRealDistribution<double>(), 1000, 1).run(trials, 0.0, insideCircle, sum));
+}
+
+TEST(MonteCarloTest, reducesInTrialOrder)
+{
+    using Collector = MonteCarlo<std::mt19937, std::uniform_int_distribution<int>>;
+    auto trial = [] (Collector::GeneratorType& rng)
+    {
+        return std::vector<int>{rng()};
+    };
+    auto concat = [] (std::vector<int> lhs, std::vector<int> const& rhs)
+    {
+        lhs.insert(lhs.end(), rhs.begin(), rhs.end());
+        return lhs;
+    };
+
+    auto sequential = Collector(3, std::uniform_int_distribution<int>(0, 1000), 10, 1).run(1005u, std::vector<int>(),
+                                                                                          trial, concat);
+    auto parallel = Collector(3, std::uniform_int_distribution<int>(0, 1000), 10, 4).run(1005u, std::vector<int>(),
+                                                                                        trial, concat);
+    ASSERT_EQ(1005u, sequential.size());
+    ASSERT_EQ(sequential, parallel);
+}
+
+TEST(MonteCarloTest, degenerateParameters)
+{
+    auto counter = MonteCarlo<std::mt19937, std::uniform_int_distribution<int>>(1, std::uniform_int_distribution<int>(), 0);
+    auto one = [] (auto&)
+    {
+        return std::uint64_t(1);
+    };
+    auto add = [] (std::uint64_t lhs, std::uint64_t rhs)
+    {
+        return lhs + rhs;
+    };
+
+    ASSERT_EQ(1u, counter.chunkSize());
+    ASSERT_EQ(0u, counter.run(0u, std::uint64_t(0), one, add));
+    ASSERT_EQ(77u, counter.run(77u, std::uint64_t(0), one, add));
+}
@@ -0,0 +1,525 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+#include <type_traits>
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+#include <CachedCallable.hpp>
+#include <LockGuard.hpp>
+#include <Mutex.hpp>
+#include <RandomNumberGenerator.hpp>
+
+using simons_lib::lock::LockGuard;
+using simons_lib::mutex::SpinLock;
+using simons_lib::mutex::TicketLock;
+using simons_lib::mutex::McsLock;
+using simons_lib::mutex::DistributedRwLock;
+using simons_lib::mutex::FutexMutex;
+using simons_lib::mutex::InstrumentedMutex;
+using simons_lib::mutex::LockHistogram;
+using simons_lib::mutex::LockRegistry;
+using simons_lib::mutex::LockSiteStats;
+using simons_lib::mutex::ProfiledMutex;
+using simons_lib::lock::SharedLockGuard;
+using simons_lib::cached_callable::CachedCallable;
+using simons_lib::random_number_generator::RandomNumberGenerator;
+
+namespace
+{
+// Increment a plain counter from several threads. Lost updates reveal broken mutual exclusion.
+template<typename M>
+void checkMutualExclusion(void)
+{
+    constexpr auto THREADS = 4u;
+    constexpr auto INCREMENTS = 20000u;
+
+    auto mutex = M();
+    auto counter = std::uint64_t(0);
+    auto work = [&mutex, &counter] ()
+    {
+        for (auto i = 0u; i < INCREMENTS; ++i)
+        {
+            auto guard = LockGuard<M>(mutex);
+            counter = counter + 1u;
+        }
+    };
+
+    auto threads = std::vector<std::thread>();
+    for (auto i = 0u; i < THREADS; ++i)
+    {
+        threads.emplace_back(work);
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    ASSERT_EQ(THREADS * INCREMENTS, counter);
+}
+
+// Check lock, try_lock and unlock on a single thread.
+template<typename M>
+void checkTryLock(void)
+{
+    auto mutex = M();
+    ASSERT_TRUE(mutex.try_lock());
+
+    // Held by another thread, try_lock must fail
+    auto acquired = true;
+    std::thread([&mutex, &acquired] () { acquired = mutex.try_lock(); }).join();
+    ASSERT_FALSE(acquired);
+
+    mutex.unlock();
+    mutex.lock();
+    mutex.unlock();
+    std::thread([&mutex, &acquired] () { acquired = mutex.try_lock(); }).join();
+    ASSERT_TRUE(acquired);
+    mutex.unlock();
+}
+
+// Threads queuing up one after another must be served in arrival order.
+template<typename M>
+void checkFifo(void)
+{
+    constexpr auto WAITERS = 4;
+
+    auto mutex = M();
+    auto order = std::vector<int>();
+    auto threads = std::vector<std::thread>();
+    mutex.lock();
+    for (auto i = 0; i < WAITERS; ++i)
+    {
+        threads.emplace_back([&mutex, &order, i] ()
+        {
+            auto guard = LockGuard<M>(mutex);
+            order.push_back(i);
+        });
+
+        // Give the waiter time to enqueue before the next one arrives.
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    mutex.unlock();
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    ASSERT_EQ((std::vector<int>{0, 1, 2, 3}), order);
+}
+} // namespace
+
+TEST(SpinLockTest, occupiesCacheLine)
+{
+    ASSERT_EQ(SIMONS_LIB_CACHE_LINE_SIZE, alignof(SpinLock));
+    ASSERT_EQ(SIMONS_LIB_CACHE_LINE_SIZE, sizeof(SpinLock));
+}
+
+TEST(SpinLockTest, tryLock)
+{
+    checkTryLock<SpinLock>();
+}
+
+TEST(SpinLockTest, mutualExclusion)
+{
+    checkMutualExclusion<SpinLock>();
+}
+
+TEST(SpinLockTest, useAsMutexType)
+{
+    auto rng = RandomNumberGenerator<std::mt19937, std::uniform_int_distribution<int>, SpinLock>(1u);
+    ASSERT_TRUE(rng.setBoundries(0, 9));
+    auto val = rng();
+    ASSERT_TRUE(0 <= val && val <= 9);
+
+    auto cached = CachedCallable<int, SpinLock>([] () { return 42; });
+    ASSERT_EQ(42, cached());
+}
+
+TEST(TicketLockTest, tryLock)
+{
+    checkTryLock<TicketLock>();
+}
+
+TEST(TicketLockTest, mutualExclusion)
+{
+    checkMutualExclusion<TicketLock>();
+}
+
+TEST(TicketLockTest, isFifo)
+{
+    checkFifo<TicketLock>();
+}
+
+TEST(McsLockTest, tryLock)
+{
+    checkTryLock<McsLock>();
+}
+
+TEST(McsLockTest, mutualExclusion)
+{
+    checkMutualExclusion<McsLock>();
+}
+
+TEST(McsLockTest, isFifo)
+{
+    checkFifo<McsLock>();
+}
+
+TEST(McsLockTest, nestedLocks)
+{
+    // Each held lock needs its own queue node
+    auto outer = McsLock();
+    auto inner = McsLock();
+    auto counter = 0;
+    auto work = [&] ()
+    {
+        for (auto i = 0; i < 10000; ++i)
+        {
+            auto outerGuard = LockGuard<McsLock>(outer);
+            auto innerGuard = LockGuard<McsLock>(inner);
+            counter = counter + 1;
+        }
+    };
+
+    auto t1 = std::thread(work);
+    auto t2 = std::thread(work);
+    t1.join();
+    t2.join();
+    ASSERT_EQ(20000, counter);
+}
+
+TEST(QueueLockTest, useAsMutexType)
+{
+    auto rng = RandomNumberGenerator<std::mt19937, std::uniform_int_distribution<int>, TicketLock>(1u);
+    ASSERT_TRUE(rng.setBoundries(0, 9));
+    auto val = rng();
+    ASSERT_TRUE(0 <= val && val <= 9);
+
+    auto cached = CachedCallable<int, McsLock>([] () { return 42; });
+    ASSERT_EQ(42, cached());
+}
+
+TEST(FutexMutexTest, isCompact)
+{
+    ASSERT_EQ(4u, sizeof(FutexMutex));
+}
+
+TEST(FutexMutexTest, tryLock)
+{
+    checkTryLock<FutexMutex>();
+}
+
+TEST(FutexMutexTest, mutualExclusion)
+{
+    checkMutualExclusion<FutexMutex>();
+}
+
+TEST(FutexMutexTest, sleepingWaiters)
+{
+    // Long critical sections exhaust the spin budget, waiters go to sleep.
+    auto mutex = FutexMutex();
+    auto counter = 0;
+    auto work = [&mutex, &counter] ()
+    {
+        for (auto i = 0; i < 20; ++i)
+        {
+            auto guard = LockGuard<FutexMutex>(mutex);
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            counter = counter + 1;
+        }
+    };
+
+    auto threads = std::vector<std::thread>();
+    for (auto i = 0; i < 4; ++i)
+    {
+        threads.emplace_back(work);
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    ASSERT_EQ(80, counter);
+}
+
+TEST(FutexMutexTest, useAsMutexType)
+{
+    auto rng = RandomNumberGenerator<std::mt19937, std::uniform_int_distribution<int>, FutexMutex>(1u);
+    ASSERT_TRUE(rng.setBoundries(0, 9));
+    auto val = rng();
+    ASSERT_TRUE(0 <= val && val <= 9);
+
+    auto cached = CachedCallable<int, FutexMutex>([] () { return 42; });
+    ASSERT_EQ(42, cached());
+}
+
+TEST(DistributedRwLockTest, tryLock)
+{
+    checkTryLock<DistributedRwLock<>>();
+}
+
+TEST(DistributedRwLockTest, mutualExclusion)
+{
+    checkMutualExclusion<DistributedRwLock<>>();
+}
+
+TEST(DistributedRwLockTest, sharedAndExclusive)
+{
+    auto mutex = DistributedRwLock<4>();
+
+    // Readers share the lock, writers are locked out
+    ASSERT_TRUE(mutex.try_lock_shared());
+    auto acquired = false;
+    auto excluded = false;
+    std::thread([&mutex, &acquired, &excluded] ()
+    {
+        // Readers must release the lock on the thread that acquired it.
+        acquired = mutex.try_lock_shared();
+        if (acquired)
+        {
+            excluded = !mutex.try_lock();
+            mutex.unlock_shared();
+        }
+    }).join();
+    ASSERT_TRUE(acquired);
+    ASSERT_TRUE(excluded);
+    ASSERT_FALSE(mutex.try_lock());
+    mutex.unlock_shared();
+
+    // Writer locks out readers
+    ASSERT_TRUE(mutex.try_lock());
+    std::thread([&mutex, &acquired] () { acquired = mutex.try_lock_shared(); }).join();
+    ASSERT_FALSE(acquired);
+    mutex.unlock();
+    ASSERT_TRUE(mutex.try_lock_shared());
+    mutex.unlock_shared();
+}
+
+TEST(DistributedRwLockTest, writerPreference)
+{
+    auto mutex = DistributedRwLock<4>();
+    mutex.lock_shared();
+
+    // Writer waits for the reader to leave
+    auto writerDone = std::atomic<bool>(false);
+    auto writer = std::thread([&mutex, &writerDone] ()
+    {
+        mutex.lock();
+        writerDone = true;
+        mutex.unlock();
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_FALSE(writerDone);
+
+    // Waiting writer blocks new readers
+    auto acquired = true;
+    std::thread([&mutex, &acquired] () { acquired = mutex.try_lock_shared(); }).join();
+    ASSERT_FALSE(acquired);
+
+    mutex.unlock_shared();
+    writer.join();
+    ASSERT_TRUE(writerDone);
+}
+
+TEST(DistributedRwLockTest, readersSeeConsistentState)
+{
+    constexpr auto READERS = 3;
+    constexpr auto WRITES = 2000;
+
+    auto mutex = DistributedRwLock<>();
+    auto a = 0;
+    auto b = 0;
+    auto torn = std::atomic<int>(0);
+    auto done = std::atomic<bool>(false);
+
+    auto threads = std::vector<std::thread>();
+    for (auto i = 0; i < READERS; ++i)
+    {
+        threads.emplace_back([&] ()
+        {
+            while (!done)
+            {
+                auto guard = SharedLockGuard<DistributedRwLock<>>(mutex);
+                if (a != b)
+                {
+                    ++torn;
+                }
+            }
+        });
+    }
+
+    for (auto i = 0; i < WRITES; ++i)
+    {
+        auto guard = LockGuard<DistributedRwLock<>>(mutex);
+        ++a;
+        ++b;
+    }
+    done = true;
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    ASSERT_EQ(0, torn.load());
+    ASSERT_EQ(WRITES, a);
+}
+
+TEST(DistributedRwLockTest, useAsMutexType)
+{
+    auto cached = CachedCallable<int, DistributedRwLock<>>([] () { return 42; });
+    ASSERT_EQ(42, cached());
+    ASSERT_EQ(42, cached());
+}
+
+TEST(InstrumentedMutexTest, countsAcquisitions)
+{
+    auto mutex = InstrumentedMutex<std::mutex>("counted");
+    for (auto i = 0; i < 3; ++i)
+    {
+        auto guard = LockGuard<decltype(mutex)>(mutex);
+    }
+    ASSERT_TRUE(mutex.try_lock());
+    mutex.unlock();
+
+    auto const& stats = mutex.stats();
+    ASSERT_EQ("counted", stats.name());
+    ASSERT_EQ(4u, stats.acquisitions());
+    ASSERT_EQ(0u, stats.contended());
+    ASSERT_EQ(4u, stats.waitHistogram().count());
+    ASSERT_EQ(4u, stats.holdHistogram().count());
+}
+
+TEST(InstrumentedMutexTest, detectsContention)
+{
+    auto mutex = InstrumentedMutex<std::mutex>("contended");
+    mutex.lock();
+    auto waiter = std::thread([&mutex] ()
+    {
+        auto guard = LockGuard<decltype(mutex)>(mutex);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    mutex.unlock();
+    waiter.join();
+
+    auto const& stats = mutex.stats();
+    ASSERT_EQ(2u, stats.acquisitions());
+    ASSERT_EQ(1u, stats.contended());
+    ASSERT_LE(std::uint64_t(1000000), stats.waitNs());
+    ASSERT_LE(std::uint64_t(1000000), stats.holdNs());
+    ASSERT_LE(std::uint64_t(1000000), stats.waitHistogram().percentile(1.0));
+}
+
+TEST(InstrumentedMutexTest, recordsCallSites)
+{
+    auto mutex = InstrumentedMutex<SpinLock>();
+    auto firstLine = __LINE__ + 3;
+    for (auto i = 0; i < 2; ++i)
+    {
+        auto guard = LockGuard<decltype(mutex)>(mutex);
+    }
+    auto secondLine = __LINE__ + 1;
+    auto guard = LockGuard<decltype(mutex)>(mutex);
+
+    LockSiteStats const* sites = nullptr;
+    ASSERT_EQ(2u, mutex.stats().sites(sites));
+    ASSERT_EQ(firstLine, sites[0].site.line);
+    ASSERT_EQ(2u, sites[0].acquisitions.load());
+    ASSERT_EQ(secondLine, sites[1].site.line);
+    ASSERT_EQ(1u, sites[1].acquisitions.load());
+    ASSERT_NE(nullptr, std::strstr(sites[0].site.file, "MutexTest.cpp"));
+}
+
+TEST(InstrumentedMutexTest, registryReport)
+{
+    LockRegistry::instance().clear();
+    auto quiet = InstrumentedMutex<std::mutex>("quiet");
+    auto busy = InstrumentedMutex<std::mutex>("busy");
+    {
+        auto guard = LockGuard<decltype(quiet)>(quiet);
+    }
+
+    busy.lock();
+    auto waiter = std::thread([&busy] () { auto guard = LockGuard<decltype(busy)>(busy); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    busy.unlock();
+    waiter.join();
+
+    // Most contended mutex comes first
+    auto ranked = LockRegistry::instance().ranked();
+    ASSERT_EQ(2u, ranked.size());
+    ASSERT_EQ("busy", ranked[0]->name());
+    ASSERT_EQ("quiet", ranked[1]->name());
+
+    auto report = LockRegistry::instance().report();
+    ASSERT_NE(std::string::npos, report.find("#1 busy"));
+    ASSERT_NE(std::string::npos, report.find("#2 quiet"));
+    ASSERT_NE(std::string::npos, report.find("MutexTest.cpp"));
+    LockRegistry::instance().clear();
+}
+
+TEST(InstrumentedMutexTest, histogram)
+{
+    auto histogram = LockHistogram();
+    ASSERT_EQ(0u, histogram.percentile(0.5));
+
+    histogram.record(0u);
+    histogram.record(100u);
+    histogram.record(100u);
+    histogram.record(5000u);
+    ASSERT_EQ(4u, histogram.count());
+    ASSERT_EQ(0u, histogram.percentile(0.0));
+    ASSERT_EQ(128u, histogram.percentile(0.5));
+    ASSERT_EQ(8192u, histogram.percentile(1.0));
+}
+
+TEST(InstrumentedMutexTest, useAsMutexType)
+{
+    auto cached = CachedCallable<int, InstrumentedMutex<FutexMutex>>([] () { return 42; });
+    ASSERT_EQ(42, cached());
+
+    // Instrumentation is compiled in on demand only
+    ASSERT_TRUE((std::is_same_v<std::mutex, ProfiledMutex<std::mutex>>));
+}
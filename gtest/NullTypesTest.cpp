@@ -31,12 +31,46 @@
  */
 
 #include <gtest/gtest.h>
-#include <NullTypes.hpp>
+#include <chrono>
 #include <mutex>
+#include <type_traits>
+#include <Barrier.hpp>
+#include <NullTypes.hpp>
 
+using simons_lib::barrier::SpinBarrier;
+using simons_lib::barrier::SpinLatch;
+using simons_lib::null_types::NullBarrier;
+using simons_lib::null_types::NullLatch;
 using simons_lib::null_types::NullMutex;
 using simons_lib::null_types::NullObj;
 
+namespace
+{
+// Selects the null types for single threaded builds, as user code would.
+template<bool SINGLE_THREADED>
+using BarrierType = std::conditional_t<SINGLE_THREADED, NullBarrier, SpinBarrier>;
+
+template<bool SINGLE_THREADED>
+using LatchType = std::conditional_t<SINGLE_THREADED, NullLatch, SpinLatch>;
+
+template<bool SINGLE_THREADED>
+void runSingleThreaded(void)
+{
+    auto barrier = BarrierType<SINGLE_THREADED>(1u, std::chrono::microseconds(10));
+    ASSERT_EQ(1u, barrier.count());
+    ASSERT_EQ(0u, barrier.phase());
+    ASSERT_TRUE(barrier.arrive_and_wait());
+    ASSERT_TRUE(barrier.arrive_and_wait());
+    ASSERT_EQ(2u, barrier.phase());
+
+    auto latch = LatchType<SINGLE_THREADED>(2u, std::chrono::microseconds(10));
+    latch.count_down();
+    latch.arrive_and_wait();
+    latch.wait();
+    ASSERT_TRUE(latch.try_wait());
+}
+} // namespace
+
 /**
  * @note: This tests are a success then there are no errors during compilation.
  *        There is not much to test because is only the interface.
@@ -66,3 +100,24 @@ TEST(NullMutexTest, operator_inequality)
 {
     ASSERT_EQ(NullObj() != NullObj(), false);
 }
+
+TEST(NullBarrierTest, use_as_barrier)
+{
+    auto barrier = NullBarrier();
+    ASSERT_TRUE(barrier.arrive_and_wait());
+}
+
+TEST(NullBarrierTest, use_through_alias)
+{
+    runSingleThreaded<true>();
+    runSingleThreaded<false>();
+}
+
+TEST(NullBarrierTest, use_as_latch)
+{
+    auto latch = NullLatch();
+    latch.count_down();
+    latch.arrive_and_wait(2);
+    latch.wait();
+    ASSERT_TRUE(latch.try_wait());
+}
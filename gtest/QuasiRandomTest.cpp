@@ -0,0 +1,226 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <set>
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <QuasiRandom.hpp>
+#include <RandomNumberGenerator.hpp>
+
+using simons_lib::quasi_random::SobolEngine;
+using simons_lib::quasi_random::HaltonEngine;
+using simons_lib::quasi_random::QuasiUniformRealDistribution;
+using simons_lib::random_number_generator::RandomNumberGenerator;
+
+namespace
+{
+// Engine always returning its largest value.
+struct LargestValueEngine
+{
+    using result_type = std::uint64_t;
+
+    static constexpr result_type min(void)
+    {
+        return 0;
+    }
+
+    static constexpr result_type max(void)
+    {
+        return UINT64_MAX;
+    }
+
+    result_type operator () (void)
+    {
+        return max();
+    }
+};
+
+// Scale a coordinate to [0, 1).
+double toUnit(std::uint32_t coordinate)
+{
+    return coordinate * 0x1.0p-32;
+}
+
+// Check that the first 2^m values of every dimension hit each interval of width 2^-m exactly once.
+template<typename E>
+bool isStratified(unsigned m)
+{
+    auto engine = E();
+    auto count = std::size_t(1) << m;
+    auto hits = std::vector<std::vector<int>>(E::DIMENSIONS, std::vector<int>(count, 0));
+    for (auto i = std::size_t(0); i < count; ++i)
+    {
+        for (auto d = std::size_t(0); d < E::DIMENSIONS; ++d)
+        {
+            hits[d][engine() >> (32u - m)] += 1;
+        }
+    }
+
+    for (auto const& dimension : hits)
+    {
+        for (auto hit : dimension)
+        {
+            if (hit != 1)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+} // namespace
+
+TEST(QuasiRandomTest, sobolFirstPoints)
+{
+    auto expected = std::vector<std::vector<double>>{{0.0,   0.0},   {0.5,   0.5},   {0.75,  0.25},  {0.25,  0.75},
+                                                     {0.375, 0.375}, {0.875, 0.875}, {0.625, 0.125}, {0.125, 0.625}};
+    auto engine = SobolEngine<2>();
+    for (auto const& point : expected)
+    {
+        ASSERT_EQ(point[0], toUnit(engine()));
+        ASSERT_EQ(point[1], toUnit(engine()));
+    }
+    ASSERT_EQ(8u, engine.index());
+}
+
+TEST(QuasiRandomTest, sobolStratified)
+{
+    ASSERT_TRUE(isStratified<SobolEngine<SobolEngine<1>::MAX_DIMENSIONS>>(12));
+}
+
+TEST(QuasiRandomTest, sobolSkipAhead)
+{
+    auto engine = SobolEngine<5>();
+    for (auto i = 0u; i < 5000u; ++i)
+    {
+        ASSERT_EQ(engine.point(), SobolEngine<5>(i).point());
+        engine.advance();
+    }
+
+    // Discard must behave like drawing the skipped coordinates
+    auto drawn = SobolEngine<5>();
+    auto skipped = SobolEngine<5>();
+    for (auto i = 0u; i < 1234u; ++i)
+    {
+        drawn();
+    }
+    skipped.discard(1234u);
+    ASSERT_EQ(drawn, skipped);
+    ASSERT_EQ(drawn(), skipped());
+
+    // Seed selects the starting point
+    skipped.seed(99u);
+    ASSERT_EQ(99u, skipped.index());
+    ASSERT_EQ(SobolEngine<5>(99u).point(), skipped.point());
+}
+
+TEST(QuasiRandomTest, haltonFirstPoints)
+{
+    auto base2 = std::vector<double>{0.0, 1.0 / 2, 1.0 / 4, 3.0 / 4, 1.0 / 8};
+    auto base3 = std::vector<double>{0.0, 1.0 / 3, 2.0 / 3, 1.0 / 9, 4.0 / 9};
+    auto engine = HaltonEngine<2>();
+    for (auto i = std::size_t(0); i < base2.size(); ++i)
+    {
+        ASSERT_NEAR(base2[i], toUnit(engine()), 1e-9);
+        ASSERT_NEAR(base3[i], toUnit(engine()), 1e-9);
+    }
+}
+
+TEST(QuasiRandomTest, haltonSkipAhead)
+{
+    auto engine = HaltonEngine<8>();
+    for (auto i = 0u; i < 5000u; ++i)
+    {
+        ASSERT_EQ(engine.point(), HaltonEngine<8>(i).point());
+        engine.advance();
+    }
+
+    auto drawn = HaltonEngine<8>();
+    auto skipped = HaltonEngine<8>();
+    for (auto i = 0u; i < 777u; ++i)
+    {
+        drawn();
+    }
+    skipped.discard(777u);
+    ASSERT_EQ(drawn, skipped);
+    ASSERT_EQ(drawn(), skipped());
+}
+
+TEST(QuasiRandomTest, integration)
+{
+    // Integrate f(x, y) = x * y over the unit square, exact result is 1/4
+    auto sobol = RandomNumberGenerator<SobolEngine<2>, QuasiUniformRealDistribution<double>>(0);
+    auto halton = RandomNumberGenerator<HaltonEngine<2>, QuasiUniformRealDistribution<double>>(0);
+    auto points = 4096;
+    auto sobolSum = 0.0;
+    auto haltonSum = 0.0;
+    for (auto i = 0; i < points; ++i)
+    {
+        auto sx = sobol();
+        auto sy = sobol();
+        sobolSum += sx * sy;
+
+        auto hx = halton();
+        auto hy = halton();
+        haltonSum += hx * hy;
+    }
+    ASSERT_NEAR(0.25, sobolSum / points, 1e-3);
+    ASSERT_NEAR(0.25, haltonSum / points, 1e-3);
+}
+
+TEST(QuasiRandomTest, uniformRealDistribution)
+{
+    auto engine = SobolEngine<1>();
+    auto distribution = QuasiUniformRealDistribution<float>(-2.0f, 2.0f);
+    for (auto i = 0; i < 10000; ++i)
+    {
+        auto val = distribution(engine);
+        ASSERT_TRUE(-2.0f <= val && val < 2.0f);
+    }
+
+    // Exactly one engine value is consumed per call
+    ASSERT_EQ(10000u, engine.index());
+
+    // Largest engine value must stay below the upper boundary
+    auto largest = LargestValueEngine();
+    ASSERT_LT(QuasiUniformRealDistribution<float>()(largest), 1.0f);
+    ASSERT_LT(QuasiUniformRealDistribution<double>()(largest), 1.0);
+}
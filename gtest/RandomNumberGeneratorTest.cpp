@@ -31,14 +31,23 @@
  */
 
 #include <gtest/gtest.h>
+#include <cstdint>
 #include <thread>
 #include <mutex>
+#include <set>
+#include <vector>
+#include <Distributions.hpp>
 #include <RandomNumberGenerator.hpp>
+#include <RandomNumberGenerator/ThreadLocalImpl.hpp>
+#include <SyncPolicy.hpp>
 
+using simons_lib::distributions::AliasDistribution;
 using simons_lib::random_number_generator::RandomNumberGenerator;
+using simons_lib::sync_policy::ThreadLocal;
 
 using RngI     = RandomNumberGenerator<std::default_random_engine, std::uniform_int_distribution<int>>;
 using RngFSync = RandomNumberGenerator<std::default_random_engine, std::uniform_real_distribution<float>, std::mutex>;
+using RngITls  = RandomNumberGenerator<std::mt19937_64, std::uniform_int_distribution<std::uint64_t>, ThreadLocal<std::mutex>>;
 
 TEST(RandomNumberGeneratorTest, setBoundries)
 {
@@ -67,6 +76,97 @@ TEST(RandomNumberGeneratorTest, setBoundriesInvalidInput)
     ASSERT_FALSE(rng.setBoundries(lBound, uBound));
 }
 
+TEST(RandomNumberGeneratorTest, perCallParameters)
+{
+    auto rng = RngI(0);
+    ASSERT_TRUE(rng.setBoundries(100, 200));
+
+    // Per call parameters must not touch the configured boundaries
+    auto param = RngI::ParamType(-5, 5);
+    for (auto i = 0; i < 10000; ++i)
+    {
+        auto val = rng(param);
+        ASSERT_TRUE(-5 <= val && val <= 5);
+    }
+
+    for (auto i = 0; i < 10000; ++i)
+    {
+        auto val = rng();
+        ASSERT_TRUE(100 <= val && val <= 200);
+    }
+}
+
+TEST(RandomNumberGeneratorTest, perCallParametersTableDistribution)
+{
+    using RngAlias = RandomNumberGenerator<std::mt19937, AliasDistribution<int>, std::mutex>;
+    auto rng = RngAlias(0, AliasDistribution<int>({1.0, 0.0, 0.0}));
+
+    // Table based parameters are used in place, the configured table stays
+    auto param = RngAlias::ParamType({0.0, 0.0, 1.0});
+    for (auto i = 0; i < 1000; ++i)
+    {
+        ASSERT_EQ(2, rng(param));
+        ASSERT_EQ(0, rng());
+    }
+}
+
+TEST(RandomNumberGeneratorTest, perCallParametersStatefulDistribution)
+{
+    // std::normal_distribution caches its second value, RNGs must not share it
+    using RngN = RandomNumberGenerator<std::mt19937, std::normal_distribution<double>>;
+    auto param = RngN::ParamType(0.0, 1.0);
+    auto a = RngN(1);
+    auto b = RngN(1);
+    for (auto i = 0; i < 100; ++i)
+    {
+        ASSERT_EQ(a(param), b(param));
+    }
+}
+
+TEST(RandomNumberGeneratorTest, engineAccess)
+{
+    auto rng = RngI(42);
+    auto engine = std::default_random_engine(42);
+
+    // The engine view must produce the raw engine sequence
+    auto view = rng.engine();
+    for (auto i = 0; i < 1000; ++i)
+    {
+        ASSERT_EQ(engine(), view());
+    }
+
+    // The view is usable with arbitrary distributions
+    auto distribution = std::uniform_int_distribution<long>(0, 9);
+    for (auto i = 0; i < 1000; ++i)
+    {
+        auto val = distribution(view);
+        ASSERT_TRUE(0 <= val && val <= 9);
+    }
+}
+
+TEST(RandomNumberGeneratorTest, perCallParametersSynchronized)
+{
+    auto rng = RngFSync(std::random_device()());
+
+    // Threads draw from disjoint ranges concurrently
+    auto threadfunc = [&rng] (float lower)
+    {
+        auto param = RngFSync::ParamType(lower, lower + 1.0f);
+        for (auto i = 0; i < 10000; ++i)
+        {
+            auto val = rng(param);
+            ASSERT_TRUE(lower <= val && val <= lower + 1.0f);
+        }
+    };
+
+    auto t1 = std::thread(threadfunc, 0.0f);
+    auto t2 = std::thread(threadfunc, 10.0f);
+    auto t3 = std::thread(threadfunc, 20.0f);
+    t1.join();
+    t2.join();
+    t3.join();
+}
+
 TEST(RandomNumberGeneratorTest, synchronized)
 {
     auto rng = RngFSync(std::random_device()());
@@ -91,3 +191,53 @@ TEST(RandomNumberGeneratorTest, synchronized)
     }
 
 }
+
+TEST(RandomNumberGeneratorTest, threadLocalSetBoundries)
+{
+    auto rng = RngITls(42);
+    ASSERT_TRUE(rng.setBoundries(10u, 20u));
+    for (auto i = 0; i < 1000; ++i)
+    {
+        auto val = rng();
+        ASSERT_TRUE(10u <= val && val <= 20u);
+    }
+
+    // Already seeded streams pick up changed boundaries
+    ASSERT_TRUE(rng.setBoundries(100u, 110u));
+    ASSERT_FALSE(rng.setBoundries(2u, 1u));
+    for (auto i = 0; i < 1000; ++i)
+    {
+        auto val = rng();
+        ASSERT_TRUE(100u <= val && val <= 110u);
+        auto perCall = rng(RngITls::ParamType(0u, 5u));
+        ASSERT_LE(perCall, 5u);
+    }
+}
+
+TEST(RandomNumberGeneratorTest, threadLocalStreams)
+{
+    constexpr auto THREADS = 4u;
+    auto rng = RngITls(42);
+
+    // Each thread draws from its own stream, streams differ from each other.
+    auto firsts = std::vector<std::uint64_t>(THREADS);
+    auto threads = std::vector<std::thread>();
+    for (auto i = 0u; i < THREADS; ++i)
+    {
+        threads.emplace_back([&rng, &firsts, i] ()
+        {
+            firsts[i] = rng();
+            auto engine = rng.engine();
+            for (auto n = 0; n < 10000; ++n)
+            {
+                engine();
+                rng();
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    ASSERT_EQ(THREADS, std::set<std::uint64_t>(firsts.begin(), firsts.end()).size());
+}
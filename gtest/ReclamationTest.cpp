@@ -0,0 +1,518 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <Reclamation.hpp>
+
+using simons_lib::reclamation::EpochDomain;
+using simons_lib::reclamation::HazardDomain;
+using simons_lib::reclamation::Rcu;
+
+namespace
+{
+// Object counting its live instances. Reading a freed object reveals a wrong value.
+struct Tracked
+{
+    static inline std::atomic<int> alive = {0};
+
+    explicit Tracked(std::uint64_t value)
+        : value(value)
+        , magic(MAGIC)
+    {
+        ++alive;
+    }
+
+    ~Tracked(void)
+    {
+        magic = 0u;
+        --alive;
+    }
+
+    static constexpr std::uint64_t MAGIC = 0x5AFE5AFE5AFE5AFEu;
+
+    std::uint64_t value;
+    std::uint64_t magic;
+};
+
+// Treiber stack of Tracked objects, popped nodes are retired into a domain.
+struct Node
+{
+    Tracked item;
+    Node*   next;
+};
+
+struct Stack
+{
+    std::atomic<Node*> head = {nullptr};
+
+    void push(std::uint64_t value)
+    {
+        auto node = new Node{Tracked(value), head.load()};
+        while (!head.compare_exchange_weak(node->next, node))
+        {
+        }
+    }
+};
+
+// Concurrent push and pop with domain specific popping. Checks that no popped node is freed while in use.
+template<typename Pop>
+void checkConcurrentStack(Stack& stack, Pop&& pop)
+{
+    constexpr auto THREADS = 4;
+    constexpr auto OPS = 20000;
+
+    auto corrupted = std::atomic<int>(0);
+    auto threads = std::vector<std::thread>();
+    for (auto t = 0; t < THREADS; ++t)
+    {
+        threads.emplace_back([&stack, &pop, &corrupted, t] ()
+        {
+            for (auto i = 0; i < OPS; ++i)
+            {
+                stack.push(static_cast<std::uint64_t>(t * OPS + i));
+                if (!pop(corrupted))
+                {
+                    ++corrupted;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    ASSERT_EQ(0, corrupted.load());
+    ASSERT_EQ(nullptr, stack.head.load());
+}
+} // namespace
+
+TEST(EpochDomainTest, retireFreesAfterGracePeriod)
+{
+    auto domain = EpochDomain(1u);
+    {
+        auto guard = domain.pin();
+        domain.retire(new Tracked(1u));
+
+        // Pinned reader might still hold a reference
+        ASSERT_EQ(1, Tracked::alive.load());
+    }
+
+    domain.synchronize();
+    ASSERT_EQ(0, Tracked::alive.load());
+    ASSERT_EQ(0u, domain.pending());
+}
+
+TEST(EpochDomainTest, reclaimWithoutFullBatch)
+{
+    auto domain = EpochDomain();
+    domain.retire(new Tracked(1u));
+    ASSERT_EQ(1u, domain.pending());
+
+    // Pinned reader might still hold a reference
+    {
+        auto guard = domain.pin();
+        domain.reclaim();
+        ASSERT_EQ(1, Tracked::alive.load());
+    }
+
+    domain.reclaim();
+    ASSERT_EQ(0, Tracked::alive.load());
+    ASSERT_EQ(0u, domain.pending());
+}
+
+TEST(EpochDomainTest, readerOnOtherThreadBlocksReclamation)
+{
+    auto domain = EpochDomain(1u);
+    auto pinned = std::atomic<bool>(false);
+    auto release = std::atomic<bool>(false);
+    auto reader = std::thread([&] ()
+    {
+        auto guard = domain.pin();
+        pinned = true;
+        while (!release)
+        {
+            std::this_thread::yield();
+        }
+    });
+    while (!pinned)
+    {
+        std::this_thread::yield();
+    }
+
+    auto epoch = domain.epoch();
+    for (auto i = 0; i < 10; ++i)
+    {
+        domain.retire(new Tracked(1u));
+    }
+
+    // Epoch can advance at most once past the pinned reader
+    ASSERT_LE(domain.epoch(), epoch + 1u);
+    ASSERT_EQ(10, Tracked::alive.load());
+
+    release = true;
+    reader.join();
+    domain.synchronize();
+    ASSERT_EQ(0, Tracked::alive.load());
+}
+
+TEST(EpochDomainTest, synchronizeFreesObjectsOfLiveThreads)
+{
+    auto domain = EpochDomain(64u);
+    auto retired = std::atomic<bool>(false);
+    auto release = std::atomic<bool>(false);
+    auto retirer = std::thread([&] ()
+    {
+        domain.retire(new Tracked(1u));
+        domain.retire(new Tracked(2u));
+        retired = true;
+        while (!release)
+        {
+            std::this_thread::yield();
+        }
+    });
+    while (!retired)
+    {
+        std::this_thread::yield();
+    }
+
+    // Retiring thread is still alive, its objects are freed by this thread
+    domain.synchronize();
+    ASSERT_EQ(0, Tracked::alive.load());
+
+    release = true;
+    retirer.join();
+}
+
+TEST(EpochDomainTest, nestedGuards)
+{
+    auto domain = EpochDomain(1u);
+    auto outer = domain.pin();
+    {
+        auto inner = domain.pin();
+    }
+    domain.retire(new Tracked(1u));
+    auto epoch = domain.epoch();
+    std::thread([&domain] () { domain.retire(new Tracked(2u)); domain.retire(new Tracked(3u)); }).join();
+
+    // Outer guard is still active
+    ASSERT_LE(domain.epoch(), epoch + 1u);
+    ASSERT_EQ(3, Tracked::alive.load());
+}
+
+TEST(EpochDomainTest, destructorFreesPending)
+{
+    {
+        auto domain = EpochDomain();
+        domain.retire(new Tracked(1u));
+        std::thread([&domain] () { domain.retire(new Tracked(2u)); }).join();
+        ASSERT_EQ(2, Tracked::alive.load());
+    }
+    ASSERT_EQ(0, Tracked::alive.load());
+}
+
+TEST(EpochDomainTest, concurrentStack)
+{
+    auto domain = EpochDomain(32u);
+    auto stack = Stack();
+    checkConcurrentStack(stack, [&domain, &stack] (std::atomic<int>&)
+    {
+        auto guard = domain.pin();
+        auto node = stack.head.load();
+        while (node && !stack.head.compare_exchange_weak(node, node->next))
+        {
+        }
+        if (!node)
+        {
+            return true;
+        }
+
+        auto valid = (node->item.magic == Tracked::MAGIC);
+        domain.retire(node);
+        return valid;
+    });
+
+    domain.synchronize();
+    ASSERT_EQ(0, Tracked::alive.load());
+}
+
+TEST(HazardDomainTest, mixedWithEpochDomainsOnOneThread)
+{
+    // All domain types share the per-thread record cache. Enough domains of
+    // both types that some pair would have gotten the same id if ids were
+    // counted per type.
+    constexpr auto DOMAINS = 64;
+
+    auto epochs = std::vector<std::unique_ptr<EpochDomain>>();
+    auto hazards = std::vector<std::unique_ptr<HazardDomain>>();
+    for (auto i = 0; i < DOMAINS; ++i)
+    {
+        epochs.push_back(std::make_unique<EpochDomain>());
+        hazards.push_back(std::make_unique<HazardDomain>());
+    }
+
+    for (auto& hazard : hazards)
+    {
+        for (auto& epoch : epochs)
+        {
+            auto guard = epoch->pin();
+            hazard->retire(new Tracked(0u));
+            ASSERT_EQ(0u, epoch->pending());
+            ASSERT_EQ(1u, hazard->pending());
+            hazard->reclaim();
+            ASSERT_EQ(0u, hazard->pending());
+        }
+    }
+}
+
+TEST(HazardDomainTest, protectedObjectSurvivesScan)
+{
+    auto domain = HazardDomain(1u);
+    auto shared = std::atomic<Tracked*>(new Tracked(7u));
+    {
+        auto hazard = domain.makeHazardPointer();
+        auto ptr = hazard.protect(shared);
+        shared.store(nullptr);
+        domain.retire(ptr);
+
+        // Still protected
+        domain.reclaim();
+        ASSERT_EQ(1, Tracked::alive.load());
+        ASSERT_EQ(7u, ptr->value);
+
+        hazard.reset();
+        domain.reclaim();
+        ASSERT_EQ(0, Tracked::alive.load());
+    }
+}
+
+TEST(HazardDomainTest, boundedGarbage)
+{
+    auto domain = HazardDomain(8u);
+    for (auto i = 0u; i < 100u; ++i)
+    {
+        domain.retire(new Tracked(i));
+        ASSERT_LT(domain.pending(), 8u);
+    }
+    domain.reclaim();
+    ASSERT_EQ(0, Tracked::alive.load());
+}
+
+TEST(HazardDomainTest, exitedThreadsGarbageIsReclaimed)
+{
+    auto domain = HazardDomain();
+    std::thread([&domain] () { domain.retire(new Tracked(1u)); }).join();
+    ASSERT_EQ(1, Tracked::alive.load());
+    domain.reclaim();
+    ASSERT_EQ(0, Tracked::alive.load());
+}
+
+TEST(HazardDomainTest, concurrentStack)
+{
+    auto domain = HazardDomain(32u);
+    auto stack = Stack();
+    checkConcurrentStack(stack, [&domain, &stack] (std::atomic<int>&)
+    {
+        auto hazard = domain.makeHazardPointer();
+        Node* node = nullptr;
+        while (true)
+        {
+            node = hazard.protect(stack.head);
+            if (!node || stack.head.compare_exchange_weak(node, node->next))
+            {
+                break;
+            }
+        }
+        if (!node)
+        {
+            return true;
+        }
+
+        auto valid = (node->item.magic == Tracked::MAGIC);
+        hazard.reset();
+        domain.retire(node);
+        return valid;
+    });
+
+    domain.reclaim();
+    ASSERT_EQ(0, Tracked::alive.load());
+}
+
+TEST(RcuTest, readAndUpdate)
+{
+    auto domain = EpochDomain();
+    {
+        auto config = Rcu<Tracked>(std::make_unique<Tracked>(1u), domain);
+        ASSERT_EQ(1u, config.read()->value);
+
+        {
+            // Old snapshot stays valid after an update
+            auto old = config.read();
+            config.update(std::make_unique<Tracked>(2u));
+            ASSERT_EQ(1u, old->value);
+            ASSERT_EQ(2u, config.read()->value);
+            ASSERT_EQ(2, Tracked::alive.load());
+        }
+
+        config.synchronize();
+        ASSERT_EQ(1, Tracked::alive.load());
+    }
+    domain.synchronize();
+    ASSERT_EQ(0, Tracked::alive.load());
+}
+
+TEST(RcuTest, updateFreesUnreadVersions)
+{
+    auto domain = EpochDomain();
+    {
+        auto config = Rcu<Tracked>(std::make_unique<Tracked>(0u), domain);
+        for (auto version = 1u; version <= 10u; ++version)
+        {
+            // Replaced versions do not wait for a full retire batch
+            config.update(std::make_unique<Tracked>(version));
+            ASSERT_EQ(1, Tracked::alive.load());
+        }
+    }
+    domain.synchronize();
+    ASSERT_EQ(0, Tracked::alive.load());
+}
+
+TEST(RcuTest, synchronizeFreesVersionsReplacedOnOtherThreads)
+{
+    auto domain = EpochDomain(64u);
+    {
+        auto config = Rcu<Tracked>(std::make_unique<Tracked>(0u), domain);
+        auto updated = std::atomic<bool>(false);
+        auto release = std::atomic<bool>(false);
+        auto writer = std::thread();
+        {
+            // Snapshot held by this thread keeps the replaced version alive
+            auto snapshot = config.read();
+            writer = std::thread([&] ()
+            {
+                config.update(std::make_unique<Tracked>(1u));
+                updated = true;
+                while (!release)
+                {
+                    std::this_thread::yield();
+                }
+            });
+            while (!updated)
+            {
+                std::this_thread::yield();
+            }
+            ASSERT_EQ(0u, snapshot->value);
+            ASSERT_EQ(2, Tracked::alive.load());
+        }
+
+        // Writer is still alive, its replaced version is deleted by this thread
+        config.synchronize();
+        ASSERT_EQ(1, Tracked::alive.load());
+
+        release = true;
+        writer.join();
+    }
+    domain.synchronize();
+    ASSERT_EQ(0, Tracked::alive.load());
+}
+
+TEST(RcuTest, modify)
+{
+    struct Config
+    {
+        int threshold;
+        double rate;
+    };
+
+    auto config = Rcu<Config, std::mutex>(std::make_unique<Config>(Config{10, 0.5}));
+    config.modify([] (Config& next)
+    {
+        next.threshold = 20;
+    });
+
+    auto snapshot = config.read();
+    ASSERT_EQ(20, snapshot->threshold);
+    ASSERT_EQ(0.5, (*snapshot).rate);
+}
+
+TEST(RcuTest, concurrentReaders)
+{
+    constexpr auto READERS = 3;
+    constexpr auto UPDATES = 2000u;
+
+    auto domain = EpochDomain(16u);
+    {
+        auto config = Rcu<Tracked>(std::make_unique<Tracked>(0u), domain);
+        auto done = std::atomic<bool>(false);
+        auto corrupted = std::atomic<int>(0);
+
+        auto readers = std::vector<std::thread>();
+        for (auto i = 0; i < READERS; ++i)
+        {
+            readers.emplace_back([&] ()
+            {
+                auto last = std::uint64_t(0);
+                while (!done)
+                {
+                    auto snapshot = config.read();
+
+                    // Versions are valid and never go back in time
+                    if ((snapshot->magic != Tracked::MAGIC) || (snapshot->value < last))
+                    {
+                        ++corrupted;
+                    }
+                    last = snapshot->value;
+                }
+            });
+        }
+
+        for (auto i = 1u; i <= UPDATES; ++i)
+        {
+            config.update(std::make_unique<Tracked>(i));
+        }
+        done = true;
+        for (auto& reader : readers)
+        {
+            reader.join();
+        }
+
+        ASSERT_EQ(0, corrupted.load());
+        ASSERT_EQ(UPDATES, config.read()->value);
+    }
+    domain.synchronize();
+    ASSERT_EQ(0, Tracked::alive.load());
+}
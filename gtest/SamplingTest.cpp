@@ -0,0 +1,357 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <set>
+#include <vector>
+#include <Sampling.hpp>
+
+using simons_lib::sampling::shuffle;
+using simons_lib::sampling::parallelShuffle;
+using simons_lib::sampling::floydSample;
+using simons_lib::sampling::ReservoirSampler;
+using simons_lib::sampling::WeightedReservoirSampler;
+
+namespace
+{
+// Engine counting how often it was called.
+struct CountingEngine
+{
+    using result_type = std::mt19937_64::result_type;
+
+    static constexpr result_type min(void)
+    {
+        return std::mt19937_64::min();
+    }
+
+    static constexpr result_type max(void)
+    {
+        return std::mt19937_64::max();
+    }
+
+    result_type operator () (void)
+    {
+        ++*calls;
+        return engine();
+    }
+
+    std::mt19937_64 engine;
+    std::uint64_t*  calls;
+};
+
+// Chi-square statistic of a n x n table counting element e at position p.
+double positionChiSquare(std::vector<std::vector<int>> const& counts, int trials)
+{
+    auto n = counts.size();
+    auto expected = static_cast<double>(trials) / static_cast<double>(n);
+    auto result = 0.0;
+    for (auto const& row : counts)
+    {
+        for (auto count : row)
+        {
+            result += (count - expected) * (count - expected) / expected;
+        }
+    }
+    return result;
+}
+}
+
+TEST(ShuffleTest, isPermutation)
+{
+    auto engine = std::mt19937_64(0);
+    auto values = std::vector<int>(1000);
+    std::iota(values.begin(), values.end(), 0);
+
+    shuffle(values.begin(), values.end(), engine);
+
+    ASSERT_FALSE(std::is_sorted(values.begin(), values.end()));
+    std::sort(values.begin(), values.end());
+    for (auto i = 0; i < 1000; ++i)
+    {
+        ASSERT_EQ(i, values[static_cast<std::size_t>(i)]);
+    }
+}
+
+TEST(ShuffleTest, isUniform)
+{
+    auto engine = std::mt19937(1);
+    auto trials = 60000;
+    auto counts = std::vector<std::vector<int>>(5, std::vector<int>(5));
+
+    for (auto trial = 0; trial < trials; ++trial)
+    {
+        auto values = std::array<std::size_t, 5>{0, 1, 2, 3, 4};
+        shuffle(values.begin(), values.end(), engine);
+        for (auto pos = std::size_t(0); pos < values.size(); ++pos)
+        {
+            ++counts[values[pos]][pos];
+        }
+    }
+    // Chi-square test with 16 degrees of freedom, p = 0.001
+    ASSERT_LT(positionChiSquare(counts, trials), 39.25);
+}
+
+TEST(ParallelShuffleTest, mergeIsUniform)
+{
+    using simons_lib::sampling::detail::mergeShuffled;
+
+    auto engine = std::mt19937_64(2);
+    auto trials = 60000;
+    auto counts = std::vector<std::vector<int>>(7, std::vector<int>(7));
+
+    for (auto trial = 0; trial < trials; ++trial)
+    {
+        auto values = std::array<std::size_t, 7>{0, 1, 2, 3, 4, 5, 6};
+        shuffle(values.begin(), values.begin() + 3, engine);
+        shuffle(values.begin() + 3, values.end(), engine);
+        mergeShuffled(values.begin(), values.begin() + 3, values.end(), engine);
+        for (auto pos = std::size_t(0); pos < values.size(); ++pos)
+        {
+            ++counts[values[pos]][pos];
+        }
+    }
+    // Chi-square test with 36 degrees of freedom, p = 0.001
+    ASSERT_LT(positionChiSquare(counts, trials), 67.99);
+}
+
+TEST(ParallelShuffleTest, isPermutationAndReproducible)
+{
+    auto reference = std::vector<std::uint32_t>(1000003);
+    std::iota(reference.begin(), reference.end(), 0u);
+
+    auto single = reference;
+    auto multi = reference;
+    parallelShuffle(single.begin(), single.end(), 42u, 1);
+    parallelShuffle(multi.begin(), multi.end(), 42u, 4);
+
+    ASSERT_EQ(single, multi);
+    ASSERT_NE(reference, multi);
+
+    auto other = reference;
+    parallelShuffle(other.begin(), other.end(), 43u, 4);
+    ASSERT_NE(other, multi);
+
+    std::sort(multi.begin(), multi.end());
+    ASSERT_EQ(reference, multi);
+}
+
+TEST(FloydSampleTest, distinctAndInRange)
+{
+    auto engine = std::mt19937_64(3);
+    auto sample = floydSample(1000000000000u, 10000u, engine);
+    auto unique = std::set<std::uint64_t>(sample.begin(), sample.end());
+
+    ASSERT_EQ(10000u, sample.size());
+    ASSERT_EQ(10000u, unique.size());
+    for (auto val : sample)
+    {
+        ASSERT_LT(val, 1000000000000u);
+    }
+}
+
+TEST(FloydSampleTest, clampsToPopulation)
+{
+    auto engine = std::mt19937_64(4);
+    auto sample = floydSample(10u, 20u, engine);
+
+    std::sort(sample.begin(), sample.end());
+    ASSERT_EQ((std::vector<std::uint64_t>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}), sample);
+    ASSERT_TRUE(floydSample(10u, 0u, engine).empty());
+}
+
+TEST(FloydSampleTest, isUniform)
+{
+    auto engine = std::mt19937_64(5);
+    auto trials = 100000;
+    auto counts = std::array<int, 10>();
+
+    for (auto trial = 0; trial < trials; ++trial)
+    {
+        for (auto val : floydSample(10u, 3u, engine))
+        {
+            ++counts.at(val);
+        }
+    }
+
+    // Chi-square test with 9 degrees of freedom, p = 0.001
+    auto expected = trials * 3.0 / 10.0;
+    auto chiSquare = 0.0;
+    for (auto count : counts)
+    {
+        chiSquare += (count - expected) * (count - expected) / expected;
+    }
+    ASSERT_LT(chiSquare, 27.88);
+}
+
+TEST(ReservoirSamplerTest, fillsAndKeepsCapacity)
+{
+    auto sampler = ReservoirSampler<int, std::mt19937>(10, std::mt19937(0));
+    for (auto i = 0; i < 5; ++i)
+    {
+        sampler.push(i);
+    }
+    ASSERT_EQ(5u, sampler.samples().size());
+
+    auto values = std::vector<int>(10000);
+    std::iota(values.begin(), values.end(), 5);
+    sampler.push(values.begin(), values.end());
+
+    auto samples = std::set<int>(sampler.samples().begin(), sampler.samples().end());
+    ASSERT_EQ(10u, samples.size());
+    ASSERT_EQ(10005u, sampler.seen());
+    for (auto sample : samples)
+    {
+        ASSERT_TRUE(0 <= sample && sample < 10005);
+    }
+
+    sampler.reset();
+    ASSERT_TRUE(sampler.samples().empty());
+    ASSERT_EQ(0u, sampler.seen());
+}
+
+TEST(ReservoirSamplerTest, isUniform)
+{
+    auto engine = std::mt19937_64(3);
+    auto trials = 20000;
+    auto counts = std::vector<int>(100);
+    for (auto trial = 0; trial < trials; ++trial)
+    {
+        auto sampler = ReservoirSampler<int, std::mt19937_64>(10, std::mt19937_64(engine()));
+        for (auto i = 0; i < 100; ++i)
+        {
+            sampler.push(i);
+        }
+        for (auto sample : sampler.samples())
+        {
+            ++counts[static_cast<std::size_t>(sample)];
+        }
+    }
+
+    // Chi-square test with 99 degrees of freedom, p = 0.001
+    auto expected = trials * 10.0 / 100.0;
+    auto result = 0.0;
+    for (auto count : counts)
+    {
+        result += (count - expected) * (count - expected) / expected;
+    }
+    ASSERT_LT(result, 148.23);
+}
+
+TEST(ReservoirSamplerTest, engineCallsAreLogarithmic)
+{
+    auto calls = std::uint64_t(0);
+    auto sampler = ReservoirSampler<std::uint64_t, CountingEngine>(100, CountingEngine{std::mt19937_64(4), &calls});
+    for (auto i = std::uint64_t(0); i < 1000000u; ++i)
+    {
+        sampler.push(i);
+    }
+
+    // About 3 draws per replacement and k * ln(n / k) ~ 921 replacements
+    ASSERT_LT(calls, 6000u);
+}
+
+TEST(WeightedReservoirSamplerTest, matchesWeights)
+{
+    auto engine = std::mt19937_64(5);
+    auto trials = 50000;
+    auto counts = std::vector<int>(10);
+    for (auto trial = 0; trial < trials; ++trial)
+    {
+        auto sampler = WeightedReservoirSampler<int, std::mt19937_64>(1, std::mt19937_64(engine()));
+        for (auto i = 0; i < 10; ++i)
+        {
+            ASSERT_TRUE(sampler.push(i, i + 1.0));
+        }
+        ++counts[static_cast<std::size_t>(sampler.samples().front())];
+    }
+
+    // Chi-square test with 9 degrees of freedom, p = 0.001
+    auto result = 0.0;
+    for (auto i = std::size_t(0); i < counts.size(); ++i)
+    {
+        auto expected = trials * (static_cast<double>(i) + 1.0) / 55.0;
+        result += (counts[i] - expected) * (counts[i] - expected) / expected;
+    }
+    ASSERT_LT(result, 27.88);
+}
+
+TEST(WeightedReservoirSamplerTest, prefersHeavyItems)
+{
+    auto calls = std::uint64_t(0);
+    auto sampler = WeightedReservoirSampler<std::uint64_t, CountingEngine>(8, CountingEngine{std::mt19937_64(6), &calls});
+    for (auto i = std::uint64_t(0); i < 1000000u; ++i)
+    {
+        // Every 1000th item is a million times heavier than all others
+        ASSERT_TRUE(sampler.push(i, (i % 1000u == 0) ? 1e6 : 1.0));
+    }
+
+    auto samples = std::set<std::uint64_t>(sampler.samples().begin(), sampler.samples().end());
+    ASSERT_EQ(8u, samples.size());
+    for (auto sample : samples)
+    {
+        ASSERT_EQ(0u, sample % 1000u);
+    }
+    ASSERT_LT(calls, 2000u);
+}
+
+TEST(WeightedReservoirSamplerTest, invalidWeight)
+{
+    auto sampler = WeightedReservoirSampler<int, std::mt19937>(4, std::mt19937(7));
+    ASSERT_FALSE(sampler.push(1, 0.0));
+    ASSERT_FALSE(sampler.push(2, -1.0));
+    ASSERT_FALSE(sampler.push(3, std::numeric_limits<double>::infinity()));
+    ASSERT_FALSE(sampler.push(4, std::numeric_limits<double>::quiet_NaN()));
+    ASSERT_TRUE(sampler.samples().empty());
+    ASSERT_EQ(0u, sampler.seen());
+
+    ASSERT_TRUE(sampler.push(5, 0.5));
+    ASSERT_EQ(1u, sampler.samples().size());
+}
+
+TEST(ReservoirSamplerTest, zeroCapacity)
+{
+    auto sampler = ReservoirSampler<int, std::mt19937>(0, std::mt19937(8));
+    auto weighted = WeightedReservoirSampler<int, std::mt19937>(0, std::mt19937(8));
+    for (auto i = 0; i < 100; ++i)
+    {
+        sampler.push(i);
+        ASSERT_TRUE(weighted.push(i, 1.0));
+    }
+    ASSERT_TRUE(sampler.samples().empty());
+    ASSERT_TRUE(weighted.samples().empty());
+}
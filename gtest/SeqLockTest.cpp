@@ -0,0 +1,156 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <Mutex.hpp>
+#include <SeqLock.hpp>
+
+using simons_lib::seq_lock::SeqLock;
+using simons_lib::mutex::SpinLock;
+
+namespace
+{
+// Value spanning several machine words. All fields are equal in every published state.
+struct Rates
+{
+    std::uint64_t a;
+    std::uint64_t b;
+    std::uint64_t c;
+    std::uint32_t d;
+};
+
+// Readers must never observe a partially written value.
+template<typename M>
+void checkConsistentSnapshots(void)
+{
+    constexpr auto READERS = 3;
+    constexpr auto WRITERS = 2;
+    constexpr auto WRITES = 5000u;
+
+    auto lock = SeqLock<Rates, M>(Rates{0u, 0u, 0u, 0u});
+    auto torn = std::atomic<int>(0);
+    auto done = std::atomic<bool>(false);
+
+    auto threads = std::vector<std::thread>();
+    for (auto i = 0; i < READERS; ++i)
+    {
+        threads.emplace_back([&] ()
+        {
+            while (!done)
+            {
+                auto rates = lock.load();
+                if ((rates.a != rates.b) || (rates.b != rates.c) || (rates.c != rates.d))
+                {
+                    ++torn;
+                }
+            }
+        });
+    }
+
+    auto writers = std::vector<std::thread>();
+    for (auto i = 0; i < WRITERS; ++i)
+    {
+        writers.emplace_back([&lock] ()
+        {
+            for (auto n = 0u; n < WRITES; ++n)
+            {
+                lock.update([] (Rates& rates)
+                {
+                    rates = Rates{rates.a + 1u, rates.b + 1u, rates.c + 1u, rates.d + 1u};
+                });
+            }
+        });
+    }
+
+    for (auto& writer : writers)
+    {
+        writer.join();
+    }
+    done = true;
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(0, torn.load());
+    ASSERT_EQ(WRITERS * WRITES, lock.load().d);
+}
+} // namespace
+
+TEST(SeqLockTest, loadAndStore)
+{
+    auto lock = SeqLock<double>(0.5);
+    ASSERT_EQ(0.5, lock.load());
+
+    lock.store(1.5);
+    ASSERT_EQ(1.5, lock.load());
+
+    auto value = 0.0;
+    ASSERT_TRUE(lock.tryLoad(value));
+    ASSERT_EQ(1.5, value);
+}
+
+TEST(SeqLockTest, defaultConstructed)
+{
+    auto lock = SeqLock<int>();
+    ASSERT_EQ(0, lock.load());
+}
+
+TEST(SeqLockTest, update)
+{
+    auto lock = SeqLock<Rates>(Rates{1u, 2u, 3u, 4u});
+    lock.update([] (Rates& rates)
+    {
+        rates.d = 42u;
+    });
+
+    auto rates = lock.load();
+    ASSERT_EQ(1u, rates.a);
+    ASSERT_EQ(2u, rates.b);
+    ASSERT_EQ(3u, rates.c);
+    ASSERT_EQ(42u, rates.d);
+}
+
+TEST(SeqLockTest, consistentSnapshotsStdMutex)
+{
+    checkConsistentSnapshots<std::mutex>();
+}
+
+TEST(SeqLockTest, consistentSnapshotsSpinLock)
+{
+    checkConsistentSnapshots<SpinLock>();
+}
@@ -0,0 +1,70 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+#include <mutex>
+#include <type_traits>
+#include <Mutex.hpp>
+#include <NullTypes.hpp>
+#include <SyncPolicy.hpp>
+
+using simons_lib::mutex::SpinLock;
+using simons_lib::null_types::NullMutex;
+using namespace simons_lib::sync_policy;
+
+TEST(SyncPolicyTest, isSyncPolicy)
+{
+    static_assert(IsSyncPolicy<SingleThreaded>::value);
+    static_assert(IsSyncPolicy<MutexPolicy<std::mutex>>::value);
+    static_assert(IsSyncPolicy<Atomic>::value);
+    static_assert(IsSyncPolicy<ThreadLocal<std::mutex>>::value);
+    static_assert(!IsSyncPolicy<NullMutex>::value);
+    static_assert(!IsSyncPolicy<std::mutex>::value);
+    static_assert(!IsSyncPolicy<int>::value);
+}
+
+TEST(SyncPolicyTest, mutexTypesMapOntoPolicies)
+{
+    // Policies map onto themselves
+    static_assert(std::is_same_v<Atomic, PolicyOf<Atomic>::type>);
+    static_assert(std::is_same_v<ThreadLocal<SpinLock>, PolicyOf<ThreadLocal<SpinLock>>::type>);
+    static_assert(std::is_same_v<SpinLock, ThreadLocal<SpinLock>::MutexType>);
+    static_assert(std::is_same_v<MutexPolicy<SpinLock>, PolicyOf<MutexPolicy<SpinLock>>::type>);
+
+    // Raw mutex types are aliases for the mutex policies
+    static_assert(std::is_same_v<SingleThreaded, PolicyOf<NullMutex>::type>);
+    static_assert(std::is_same_v<MutexPolicy<std::mutex>, PolicyOf<std::mutex>::type>);
+    static_assert(std::is_same_v<MutexPolicy<SpinLock>, PolicyOf<SpinLock>::type>);
+
+    static_assert(SyncKind::SINGLE_THREADED == PolicyOf<NullMutex>::type::KIND);
+    static_assert(SyncKind::MUTEX == PolicyOf<std::mutex>::type::KIND);
+    static_assert(std::is_same_v<std::mutex, PolicyOf<std::mutex>::type::MutexType>);
+}
@@ -0,0 +1,106 @@
+/**
+ * @file      Detail.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Internal details of Barrier. Not intended for direct usage.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @cond DO_NOT_DOCUMENT
+ * @note Documentation for this file is suppressed to avoid
+ *       polluting the generated documentation with internal details.
+ */
+
+#ifndef DETAIL_HPP_20190803083112
+#define DETAIL_HPP_20190803083112
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include "../Mutex/Detail.hpp"
+
+namespace simons_lib::barrier::detail
+{
+
+// Spinning only pays off if the thread we wait for runs on another CPU.
+inline std::chrono::nanoseconds effectiveSpin(std::chrono::nanoseconds spin) noexcept
+{
+    static auto const multiCore = (std::thread::hardware_concurrency() > 1u);
+    return multiCore ? spin : std::chrono::nanoseconds(0);
+}
+
+// Spin until done() returns true or spin elapsed. The clock is read every
+// CHECK_INTERVAL iterations only, since a read costs more than a pause.
+// Returns the final result of done().
+template<typename F>
+bool spinUntil(F const& done, std::chrono::nanoseconds spin) noexcept
+{
+    constexpr auto CHECK_INTERVAL = std::uint32_t(64);
+
+    if (done())
+    {
+        return true;
+    }
+    if (spin.count() <= 0)
+    {
+        return false;
+    }
+
+    auto const deadline = std::chrono::steady_clock::now() + spin;
+    while (true)
+    {
+        for (auto i = std::uint32_t(0); i < CHECK_INTERVAL; ++i)
+        {
+            mutex::detail::cpuRelax();
+            if (done())
+            {
+                return true;
+            }
+        }
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            return done();
+        }
+    }
+}
+
+} // namespace simons_lib::barrier::detail
+
+#endif // DETAIL_HPP_20190803083112
+
+/**
+ * @endcond DO_NOT_DOCUMENT
+ */
@@ -0,0 +1,160 @@
+/**
+ * @file      SpinBarrierImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Phase counting barrier spinning before it parks on a futex.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SPIN_BARRIER_IMPL_HPP_20190803083112
+#define SPIN_BARRIER_IMPL_HPP_20190803083112
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include "../Defines.hpp"
+#include "../Mutex/Detail.hpp"
+#include "Detail.hpp"
+
+namespace simons_lib::barrier
+{
+
+/**
+ * @brief Reusable barrier for a fixed number of threads, spinning before it sleeps.
+ * @note The last arriving thread advances the phase counter, waiting threads
+ *       spin on it for a configurable time and then sleep on it as futex
+ *       word. The lowest bit of the word marks sleeping waiters, so the single
+ *       exchange advancing the phase decides whether to wake them and short
+ *       phases never enter the kernel. The barrier is not touched after that
+ *       exchange. Without futex support waiting threads yield.
+ *       Use NullBarrier as drop-in replacement in single threaded builds.
+ */
+class SpinBarrier
+{
+public:
+    /// @brief Default time to spin before sleeping.
+    static constexpr auto DEFAULT_SPIN = std::chrono::nanoseconds(std::chrono::microseconds(50));
+
+    /**
+     * @brief Constructor.
+     * @param[in] count   Number of threads synchronizing on this barrier. Must be > 0.
+     * @param[in] spin    Time to spin before sleeping. Ignored on single core systems.
+     */
+    explicit SpinBarrier(std::uint32_t count, std::chrono::nanoseconds spin = DEFAULT_SPIN) noexcept
+        : m_state(0)
+        , m_count(count)
+        , m_spin(detail::effectiveSpin(spin))
+        , m_arrived(0)
+    {
+    }
+
+    // Copying and moving is forbidden
+    SpinBarrier(SpinBarrier const&) = delete;
+    SpinBarrier(SpinBarrier&&) = delete;
+    SpinBarrier& operator = (SpinBarrier const&) = delete;
+    SpinBarrier& operator = (SpinBarrier&&) = delete;
+
+    /**
+     * @brief Arrive at the barrier and wait until all threads arrived.
+     * @returns true for exactly one thread per phase (the last to arrive), false for all others.
+     */
+    bool arrive_and_wait(void) noexcept
+    {
+        auto const phase = m_state.load(std::memory_order_acquire) >> 1u;
+        if (m_arrived.fetch_add(1, std::memory_order_acq_rel) + 1u == m_count)
+        {
+            // Reset before advancing, threads re-arrive only after observing it.
+            m_arrived.store(0, std::memory_order_relaxed);
+            auto const previous = m_state.exchange((phase + 1u) << 1u, std::memory_order_acq_rel);
+            if ((previous & SLEEPING) != 0u)
+            {
+                // Only the address is passed on, the barrier may already be destroyed.
+                mutex::detail::futexWake(m_state, INT_MAX);
+            }
+            return true;
+        }
+
+        auto const advanced = [this, phase] ()
+        {
+            return (m_state.load(std::memory_order_acquire) >> 1u) != phase;
+        };
+        if (!detail::spinUntil(advanced, m_spin))
+        {
+            auto state = m_state.load(std::memory_order_acquire);
+            while ((state >> 1u) == phase)
+            {
+                if (((state & SLEEPING) != 0u) ||
+                    m_state.compare_exchange_weak(state, state | SLEEPING, std::memory_order_acquire))
+                {
+                    mutex::detail::futexWait(m_state, state | SLEEPING);
+                    state = m_state.load(std::memory_order_acquire);
+                }
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Number of threads synchronizing on this barrier.
+     * @returns Number of threads.
+     */
+    std::uint32_t count(void) const noexcept
+    {
+        return m_count;
+    }
+
+    /**
+     * @brief Number of completed phases.
+     * @returns Number of completed phases (wraps around at 2^31).
+     */
+    std::uint32_t phase(void) const noexcept
+    {
+        return m_state.load(std::memory_order_acquire) >> 1u;
+    }
+
+private:
+    static constexpr std::uint32_t SLEEPING = 1u; // Set once a waiter sleeps, the phase starts at bit 1.
+
+    // Waiters mostly read the first line, arriving threads write the second.
+    alignas(SIMONS_LIB_CACHE_LINE_SIZE) std::atomic<std::uint32_t> m_state;
+    std::uint32_t const                                             m_count;
+    std::chrono::nanoseconds const                                  m_spin;
+    alignas(SIMONS_LIB_CACHE_LINE_SIZE) std::atomic<std::uint32_t> m_arrived;
+};
+
+} // namespace simons_lib::barrier
+
+#endif // SPIN_BARRIER_IMPL_HPP_20190803083112
@@ -0,0 +1,152 @@
+/**
+ * @file      SpinLatchImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Single use latch spinning before it parks on a futex.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SPIN_LATCH_IMPL_HPP_20190803083112
+#define SPIN_LATCH_IMPL_HPP_20190803083112
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include "../Mutex/Detail.hpp"
+#include "Detail.hpp"
+
+namespace simons_lib::barrier
+{
+
+/**
+ * @brief Single use countdown latch, spinning before it sleeps.
+ * @note Waiting threads spin on the counter for a configurable time and then
+ *       sleep on it as futex word. The lowest bit of the word marks sleeping
+ *       waiters, so the decrement reaching zero alone decides whether to wake
+ *       them and count_down never touches the latch after it. A waiter may
+ *       therefore destroy the latch as soon as wait() returns. Without futex
+ *       support waiting threads yield. Use NullLatch as drop-in replacement in
+ *       single threaded builds.
+ */
+class SpinLatch
+{
+public:
+    /// @brief Default time to spin before sleeping.
+    static constexpr auto DEFAULT_SPIN = std::chrono::nanoseconds(std::chrono::microseconds(50));
+
+    /**
+     * @brief Constructor.
+     * @param[in] count   Initial value of the counter. Must be < 2^31.
+     * @param[in] spin    Time to spin before sleeping. Ignored on single core systems.
+     */
+    explicit SpinLatch(std::uint32_t count, std::chrono::nanoseconds spin = DEFAULT_SPIN) noexcept
+        : m_state(count << 1u)
+        , m_spin(detail::effectiveSpin(spin))
+    {
+    }
+
+    // Copying and moving is forbidden
+    SpinLatch(SpinLatch const&) = delete;
+    SpinLatch(SpinLatch&&) = delete;
+    SpinLatch& operator = (SpinLatch const&) = delete;
+    SpinLatch& operator = (SpinLatch&&) = delete;
+
+    /**
+     * @brief Decrement the counter without waiting.
+     * @note Decrementing below zero is undefined.
+     * @param[in] n   Value to decrement by.
+     */
+    void count_down(std::uint32_t n = 1) noexcept
+    {
+        auto const previous = m_state.fetch_sub(n << 1u, std::memory_order_acq_rel);
+        if (((previous >> 1u) == n) && ((previous & SLEEPING) != 0u))
+        {
+            // Only the address is passed on, the latch may already be destroyed.
+            mutex::detail::futexWake(m_state, INT_MAX);
+        }
+    }
+
+    /**
+     * @brief Check if the counter reached zero.
+     * @returns true if the counter is zero, false otherwise.
+     */
+    bool try_wait(void) const noexcept
+    {
+        return (m_state.load(std::memory_order_acquire) >> 1u) == 0u;
+    }
+
+    /**
+     * @brief Wait until the counter reaches zero.
+     */
+    void wait(void) noexcept
+    {
+        if (detail::spinUntil([this] () { return try_wait(); }, m_spin))
+        {
+            return;
+        }
+
+        auto state = m_state.load(std::memory_order_acquire);
+        while ((state >> 1u) != 0u)
+        {
+            if (((state & SLEEPING) != 0u) ||
+                m_state.compare_exchange_weak(state, state | SLEEPING, std::memory_order_acquire))
+            {
+                mutex::detail::futexWait(m_state, state | SLEEPING);
+                state = m_state.load(std::memory_order_acquire);
+            }
+        }
+    }
+
+    /**
+     * @brief Decrement the counter and wait until it reaches zero.
+     * @param[in] n   Value to decrement by.
+     */
+    void arrive_and_wait(std::uint32_t n = 1) noexcept
+    {
+        count_down(n);
+        wait();
+    }
+
+private:
+    static constexpr std::uint32_t SLEEPING = 1u; // Set once a waiter sleeps, the counter starts at bit 1.
+
+    std::atomic<std::uint32_t>     m_state;
+    std::chrono::nanoseconds const m_spin;
+};
+
+} // namespace simons_lib::barrier
+
+#endif // SPIN_LATCH_IMPL_HPP_20190803083112
@@ -0,0 +1,258 @@
+/**
+ * @file      BufferedRandomNumberGeneratorImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     RandomNumberGenerator front-end refilled by a background thread.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BUFFERED_RANDOM_NUMBER_GENERATOR_IMPL_HPP_20190323090512
+#define BUFFERED_RANDOM_NUMBER_GENERATOR_IMPL_HPP_20190323090512
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include "../Defines.hpp"
+#include "../Math.hpp"
+#include "../RandomNumberGenerator.hpp"
+
+namespace simons_lib::random_number_generator
+{
+
+/**
+ * @brief Snapshot of the counters of a BufferedRandomNumberGenerator.
+ */
+struct BufferMetrics
+{
+    std::uint64_t produced;  ///< Values generated by the background thread.
+    std::uint64_t buffered;  ///< Values handed out from the buffer.
+    std::uint64_t underruns; ///< Values generated synchronously because the buffer was empty.
+    std::uint64_t contended; ///< Values generated synchronously because another consumer won the slot.
+};
+
+/**
+ * @brief RandomNumberGenerator front-end backed by a ring of pre-generated values.
+ * @note A background thread keeps the ring filled. Taking a value from the ring
+ *       is wait-free: it costs two loads, one compare-and-swap and one store.
+ *       If the ring is empty or the compare-and-swap is lost to a concurrent
+ *       consumer, the value is generated synchronously instead.
+ * @tparam E   Random engine type to use.
+ * @tparam D   Distribution type to use. The result type must be trivially copyable.
+ * @tparam M   Mutex guarding the wrapped RandomNumberGenerator. It is shared
+ *             between the background thread and synchronous fallbacks.
+ * @tparam N   Number of buffered values, must be a power of two.
+ */
+template<typename E, typename D, typename M = std::mutex, std::size_t N = 1024>
+class BufferedRandomNumberGenerator
+{
+public:
+    /// @brief Type of the wrapped random number generator.
+    using GeneratorType = RandomNumberGenerator<E, D, M>;
+    /// @brief type of resulting values generated by RNG
+    using ResultType = typename GeneratorType::ResultType;
+    /// @brief type of RNG seed
+    using SeedType = typename GeneratorType::SeedType;
+
+    /**
+     * @brief Constructor. Create RNG with a given seed and start the background thread.
+     * @param[in] seed     The seed used to initialize RNGs random engine.
+     * @param[in] period   Time the background thread sleeps while the ring is full.
+     */
+    explicit BufferedRandomNumberGenerator(SeedType seed,
+                                           std::chrono::microseconds period = std::chrono::microseconds(100))
+        : BufferedRandomNumberGenerator(seed, D(), period)
+    {
+    }
+
+    /**
+     * @brief Constructor. Create RNG with a given seed and distribution and start the background thread.
+     * @param[in] seed           The seed used to initialize RNGs random engine.
+     * @param[in] distribution   The distribution used to shape generated values.
+     * @param[in] period         Time the background thread sleeps while the ring is full.
+     */
+    BufferedRandomNumberGenerator(SeedType seed, D const& distribution,
+                                  std::chrono::microseconds period = std::chrono::microseconds(100))
+        : m_generator(seed, distribution)
+        , m_period(period)
+    {
+        static_assert(N >= 2u && simons_lib::math::isPowOfTwo(N), "N must be a power of two >= 2.");
+        static_assert(std::is_trivially_copyable_v<ResultType>, "ResultType must be trivially copyable.");
+
+        for (auto i = std::size_t(0); i < N; ++i)
+        {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        m_producer = std::thread([this] ()
+        {
+            produce();
+        });
+    }
+
+    ~BufferedRandomNumberGenerator()
+    {
+        {
+            auto guard = std::lock_guard<std::mutex>(m_wakeupMutex);
+            m_running.store(false, std::memory_order_relaxed);
+        }
+        m_wakeup.notify_one();
+        m_producer.join();
+    }
+
+    // Copying and moving is forbidden
+    BufferedRandomNumberGenerator(BufferedRandomNumberGenerator const&) = delete;
+    BufferedRandomNumberGenerator(BufferedRandomNumberGenerator&&) = delete;
+    BufferedRandomNumberGenerator& operator = (BufferedRandomNumberGenerator const&) = delete;
+    BufferedRandomNumberGenerator& operator = (BufferedRandomNumberGenerator&&) = delete;
+
+    /**
+     * @brief Get next random number.
+     * @returns random number
+     */
+    ResultType operator () (void)
+    {
+        auto pos = m_head.load(std::memory_order_relaxed);
+        auto& slot = m_slots[pos & (N - 1)];
+
+        auto sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence < pos + 1)
+        {
+            m_underruns.fetch_add(1, std::memory_order_relaxed);
+            wakeProducer();
+            return m_generator();
+        }
+
+        if ((sequence != pos + 1) || !m_head.compare_exchange_strong(pos, pos + 1, std::memory_order_relaxed))
+        {
+            m_contended.fetch_add(1, std::memory_order_relaxed);
+            return m_generator();
+        }
+
+        // The slot is owned until its sequence number is handed back to the producer.
+        auto value = slot.value;
+        slot.sequence.store(pos + N, std::memory_order_release);
+        if ((pos & (N / 2 - 1)) == 0)
+        {
+            wakeProducer();
+        }
+        return value;
+    }
+
+    /**
+     * @brief Get a snapshot of the buffer counters.
+     * @returns Current metrics.
+     */
+    BufferMetrics metrics(void) const
+    {
+        return BufferMetrics{m_tail.load(std::memory_order_relaxed),
+                             m_head.load(std::memory_order_relaxed),
+                             m_underruns.load(std::memory_order_relaxed),
+                             m_contended.load(std::memory_order_relaxed)};
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<std::uint64_t> sequence; // pos + 1: filled, pos: free for round pos / N
+        ResultType                 value;
+    };
+
+    void produce(void)
+    {
+        auto pos = std::uint64_t(0);
+        while (m_running.load(std::memory_order_relaxed))
+        {
+            auto& slot = m_slots[pos & (N - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) == pos)
+            {
+                slot.value = m_generator();
+                slot.sequence.store(pos + 1, std::memory_order_release);
+                m_tail.store(++pos, std::memory_order_relaxed);
+                continue;
+            }
+
+            // Ring is full: Sleep until a consumer drained part of it. The slot is
+            // checked again after announcing the sleep, a consumer freeing it
+            // before that might not have seen m_sleeping.
+            auto lock = std::unique_lock<std::mutex>(m_wakeupMutex);
+            m_sleeping.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (m_running.load(std::memory_order_relaxed) &&
+                (slot.sequence.load(std::memory_order_relaxed) != pos))
+            {
+                m_wakeup.wait_for(lock, m_period);
+            }
+            m_sleeping.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    // Wake the background thread if it sleeps. Called on the rare paths only
+    // (underrun, every N / 2 values), the hot path stays free of any fence.
+    void wakeProducer(void)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_sleeping.load(std::memory_order_relaxed))
+        {
+            // Taking the mutex ensures the producer is either waiting or has
+            // not checked the slot yet, so the notification cannot get lost.
+            {
+                auto guard = std::lock_guard<std::mutex>(m_wakeupMutex);
+            }
+            m_wakeup.notify_one();
+        }
+    }
+
+    GeneratorType                                                  m_generator;
+    std::chrono::microseconds                                      m_period;
+    std::array<Slot, N>                                            m_slots;
+    alignas(SIMONS_LIB_CACHE_LINE_SIZE) std::atomic<std::uint64_t> m_head{0u};
+    alignas(SIMONS_LIB_CACHE_LINE_SIZE) std::atomic<std::uint64_t> m_tail{0u};
+    std::atomic<std::uint64_t>                                     m_underruns{0u};
+    std::atomic<std::uint64_t>                                     m_contended{0u};
+    std::atomic<bool>                                              m_running{true};
+    std::atomic<bool>                                              m_sleeping{false};
+    std::mutex                                                     m_wakeupMutex;
+    std::condition_variable                                        m_wakeup;
+    std::thread                                                    m_producer;
+};
+
+} // namespace simons_lib::random_number_generator
+
+#endif // BUFFERED_RANDOM_NUMBER_GENERATOR_IMPL_HPP_20190323090512
@@ -0,0 +1,120 @@
+/**
+ * @file      AtomicImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Support of sync_policy::Atomic for CachedCallable.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ATOMIC_IMPL_HPP_20190811120312
+#define ATOMIC_IMPL_HPP_20190811120312
+
+#include <atomic>
+#include <memory>
+#include "../Reclamation/EpochDomainImpl.hpp"
+#include "CachedCallableImpl.hpp"
+
+namespace simons_lib::cached_callable
+{
+
+/// @cond DO_NOT_DOCUMENT
+namespace detail
+{
+
+// Result published with a single pointer. Readers never lock, replaced
+// results are freed via EpochDomain::global().
+template<typename T>
+class AtomicResult
+{
+public:
+    AtomicResult(void) noexcept
+        : m_result(nullptr)
+    {
+    }
+
+    ~AtomicResult(void)
+    {
+        delete m_result.load(std::memory_order_relaxed);
+    }
+
+    AtomicResult(AtomicResult const&) = delete;
+    AtomicResult& operator = (AtomicResult const&) = delete;
+
+    template<typename F>
+    T get(F const& callable)
+    {
+        using simons_lib::reclamation::EpochDomain;
+
+        {
+            auto guard = EpochDomain::global().pin();
+            auto cached = m_result.load(std::memory_order_acquire);
+            if (cached)
+            {
+                return *cached;
+            }
+        }
+
+        // Run the callable unpinned, a slow callable must not stall
+        // reclamation of other users of the global domain.
+        auto fresh = std::make_unique<T const>(callable());
+        auto guard = EpochDomain::global().pin();
+        auto cached = static_cast<T const*>(nullptr);
+        if (m_result.compare_exchange_strong(cached, fresh.get(), std::memory_order_acq_rel,
+                                             std::memory_order_acquire))
+        {
+            cached = fresh.release();
+        }
+        return *cached;
+    }
+
+    void reset(void)
+    {
+        auto cached = m_result.exchange(nullptr, std::memory_order_acq_rel);
+        if (cached)
+        {
+            simons_lib::reclamation::EpochDomain::global().retire(const_cast<T*>(cached));
+        }
+    }
+
+private:
+    std::atomic<T const*> m_result;
+};
+
+} // namespace detail
+/// @endcond DO_NOT_DOCUMENT
+
+} // namespace simons_lib::cached_callable
+
+#endif // ATOMIC_IMPL_HPP_20190811120312
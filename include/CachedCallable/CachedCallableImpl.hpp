@@ -43,32 +43,60 @@
 
 #include <functional>
 #include <optional>
+#include <type_traits>
 #include "../LockGuard.hpp"
 #include "../NullTypes.hpp"
+#include "../SyncPolicy.hpp"
 
 namespace simons_lib::cached_callable
 {
 
 using simons_lib::null_types::NullMutex;
 using simons_lib::lock::LockGuard;
+using simons_lib::lock::SharedLockGuard;
+using simons_lib::lock::IsSharedLockable;
+using simons_lib::sync_policy::PolicyOf;
+using simons_lib::sync_policy::SyncKind;
+
+/// @cond DO_NOT_DOCUMENT
+namespace detail
+{
+// Result storage for sync_policy::Atomic, defined in AtomicImpl.hpp.
+template<typename T>
+class AtomicResult;
+} // namespace detail
+/// @endcond DO_NOT_DOCUMENT
 
 /**
  * @brief Simple cache for results returned by callable objects.
  * @tparam T   The cached result type.
- * @tparam M   Internally used mutex type (defaults to NullMutex).
+ * @tparam P   Synchronization policy or mutex type (defaults to NullMutex).
  *             If thread safety is required supply a mutex of your choice.
+ *             SharedLockable mutexes (e.g. std::shared_mutex) allow concurrent
+ *             readers of an already cached result. sync_policy::Atomic publishes
+ *             the result with a single pointer, readers never lock and replaced
+ *             results are freed via EpochDomain::global(). On a concurrent miss
+ *             the callable may run more than once, only one result is kept.
+ *             It requires CachedCallable/AtomicImpl.hpp, so that reclamation
+ *             is only pulled in where it is used.
+ *             sync_policy::ThreadLocal is not supported.
  */
-template<typename T, typename M = NullMutex>
+template<typename T, typename P = NullMutex>
 class CachedCallable
 {
 public:
     /// @brief Type the stored callable return value.
     using ResultType = T;
-    /// @brief Type of supplied mutex.
-    using MutexType = M;
+    /// @brief Used synchronization policy.
+    using PolicyType = typename PolicyOf<P>::type;
+    /// @brief Type of used mutex.
+    using MutexType = typename PolicyType::MutexType;
     /// @brief Type of stored callable object.
     using CallableType = std::function<ResultType(void)>;
 
+    static_assert(PolicyType::KIND != SyncKind::THREAD_LOCAL,
+                  "CachedCallable does not support sync_policy::ThreadLocal");
+
     /**
      * @brief Constructor.
      * @param[in] callable   Callable object those results should be cached.
@@ -88,12 +116,29 @@ public:
      */
     ResultType operator ()(void)
     {
-        auto guard = LockGuard<MutexType>(m_mutex);
-        if (!m_result)
+        if constexpr (ATOMIC)
         {
-            m_result = m_callable();
+            return m_result.get(m_callable);
+        }
+        else
+        {
+            if constexpr (IsSharedLockable<MutexType>::value)
+            {
+                // Fast path: Result is cached, readers share the lock.
+                auto guard = SharedLockGuard<MutexType>(m_mutex);
+                if (m_result)
+                {
+                    return *m_result;
+                }
+            }
+
+            auto guard = LockGuard<MutexType>(m_mutex);
+            if (!m_result)
+            {
+                m_result = m_callable();
+            }
+            return *m_result;
         }
-        return *m_result;
     }
 
     /**
@@ -103,14 +148,27 @@ public:
      */
     void reset(void)
     {
-        auto guard = LockGuard<MutexType>(m_mutex);
-        m_result.reset();
+        if constexpr (ATOMIC)
+        {
+            m_result.reset();
+        }
+        else
+        {
+            auto guard = LockGuard<MutexType>(m_mutex);
+            m_result.reset();
+        }
     }
 
 private:
-    CallableType              m_callable;
-    std::optional<ResultType> m_result;
-    MutexType                 m_mutex;
+    static constexpr bool ATOMIC = (PolicyType::KIND == SyncKind::ATOMIC);
+
+    // Using sync_policy::Atomic without including CachedCallable/AtomicImpl.hpp
+    // fails here with an incomplete type.
+    using StorageType = std::conditional_t<ATOMIC, detail::AtomicResult<ResultType>, std::optional<ResultType>>;
+
+    CallableType m_callable;
+    StorageType  m_result;
+    MutexType    m_mutex;
 };
 
 } // namespace simons_lib::cached_callable
@@ -0,0 +1,102 @@
+/**
+ * @file      Detail.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Internal details of Counters. Not intended for direct usage.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @cond DO_NOT_DOCUMENT
+ * @note Documentation for this file is suppressed to avoid
+ *       polluting the generated documentation with internal details.
+ */
+
+#ifndef DETAIL_HPP_20190720092741
+#define DETAIL_HPP_20190720092741
+
+#include <cstddef>
+#include <thread>
+#include "../Mutex/Detail.hpp"
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace simons_lib::counters::detail
+{
+
+// Round up to a power of two, so slots can be selected with a mask.
+inline std::size_t roundSlots(std::size_t slots) noexcept
+{
+    auto rounded = std::size_t(1);
+    while (rounded < slots)
+    {
+        rounded *= 2u;
+    }
+    return rounded;
+}
+
+// Default number of slots: hardware threads rounded up to a power of two.
+inline std::size_t defaultSlots(void) noexcept
+{
+    static auto const slots = roundSlots(std::thread::hardware_concurrency());
+    return slots;
+}
+
+// Slot of the CPU the calling thread currently runs on, mask = slots - 1.
+// Looked up on every call (a vDSO call on Linux), so threads sharing a slot
+// only collide while they run on the same CPU. Updates are single relaxed
+// atomic adds and stay correct if the thread migrates meanwhile. Falls back
+// to the round robin index of the thread where the CPU is unknown.
+inline std::size_t slotIndex(std::size_t mask) noexcept
+{
+#if defined(__linux__)
+    auto cpu = sched_getcpu();
+    if (cpu >= 0)
+    {
+        return static_cast<std::size_t>(cpu) & mask;
+    }
+#endif
+    return mutex::detail::threadIndex() & mask;
+}
+
+} // namespace simons_lib::counters::detail
+
+#endif // DETAIL_HPP_20190720092741
+
+/**
+ * @endcond DO_NOT_DOCUMENT
+ */
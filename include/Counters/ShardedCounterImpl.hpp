@@ -0,0 +1,157 @@
+/**
+ * @file      ShardedCounterImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Per-CPU sharded counter and gauge.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SHARDED_COUNTER_IMPL_HPP_20190720092741
+#define SHARDED_COUNTER_IMPL_HPP_20190720092741
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "../Defines.hpp"
+#include "Detail.hpp"
+
+namespace simons_lib::counters
+{
+
+/**
+ * @brief Counter spread over per-CPU slots, each in its own cache line.
+ * @note Each update adds to the slot of the CPU the calling thread runs on
+ *       with a relaxed atomic add, so threads on different CPUs never write
+ *       the same cache line. Reading sums up all slots and is comparatively expensive.
+ *       The sum is not a snapshot, concurrent updates may or may not be included.
+ * @tparam T   Integral value type. Signed types allow decrements (gauges).
+ */
+template<typename T>
+class BasicShardedCounter
+{
+public:
+    /// @brief Type of the counted value.
+    using ValueType = T;
+
+    /**
+     * @brief Constructor.
+     * @param[in] slots   Number of slots, rounded up to a power of two.
+     *                    Defaults to the number of hardware threads.
+     */
+    explicit BasicShardedCounter(std::size_t slots = detail::defaultSlots())
+        : m_mask(detail::roundSlots(slots) - 1u)
+        , m_slots(std::make_unique<Slot[]>(m_mask + 1u))
+    {
+    }
+
+    // Copying and moving is forbidden
+    BasicShardedCounter(BasicShardedCounter const&) = delete;
+    BasicShardedCounter(BasicShardedCounter&&) = delete;
+    BasicShardedCounter& operator = (BasicShardedCounter const&) = delete;
+    BasicShardedCounter& operator = (BasicShardedCounter&&) = delete;
+
+    /**
+     * @brief Add to the counter.
+     * @param[in] value   Value to add.
+     */
+    void add(ValueType value = 1) noexcept
+    {
+        m_slots[detail::slotIndex(m_mask)].value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Subtract from the counter.
+     * @param[in] value   Value to subtract.
+     */
+    void sub(ValueType value = 1) noexcept
+    {
+        m_slots[detail::slotIndex(m_mask)].value.fetch_sub(value, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Current value, the sum of all slots.
+     * @returns Sum of all slots.
+     */
+    ValueType value(void) const noexcept
+    {
+        auto sum = ValueType(0);
+        for (auto i = std::size_t(0); i <= m_mask; ++i)
+        {
+            sum = static_cast<ValueType>(sum + m_slots[i].value.load(std::memory_order_relaxed));
+        }
+        return sum;
+    }
+
+    /**
+     * @brief Reset the counter to zero.
+     * @note Updates concurrent to the reset may be lost.
+     */
+    void reset(void) noexcept
+    {
+        for (auto i = std::size_t(0); i <= m_mask; ++i)
+        {
+            m_slots[i].value.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Number of slots.
+     * @returns Number of slots.
+     */
+    std::size_t slots(void) const noexcept
+    {
+        return m_mask + 1u;
+    }
+
+private:
+    struct alignas(SIMONS_LIB_CACHE_LINE_SIZE) Slot
+    {
+        std::atomic<ValueType> value = {0};
+    };
+
+    std::size_t             m_mask;
+    std::unique_ptr<Slot[]> m_slots;
+};
+
+/// @brief Monotonic event counter.
+using ShardedCounter = BasicShardedCounter<std::uint64_t>;
+
+/// @brief Up and down counter, e.g. for requests in flight.
+using ShardedGauge = BasicShardedCounter<std::int64_t>;
+
+} // namespace simons_lib::counters
+
+#endif // SHARDED_COUNTER_IMPL_HPP_20190720092741
@@ -0,0 +1,216 @@
+/**
+ * @file      ShardedHistogramImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Per-CPU sharded histogram with power of two buckets.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SHARDED_HISTOGRAM_IMPL_HPP_20190720092741
+#define SHARDED_HISTOGRAM_IMPL_HPP_20190720092741
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "../Defines.hpp"
+#include "Detail.hpp"
+
+namespace simons_lib::counters
+{
+
+/**
+ * @brief Histogram of unsigned values with power of two buckets, spread over per-CPU slots.
+ * @note Bucket 0 counts zeros, bucket i counts values in [2^(i-1), 2^i).
+ *       Recording costs a bit scan and two relaxed atomic adds to the slot of
+ *       the CPU the calling thread runs on. Reading merges all slots into a Snapshot.
+ */
+class ShardedHistogram
+{
+public:
+    /// @brief Number of buckets, enough for any 64 bit value.
+    static constexpr std::size_t BUCKETS = 65;
+
+    /**
+     * @brief Merged state of all slots.
+     */
+    struct Snapshot
+    {
+        std::array<std::uint64_t, BUCKETS> buckets = {}; ///< Number of values per bucket.
+        std::uint64_t                      sum = 0;      ///< Sum of all values (wraps on overflow).
+
+        /**
+         * @brief Number of recorded values.
+         * @returns Number of recorded values.
+         */
+        std::uint64_t count(void) const noexcept
+        {
+            auto count = std::uint64_t(0);
+            for (auto bucket : buckets)
+            {
+                count += bucket;
+            }
+            return count;
+        }
+
+        /**
+         * @brief Upper bound of the given percentile.
+         * @param[in] p   Percentile in [0.0, 1.0].
+         * @returns Largest value of the bucket containing the percentile, 0 if empty.
+         */
+        std::uint64_t percentile(double p) const noexcept
+        {
+            auto total = count();
+            auto rank = static_cast<std::uint64_t>(p * static_cast<double>(total));
+            auto seen = std::uint64_t(0);
+            for (auto bucket = std::size_t(0); bucket < BUCKETS; ++bucket)
+            {
+                seen += buckets[bucket];
+                if ((seen > rank) || ((seen == total) && (seen != 0u)))
+                {
+                    return upperBound(bucket);
+                }
+            }
+            return 0u;
+        }
+
+        /**
+         * @brief Mean of all recorded values.
+         * @returns Mean, 0.0 if empty.
+         */
+        double mean(void) const noexcept
+        {
+            auto total = count();
+            return (total == 0u) ? 0.0 : static_cast<double>(sum) / static_cast<double>(total);
+        }
+    };
+
+    /**
+     * @brief Constructor.
+     * @param[in] slots   Number of slots, rounded up to a power of two.
+     *                    Defaults to the number of hardware threads.
+     */
+    explicit ShardedHistogram(std::size_t slots = detail::defaultSlots())
+        : m_mask(detail::roundSlots(slots) - 1u)
+        , m_slots(std::make_unique<Slot[]>(m_mask + 1u))
+    {
+    }
+
+    // Copying and moving is forbidden
+    ShardedHistogram(ShardedHistogram const&) = delete;
+    ShardedHistogram(ShardedHistogram&&) = delete;
+    ShardedHistogram& operator = (ShardedHistogram const&) = delete;
+    ShardedHistogram& operator = (ShardedHistogram&&) = delete;
+
+    /**
+     * @brief Record a value.
+     * @param[in] value   Value to record.
+     */
+    void record(std::uint64_t value) noexcept
+    {
+        auto& slot = m_slots[detail::slotIndex(m_mask)];
+        slot.buckets[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+        slot.sum.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Merge all slots.
+     * @returns Current state of the histogram.
+     */
+    Snapshot snapshot(void) const noexcept
+    {
+        auto snapshot = Snapshot();
+        for (auto i = std::size_t(0); i <= m_mask; ++i)
+        {
+            for (auto bucket = std::size_t(0); bucket < BUCKETS; ++bucket)
+            {
+                snapshot.buckets[bucket] += m_slots[i].buckets[bucket].load(std::memory_order_relaxed);
+            }
+            snapshot.sum += m_slots[i].sum.load(std::memory_order_relaxed);
+        }
+        return snapshot;
+    }
+
+    /**
+     * @brief Forget all recorded values.
+     * @note Values recorded concurrently to the reset may be lost.
+     */
+    void reset(void) noexcept
+    {
+        for (auto i = std::size_t(0); i <= m_mask; ++i)
+        {
+            for (auto& bucket : m_slots[i].buckets)
+            {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+            m_slots[i].sum.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Bucket a value is counted in.
+     * @param[in] value   Value to classify.
+     * @returns Bucket index, 0 for 0 and floor(log2(value)) + 1 otherwise.
+     */
+    static std::size_t bucketOf(std::uint64_t value) noexcept
+    {
+        return (value == 0u) ? 0u : static_cast<std::size_t>(64 - __builtin_clzll(value));
+    }
+
+    /**
+     * @brief Largest value counted in a bucket.
+     * @param[in] bucket   Bucket index.
+     * @returns 2^bucket - 1.
+     */
+    static std::uint64_t upperBound(std::size_t bucket) noexcept
+    {
+        return (bucket >= 64u) ? ~std::uint64_t(0) : ((std::uint64_t(1) << bucket) - 1u);
+    }
+
+private:
+    struct alignas(SIMONS_LIB_CACHE_LINE_SIZE) Slot
+    {
+        std::atomic<std::uint64_t> buckets[BUCKETS] = {};
+        std::atomic<std::uint64_t> sum = {0};
+    };
+
+    std::size_t             m_mask;
+    std::unique_ptr<Slot[]> m_slots;
+};
+
+} // namespace simons_lib::counters
+
+#endif // SHARDED_HISTOGRAM_IMPL_HPP_20190720092741
@@ -63,4 +63,13 @@
 // Disable
 #endif // SIMON_LIB_CONFIG_FOR_MCU
 
+// Size of a cache line in bytes. Used to align data accessed by different threads
+// to avoid false sharing. Can be overridden for targets with different line sizes.
+#ifndef SIMONS_LIB_CACHE_LINE_SIZE
+#define SIMONS_LIB_CACHE_LINE_SIZE 64
+#endif // SIMONS_LIB_CACHE_LINE_SIZE
+
+// Define SIMONS_LIB_PROFILE_LOCKS to turn every ProfiledMutex<M> into an
+// InstrumentedMutex<M> recording contention statistics. Not defined by default.
+
 #endif // DEFINDES_HPP_20180930093829
@@ -0,0 +1,127 @@
+/**
+ * @file      Parallel.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Internal helpers for seeding sub streams and splitting work over threads.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @cond DO_NOT_DOCUMENT
+ * @note Documentation for this file is suppressed to avoid
+ *       polluting the generated documentation with internal details.
+ */
+
+#ifndef PARALLEL_HPP_20190811094520
+#define PARALLEL_HPP_20190811094520
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace simons_lib::detail
+{
+
+// Derive an independent seed for a sub stream (SplitMix64 finalizer).
+constexpr std::uint64_t deriveSeed(std::uint64_t seed, std::uint64_t stream)
+{
+    auto z = seed + (stream + 1u) * 0x9E3779B97F4A7C15u;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9u;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBu;
+    return z ^ (z >> 31);
+}
+
+// Construct an engine seeded for a given sub stream.
+template<typename E>
+inline E makeEngine(std::uint64_t seed, std::uint64_t stream)
+{
+    return E(static_cast<typename E::result_type>(deriveSeed(seed, stream)));
+}
+
+// Number of threads to use if the caller passed 0.
+inline std::size_t threadCount(std::size_t threads)
+{
+    if (threads == 0)
+    {
+        threads = std::thread::hardware_concurrency();
+    }
+    return (threads == 0) ? 1 : threads;
+}
+
+// Execute func(i) for all i in [0, count) on up to threads threads.
+template<typename F>
+void parallelFor(std::size_t count, std::size_t threads, F const& func)
+{
+    threads = (threadCount(threads) < count) ? threadCount(threads) : count;
+    if (threads <= 1)
+    {
+        for (auto i = std::size_t(0); i < count; ++i)
+        {
+            func(i);
+        }
+        return;
+    }
+
+    auto next = std::atomic<std::size_t>(0);
+    auto work = [&next, count, &func] ()
+    {
+        for (auto i = next.fetch_add(1); i < count; i = next.fetch_add(1))
+        {
+            func(i);
+        }
+    };
+
+    auto workers = std::vector<std::thread>();
+    for (auto i = std::size_t(1); i < threads; ++i)
+    {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+
+} // namespace simons_lib::detail
+
+#endif // PARALLEL_HPP_20190811094520
+
+/**
+ * @endcond DO_NOT_DOCUMENT
+ */
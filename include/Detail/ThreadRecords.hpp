@@ -0,0 +1,239 @@
+/**
+ * @file      ThreadRecords.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Internal per-thread record lists shared by several modules.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @cond DO_NOT_DOCUMENT
+ * @note Documentation for this file is suppressed to avoid
+ *       polluting the generated documentation with internal details.
+ */
+
+#ifndef THREAD_RECORDS_HPP_20190811094520
+#define THREAD_RECORDS_HPP_20190811094520
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace simons_lib::detail
+{
+
+// Per-thread state of an object shared between threads. A record is owned by
+// one thread at a time. Records of exited threads are reused by new threads,
+// which inherit their state.
+struct ThreadRecord
+{
+    virtual ~ThreadRecord(void) = default;
+
+    std::atomic<bool> inUse = {true};
+    std::atomic<bool> orphaned = {false}; // Owning list was destroyed.
+    ThreadRecord*     next = nullptr;     // Immutable once published.
+};
+
+// Records claimed by the calling thread, one per record list.
+class ThreadRecordCache
+{
+public:
+    static ThreadRecordCache& local(void)
+    {
+        static thread_local auto cache = ThreadRecordCache();
+        return cache;
+    }
+
+    ~ThreadRecordCache(void)
+    {
+        for (auto const& entry : m_entries)
+        {
+            entry.record->inUse.store(false, std::memory_order_release);
+        }
+    }
+
+    ThreadRecord* find(std::uint64_t listId) noexcept
+    {
+        if (m_lastId == listId)
+        {
+            return m_last;
+        }
+
+        for (auto const& entry : m_entries)
+        {
+            if (entry.listId == listId)
+            {
+                m_lastId = listId;
+                m_last = entry.record.get();
+                return m_last;
+            }
+        }
+        return nullptr;
+    }
+
+    void add(std::uint64_t listId, std::shared_ptr<ThreadRecord> record)
+    {
+        // Drop records of destroyed lists.
+        m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(), [] (Entry const& entry)
+        {
+            return entry.record->orphaned.load(std::memory_order_acquire);
+        }), m_entries.end());
+
+        m_lastId = listId;
+        m_last = record.get();
+        m_entries.push_back(Entry{listId, std::move(record)});
+    }
+
+private:
+    struct Entry
+    {
+        std::uint64_t               listId;
+        std::shared_ptr<ThreadRecord> record;
+    };
+
+    ThreadRecordCache(void) = default;
+
+    std::vector<Entry> m_entries;
+    std::uint64_t      m_lastId = 0;
+    ThreadRecord*        m_last = nullptr;
+};
+
+// Ids of record lists. Shared by all record types, since ThreadRecordCache is.
+inline std::uint64_t nextRecordListId(void) noexcept
+{
+    static auto id = std::atomic<std::uint64_t>(0);
+    return id.fetch_add(1, std::memory_order_relaxed) + 1u;
+}
+
+// Lock-free iterable list of per-thread records. R must derive from ThreadRecord.
+template<typename R>
+class RecordList
+{
+public:
+    RecordList(void)
+        : m_id(nextRecordListId())
+        , m_head(nullptr)
+        , m_mutex()
+        , m_owned()
+    {
+    }
+
+    ~RecordList(void)
+    {
+        for (auto const& record : m_owned)
+        {
+            record->orphaned.store(true, std::memory_order_release);
+        }
+    }
+
+    RecordList(RecordList const&) = delete;
+    RecordList& operator = (RecordList const&) = delete;
+
+    // Record of the calling thread, claimed on first use.
+    R& local(void)
+    {
+        // Trivially initialized, avoids the guard of the thread_local cache on the fast path.
+        static thread_local LastUsed last = {0, nullptr};
+        if (last.id == m_id)
+        {
+            return static_cast<R&>(*last.record);
+        }
+
+        auto& cache = ThreadRecordCache::local();
+        auto record = cache.find(m_id);
+        if (!record)
+        {
+            auto claimed = claim();
+            cache.add(m_id, claimed);
+            record = claimed.get();
+        }
+
+        // Records stay alive as long as the thread's cache, ids are never reused.
+        last = LastUsed{m_id, record};
+        return static_cast<R&>(*record);
+    }
+
+    template<typename F>
+    void forEach(F&& func)
+    {
+        for (auto record = m_head.load(std::memory_order_acquire); record; record = record->next)
+        {
+            func(static_cast<R&>(*record));
+        }
+    }
+
+private:
+    struct LastUsed
+    {
+        std::uint64_t id;
+        ThreadRecord*   record;
+    };
+
+    std::shared_ptr<ThreadRecord> claim(void)
+    {
+        auto guard = std::lock_guard<std::mutex>(m_mutex);
+        for (auto const& record : m_owned)
+        {
+            auto expected = false;
+            if (record->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire))
+            {
+                return record;
+            }
+        }
+
+        auto record = std::shared_ptr<ThreadRecord>(std::make_shared<R>());
+        record->next = m_head.load(std::memory_order_relaxed);
+        m_head.store(record.get(), std::memory_order_release);
+        m_owned.push_back(record);
+        return record;
+    }
+
+    std::uint64_t                            m_id;
+    std::atomic<ThreadRecord*>                 m_head;
+    std::mutex                               m_mutex; // Serializes claiming.
+    std::vector<std::shared_ptr<ThreadRecord>> m_owned;
+};
+
+
+} // namespace simons_lib::detail
+
+#endif // THREAD_RECORDS_HPP_20190811094520
+
+/**
+ * @endcond DO_NOT_DOCUMENT
+ */
@@ -0,0 +1,553 @@
+/**
+ * @file      AliasDistributionImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Discrete distribution with O(1) sampling (Walker/Vose alias method).
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ALIAS_DISTRIBUTION_IMPL_HPP_20190316120431
+#define ALIAS_DISTRIBUTION_IMPL_HPP_20190316120431
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Detail.hpp"
+
+namespace simons_lib::distributions
+{
+
+/// @cond DO_NOT_DOCUMENT
+namespace detail
+{
+
+// Alias table with compact 8 byte entries. The probability to keep a column
+// is stored as 32 bit fixed point number, full columns alias themselves.
+class AliasTable
+{
+public:
+    struct Entry
+    {
+        std::uint32_t prob;
+        std::uint32_t alias;
+    };
+    static_assert(sizeof(Entry) == 8);
+
+    // Build table for given non-negative weights with positive sum (Vose, 1991).
+    void build(std::vector<double> const& weights, double sum)
+    {
+        auto n = weights.size();
+        auto size = static_cast<std::uint32_t>(n);
+        m_entries.resize(n);
+        m_threshold = (size != 0u) ? static_cast<std::uint32_t>((0u - size) % size) : 0u;
+
+        // Worklist: small columns grow from the front, large ones from the back.
+        auto scaled = std::vector<double>(n);
+        auto work = std::vector<std::uint32_t>(n);
+        auto small = std::size_t(0);
+        auto large = n;
+        for (auto i = std::size_t(0); i < n; ++i)
+        {
+            scaled[i] = weights[i] * static_cast<double>(n) / sum;
+            if (scaled[i] < 1.0)
+            {
+                work[small++] = static_cast<std::uint32_t>(i);
+            }
+            else
+            {
+                work[--large] = static_cast<std::uint32_t>(i);
+            }
+        }
+
+        // Pair small columns with large ones. Large columns that drop below 1
+        // are moved to the small end of the worklist.
+        auto smallBegin = std::size_t(0);
+        while ((smallBegin < small) && (large < n))
+        {
+            auto less = work[smallBegin++];
+            auto more = work[large];
+            m_entries[less] = Entry{toFixedPoint(scaled[less]), more};
+
+            scaled[more] = (scaled[more] + scaled[less]) - 1.0;
+            if (scaled[more] < 1.0)
+            {
+                ++large;
+                work[small++] = more;
+            }
+        }
+
+        // Remaining columns are full up to rounding errors.
+        for (; smallBegin < small; ++smallBegin)
+        {
+            m_entries[work[smallBegin]] = Entry{0u, work[smallBegin]};
+        }
+        for (; large < n; ++large)
+        {
+            m_entries[work[large]] = Entry{0u, work[large]};
+        }
+    }
+
+    bool empty(void) const
+    {
+        return m_entries.empty();
+    }
+
+    // Draw a column. Returns false if word must be rejected.
+    bool sample(std::uint64_t word, std::uint32_t& index) const
+    {
+        auto lo = std::uint32_t();
+        multiply(static_cast<std::uint32_t>(word >> 32), static_cast<std::uint32_t>(m_entries.size()), index, lo);
+        if (lo < m_threshold)
+        {
+            return false;
+        }
+
+        auto const& entry = m_entries[index];
+        index = (static_cast<std::uint32_t>(word) < entry.prob) ? index : entry.alias;
+        return true;
+    }
+
+private:
+    static std::uint32_t toFixedPoint(double prob)
+    {
+        auto fixed = prob * 4294967296.0;
+        return (fixed < 4294967295.0) ? static_cast<std::uint32_t>(fixed) : 0xFFFFFFFFu;
+    }
+
+    std::vector<Entry> m_entries;
+    std::uint32_t      m_threshold = 0u;
+};
+
+} // namespace detail
+/// @endcond
+
+/**
+ * @brief Drop-in replacement for std::discrete_distribution.
+ * @note Draws are O(1): one engine call, one multiplication and a single
+ *       8 byte table access (Walker/Vose alias method). Construction is O(n).
+ *
+ *       Weights can be updated incrementally. Increased weights are served by
+ *       a second alias table over the changed entries only, decreased weights
+ *       by rejection. Both are folded into the main table by a full rebuild
+ *       as soon as the changed weight exceeds 1/8 of the total weight.
+ * @tparam T   Integer type of generated values.
+ */
+template<typename T = int>
+class AliasDistribution
+{
+    static_assert(std::is_integral<T>::value);
+
+public:
+    /// @brief Type of generated values.
+    using result_type = T;
+
+    /**
+     * @brief Parameter set of AliasDistribution, holding weights and alias tables.
+     */
+    class param_type
+    {
+    public:
+        /// @brief Type of the owning distribution.
+        using distribution_type = AliasDistribution;
+
+        /// @brief Constructor. Creates a distribution with a single category.
+        param_type(void)
+            : param_type({1.0})
+        {
+        }
+
+        /**
+         * @brief Constructor.
+         * @note Negative weights are treated as zero. If there are no weights
+         *       or all of them are zero, a single category is used.
+         * @param[in] first   Begin of the weight range.
+         * @param[in] last    End of the weight range.
+         */
+        template<typename InputIt>
+        param_type(InputIt first, InputIt last)
+        {
+            for (; first != last; ++first)
+            {
+                auto weight = static_cast<double>(*first);
+                m_weights.push_back((weight > 0.0) ? weight : 0.0);
+            }
+            rebuild();
+        }
+
+        /**
+         * @brief Constructor.
+         * @param[in] weights   List of weights.
+         */
+        param_type(std::initializer_list<double> weights)
+            : param_type(weights.begin(), weights.end())
+        {
+        }
+
+        /// @brief Get number of categories.
+        std::size_t size(void) const
+        {
+            return m_weights.size();
+        }
+
+        /// @brief Get current weight of category @p index.
+        double weight(std::size_t index) const
+        {
+            return m_weights[index];
+        }
+
+        /// @brief Get normalized probabilities of all categories.
+        std::vector<double> probabilities(void) const
+        {
+            auto total = m_baseSum - m_deficit + m_excess;
+            auto probs = m_weights;
+            for (auto& prob : probs)
+            {
+                prob /= total;
+            }
+            return probs;
+        }
+
+        /**
+         * @brief Change the weight of a single category.
+         * @param[in] index    Category to change.
+         * @param[in] weight   New weight, must be >= 0.
+         * @returns true in case of success, false if @p index or @p weight is invalid.
+         */
+        bool updateWeight(std::size_t index, double weight)
+        {
+            auto update = std::pair<std::size_t, double>(index, weight);
+            return updateWeights(&update, &update + 1);
+        }
+
+        /**
+         * @brief Change the weights of several categories.
+         * @note Costs O(k) for k changed categories as long as the changed weight
+         *       stays below 1/8 of the total weight, otherwise O(n).
+         * @param[in] first   Begin of a range of (index, weight) pairs.
+         * @param[in] last    End of a range of (index, weight) pairs.
+         * @returns true in case of success, false if any update is invalid.
+         *          In that case no weight is changed.
+         */
+        template<typename InputIt>
+        bool updateWeights(InputIt first, InputIt last)
+        {
+            for (auto it = first; it != last; ++it)
+            {
+                if ((it->first >= m_weights.size()) || !(it->second >= 0.0))
+                {
+                    return false;
+                }
+            }
+
+            for (; first != last; ++first)
+            {
+                auto index = first->first;
+                if (!m_isChanged[index])
+                {
+                    m_isChanged[index] = true;
+                    m_changed.push_back(static_cast<std::uint32_t>(index));
+                }
+                m_weights[index] = first->second;
+            }
+
+            // Recompute changed mass and the excess table over changed categories.
+            // Categories that returned to their base weight are dropped.
+            auto excessWeights = std::vector<double>();
+            auto changed = std::size_t(0);
+            m_excessItems.clear();
+            m_deficit = 0.0;
+            m_excess = 0.0;
+            for (auto index : m_changed)
+            {
+                auto diff = m_weights[index] - m_baseWeights[index];
+                if (diff > 0.0)
+                {
+                    m_excess += diff;
+                    excessWeights.push_back(diff);
+                    m_excessItems.push_back(index);
+                }
+                else
+                {
+                    m_deficit -= diff;
+                }
+
+                if (diff != 0.0)
+                {
+                    m_changed[changed++] = index;
+                }
+                else
+                {
+                    m_isChanged[index] = false;
+                }
+            }
+            m_changed.resize(changed);
+
+            if ((8.0 * (m_deficit + m_excess) > m_baseSum) || (m_baseSum - m_deficit + m_excess <= 0.0))
+            {
+                rebuild();
+            }
+            else
+            {
+                m_excessTable.build(excessWeights, m_excess);
+            }
+            return true;
+        }
+
+        /**
+         * @brief Rebuild the alias table from the current weights. Costs O(n).
+         */
+        void rebuild(void)
+        {
+            auto sum = 0.0;
+            for (auto weight : m_weights)
+            {
+                sum += weight;
+            }
+            if (!(sum > 0.0))
+            {
+                m_weights.assign(1, 1.0);
+                sum = 1.0;
+            }
+
+            m_baseWeights = m_weights;
+            m_baseSum = sum;
+            m_deficit = 0.0;
+            m_excess = 0.0;
+            m_changed.clear();
+            m_isChanged.assign(m_weights.size(), false);
+            m_excessItems.clear();
+            m_table.build(m_weights, sum);
+            m_excessTable = detail::AliasTable();
+        }
+
+        /// @brief Compare parameter sets for equality.
+        friend bool operator == (param_type const& lhs, param_type const& rhs)
+        {
+            return lhs.m_weights == rhs.m_weights;
+        }
+
+        /// @brief Compare parameter sets for inequality.
+        friend bool operator != (param_type const& lhs, param_type const& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        friend class AliasDistribution;
+
+        template<typename E>
+        result_type sample(E& engine) const
+        {
+            auto index = std::uint32_t();
+            if ((m_deficit == 0.0) && (m_excess == 0.0))
+            {
+                while (!m_table.sample(detail::uniformBits<std::uint64_t>(engine), index))
+                {
+                }
+                return static_cast<result_type>(index);
+            }
+
+            // Pick excess table with probability E / (B + E), the main table
+            // otherwise. Columns of the main table with decreased weight are
+            // accepted with probability weight / base weight.
+            while (true)
+            {
+                auto u = detail::toUnitInterval(detail::uniformBits<std::uint64_t>(engine)) * (m_baseSum + m_excess);
+                if (u < m_excess)
+                {
+                    if (m_excessTable.sample(detail::uniformBits<std::uint64_t>(engine), index))
+                    {
+                        return static_cast<result_type>(m_excessItems[index]);
+                    }
+                }
+                else if (m_table.sample(detail::uniformBits<std::uint64_t>(engine), index))
+                {
+                    if ((m_weights[index] >= m_baseWeights[index]) ||
+                        (detail::toUnitInterval(detail::uniformBits<std::uint64_t>(engine)) * m_baseWeights[index] <
+                         m_weights[index]))
+                    {
+                        return static_cast<result_type>(index);
+                    }
+                }
+            }
+        }
+
+        std::vector<double>        m_weights;     // Current weights.
+        std::vector<double>        m_baseWeights; // Weights m_table was built from.
+        double                     m_baseSum = 0.0;
+        double                     m_deficit = 0.0; // Sum of weight decreases since rebuild.
+        double                     m_excess = 0.0;  // Sum of weight increases since rebuild.
+        std::vector<std::uint32_t> m_changed;       // Categories changed since rebuild.
+        std::vector<bool>          m_isChanged;     // Membership flags of m_changed.
+        std::vector<std::uint32_t> m_excessItems;   // Categories covered by m_excessTable.
+        detail::AliasTable         m_table;
+        detail::AliasTable         m_excessTable;
+    };
+
+    /// @brief Constructor. Creates a distribution with a single category.
+    AliasDistribution(void)
+        : m_param()
+    {
+    }
+
+    /**
+     * @brief Constructor.
+     * @param[in] first   Begin of the weight range.
+     * @param[in] last    End of the weight range.
+     */
+    template<typename InputIt>
+    AliasDistribution(InputIt first, InputIt last)
+        : m_param(first, last)
+    {
+    }
+
+    /**
+     * @brief Constructor.
+     * @param[in] weights   List of weights.
+     */
+    AliasDistribution(std::initializer_list<double> weights)
+        : m_param(weights)
+    {
+    }
+
+    /**
+     * @brief Constructor.
+     * @param[in] param   Parameter set to use.
+     */
+    explicit AliasDistribution(param_type const& param)
+        : m_param(param)
+    {
+    }
+
+    /// @brief Reset internal state. The distribution is stateless, this does nothing.
+    void reset(void)
+    {
+    }
+
+    /// @brief Get normalized probabilities of all categories.
+    std::vector<double> probabilities(void) const
+    {
+        return m_param.probabilities();
+    }
+
+    /// @brief Get current parameter set.
+    param_type const& param(void) const
+    {
+        return m_param;
+    }
+
+    /// @brief Set new parameter set.
+    void param(param_type const& param)
+    {
+        m_param = param;
+    }
+
+    /// @brief Get smallest value that can be generated.
+    result_type min(void) const
+    {
+        return 0;
+    }
+
+    /// @brief Get largest value that can be generated.
+    result_type max(void) const
+    {
+        return static_cast<result_type>(m_param.size() - 1);
+    }
+
+    /// @copydoc param_type::updateWeight
+    bool updateWeight(std::size_t index, double weight)
+    {
+        return m_param.updateWeight(index, weight);
+    }
+
+    /// @copydoc param_type::updateWeights
+    template<typename InputIt>
+    bool updateWeights(InputIt first, InputIt last)
+    {
+        return m_param.updateWeights(first, last);
+    }
+
+    /// @copydoc param_type::rebuild
+    void rebuild(void)
+    {
+        m_param.rebuild();
+    }
+
+    /**
+     * @brief Generate next value using the current parameter set.
+     * @param[in] engine   Random engine to draw bits from.
+     * @returns value in [0, n).
+     */
+    template<typename E>
+    result_type operator () (E& engine)
+    {
+        return m_param.sample(engine);
+    }
+
+    /**
+     * @brief Generate next value using a given parameter set.
+     * @param[in] engine   Random engine to draw bits from.
+     * @param[in] param    Parameter set used for this call only.
+     * @returns value in [0, param.size()).
+     */
+    template<typename E>
+    result_type operator () (E& engine, param_type const& param)
+    {
+        return param.sample(engine);
+    }
+
+    /// @brief Compare distributions for equality.
+    friend bool operator == (AliasDistribution const& lhs, AliasDistribution const& rhs)
+    {
+        return lhs.m_param == rhs.m_param;
+    }
+
+    /// @brief Compare distributions for inequality.
+    friend bool operator != (AliasDistribution const& lhs, AliasDistribution const& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    param_type m_param;
+};
+
+} // namespace simons_lib::distributions
+
+#endif // ALIAS_DISTRIBUTION_IMPL_HPP_20190316120431
@@ -0,0 +1,310 @@
+/**
+ * @file      BoundedIntDistributionImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Unbiased bounded integer distribution (Lemire's multiply-shift).
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BOUNDED_INT_DISTRIBUTION_IMPL_HPP_20190302101512
+#define BOUNDED_INT_DISTRIBUTION_IMPL_HPP_20190302101512
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include "Detail.hpp"
+
+namespace simons_lib::distributions
+{
+
+/**
+ * @brief Drop-in replacement for std::uniform_int_distribution.
+ * @note Values are mapped into [a, b] via a full width multiplication and
+ *       only the high half of the product is used (D. Lemire, "Fast Random
+ *       Integer Generation in an Interval", 2019). The rejection threshold
+ *       is computed once per parameter set, so drawing a number never divides.
+ * @tparam T   Integer type of generated values, bool is not supported.
+ */
+template<typename T = int>
+class BoundedIntDistribution
+{
+    static_assert(std::is_integral<T>::value && !std::is_same<T, bool>::value, "T must be an integer type other than bool.");
+
+    using UnsignedType = typename std::make_unsigned<T>::type;
+    using WordType = typename std::conditional<(sizeof(T) <= sizeof(std::uint32_t)),
+                                               std::uint32_t,
+                                               std::uint64_t>::type;
+
+public:
+    /// @brief Type of generated values.
+    using result_type = T;
+
+    /**
+     * @brief Parameter set of BoundedIntDistribution.
+     */
+    class param_type
+    {
+    public:
+        /// @brief Type of the owning distribution.
+        using distribution_type = BoundedIntDistribution;
+
+        /**
+         * @brief Constructor.
+         * @param[in] a   Lower boundary (inclusive).
+         * @param[in] b   Upper boundary (inclusive). Must be >= @p a.
+         */
+        explicit param_type(result_type a = 0, result_type b = std::numeric_limits<result_type>::max())
+            : m_a(a)
+            , m_b(b)
+            , m_range(static_cast<WordType>(static_cast<UnsignedType>(static_cast<UnsignedType>(b) -
+                                                                      static_cast<UnsignedType>(a))) + 1u)
+            , m_threshold((m_range != 0) ? static_cast<WordType>(static_cast<WordType>(0u - m_range) % m_range) : 0u)
+        {
+        }
+
+        /// @brief Get lower boundary.
+        result_type a(void) const
+        {
+            return m_a;
+        }
+
+        /// @brief Get upper boundary.
+        result_type b(void) const
+        {
+            return m_b;
+        }
+
+        /// @brief Compare parameter sets for equality.
+        friend bool operator == (param_type const& lhs, param_type const& rhs)
+        {
+            return (lhs.m_a == rhs.m_a) && (lhs.m_b == rhs.m_b);
+        }
+
+        /// @brief Compare parameter sets for inequality.
+        friend bool operator != (param_type const& lhs, param_type const& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        friend class BoundedIntDistribution;
+
+        result_type m_a;
+        result_type m_b;
+        WordType    m_range;     // Number of possible values, 0 means 2^W.
+        WordType    m_threshold; // 2^W mod m_range, products below are rejected.
+    };
+
+    /**
+     * @brief Constructor.
+     * @param[in] a   Lower boundary (inclusive).
+     * @param[in] b   Upper boundary (inclusive). Must be >= @p a.
+     */
+    explicit BoundedIntDistribution(result_type a = 0, result_type b = std::numeric_limits<result_type>::max())
+        : m_param(a, b)
+    {
+    }
+
+    /**
+     * @brief Constructor.
+     * @param[in] param   Parameter set to use.
+     */
+    explicit BoundedIntDistribution(param_type const& param)
+        : m_param(param)
+    {
+    }
+
+    /// @brief Reset internal state. The distribution is stateless, this does nothing.
+    void reset(void)
+    {
+    }
+
+    /// @brief Get lower boundary.
+    result_type a(void) const
+    {
+        return m_param.a();
+    }
+
+    /// @brief Get upper boundary.
+    result_type b(void) const
+    {
+        return m_param.b();
+    }
+
+    /// @brief Get current parameter set.
+    param_type param(void) const
+    {
+        return m_param;
+    }
+
+    /// @brief Set new parameter set.
+    void param(param_type const& param)
+    {
+        m_param = param;
+    }
+
+    /// @brief Get smallest value that can be generated.
+    result_type min(void) const
+    {
+        return a();
+    }
+
+    /// @brief Get largest value that can be generated.
+    result_type max(void) const
+    {
+        return b();
+    }
+
+    /**
+     * @brief Generate next value using the current parameter set.
+     * @param[in] engine   Random engine to draw bits from.
+     * @returns value in [a, b].
+     */
+    template<typename E>
+    result_type operator () (E& engine)
+    {
+        return (*this)(engine, m_param);
+    }
+
+    /**
+     * @brief Generate next value using a given parameter set.
+     * @param[in] engine   Random engine to draw bits from.
+     * @param[in] param    Parameter set used for this call only.
+     * @returns value in [param.a(), param.b()].
+     */
+    template<typename E>
+    result_type operator () (E& engine, param_type const& param)
+    {
+        auto word = detail::uniformBits<WordType>(engine);
+        if (param.m_range == 0)
+        {
+            return offset(param.m_a, word);
+        }
+
+        auto hi = WordType();
+        auto lo = WordType();
+        detail::multiply(word, param.m_range, hi, lo);
+        while (lo < param.m_threshold)
+        {
+            detail::multiply(detail::uniformBits<WordType>(engine), param.m_range, hi, lo);
+        }
+        return offset(param.m_a, hi);
+    }
+
+    /**
+     * @brief Fill a range with values of the current parameter set.
+     * @note If the range is small enough, several values are extracted from a
+     *       single 64 bit engine word (Brackett-Rozinsky and Lemire, "Batched
+     *       Ranged Random Integer Generation", 2024). The produced sequence
+     *       therefore differs from calling operator () repeatedly.
+     * @param[in] first    Begin of the output range.
+     * @param[in] last     End of the output range.
+     * @param[in] engine   Random engine to draw bits from.
+     */
+    template<typename ForwardIt, typename E>
+    void generate(ForwardIt first, ForwardIt last, E& engine)
+    {
+        constexpr auto MAX_BATCH = 8u;
+
+        // Find out how many values fit into one 64 bit word.
+        auto range = static_cast<std::uint64_t>(m_param.m_range);
+        auto batch = 0u;
+        auto product = std::uint64_t(1);
+        while ((range != 0) && (batch < MAX_BATCH) && (product <= std::numeric_limits<std::uint64_t>::max() / range))
+        {
+            product *= range;
+            ++batch;
+        }
+
+        if (batch < 2u)
+        {
+            for (; first != last; ++first)
+            {
+                *first = (*this)(engine);
+            }
+            return;
+        }
+
+        auto threshold = static_cast<std::uint64_t>((0u - product) % product);
+        WordType values[MAX_BATCH];
+
+        while (first != last)
+        {
+            // Decompose floor(word * range^batch / 2^64) into its base range digits.
+            auto lo = std::uint64_t();
+            do
+            {
+                lo = detail::uniformBits<std::uint64_t>(engine);
+                for (auto i = 0u; i < batch; ++i)
+                {
+                    auto hi = std::uint64_t();
+                    detail::multiply(lo, range, hi, lo);
+                    values[i] = static_cast<WordType>(hi);
+                }
+            }
+            while (lo < threshold);
+
+            for (auto i = 0u; (i < batch) && (first != last); ++i, ++first)
+            {
+                *first = offset(m_param.m_a, values[i]);
+            }
+        }
+    }
+
+    /// @brief Compare distributions for equality.
+    friend bool operator == (BoundedIntDistribution const& lhs, BoundedIntDistribution const& rhs)
+    {
+        return lhs.m_param == rhs.m_param;
+    }
+
+    /// @brief Compare distributions for inequality.
+    friend bool operator != (BoundedIntDistribution const& lhs, BoundedIntDistribution const& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    static result_type offset(result_type a, WordType value)
+    {
+        return static_cast<result_type>(static_cast<UnsignedType>(static_cast<UnsignedType>(a) +
+                                                                  static_cast<UnsignedType>(value)));
+    }
+
+    param_type m_param;
+};
+
+} // namespace simons_lib::distributions
+
+#endif // BOUNDED_INT_DISTRIBUTION_IMPL_HPP_20190302101512
@@ -0,0 +1,256 @@
+/**
+ * @file      Detail.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Internal helpers shared by the distributions.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @cond DO_NOT_DOCUMENT
+ * @note Documentation for this file is suppressed to avoid
+ *       polluting the generated documentation with internal details.
+ */
+
+#ifndef DETAIL_HPP_20190302101512
+#define DETAIL_HPP_20190302101512
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <type_traits>
+
+namespace simons_lib::distributions::detail
+{
+
+// Number of uniformly distributed bits delivered by a single engine call.
+// Returns 0 if the engine range is not of the form [0, 2^n - 1].
+template<typename E>
+constexpr int engineBits(void)
+{
+    if (E::min() != 0)
+    {
+        return 0;
+    }
+
+    auto max = static_cast<std::uint64_t>(E::max());
+    auto bits = 0;
+    while (max & 1u)
+    {
+        ++bits;
+        max >>= 1;
+    }
+    return (max == 0) ? bits : 0;
+}
+
+// Draw a word of uniformly distributed bits from an arbitrary engine.
+// Engines covering a power of two range are used directly, all others
+// are adapted via std::uniform_int_distribution.
+template<typename U, typename E>
+inline U uniformBits(E& engine)
+{
+    static_assert(std::is_unsigned<U>::value);
+
+    constexpr auto bits = engineBits<E>();
+    constexpr auto digits = std::numeric_limits<U>::digits;
+
+    if constexpr (bits >= digits)
+    {
+        return static_cast<U>(static_cast<std::uint64_t>(engine()) >> (bits - digits));
+    }
+    else if constexpr (bits >= 16)
+    {
+        auto word = static_cast<U>(engine());
+        for (auto filled = bits; filled < digits; filled += bits)
+        {
+            word = static_cast<U>((word << bits) | static_cast<U>(engine()));
+        }
+        return word;
+    }
+    else
+    {
+        return std::uniform_int_distribution<U>()(engine);
+    }
+}
+
+// Full width multiplication: hi:lo = a * b.
+inline void multiply(std::uint32_t a, std::uint32_t b, std::uint32_t& hi, std::uint32_t& lo)
+{
+    auto product = static_cast<std::uint64_t>(a) * b;
+    hi = static_cast<std::uint32_t>(product >> 32);
+    lo = static_cast<std::uint32_t>(product);
+}
+
+inline void multiply(std::uint64_t a, std::uint64_t b, std::uint64_t& hi, std::uint64_t& lo)
+{
+#ifdef __SIZEOF_INT128__
+    __extension__ typedef unsigned __int128 Uint128;
+    auto product = static_cast<Uint128>(a) * b;
+    hi = static_cast<std::uint64_t>(product >> 64);
+    lo = static_cast<std::uint64_t>(product);
+#else
+    // Portable fallback using 32 bit partial products.
+    auto aLo = a & 0xFFFFFFFFu;
+    auto aHi = a >> 32;
+    auto bLo = b & 0xFFFFFFFFu;
+    auto bHi = b >> 32;
+
+    auto ll = aLo * bLo;
+    auto lh = aLo * bHi;
+    auto hl = aHi * bLo;
+    auto hh = aHi * bHi;
+
+    auto mid = (ll >> 32) + (lh & 0xFFFFFFFFu) + (hl & 0xFFFFFFFFu);
+    hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+    lo = (mid << 32) | (ll & 0xFFFFFFFFu);
+#endif
+}
+
+// Uniform value in [0, bound) for bound > 0 (Lemire's nearly divisionless method).
+// The modulo is only computed in the rare case that the product lands near a boundary.
+template<typename U, typename E>
+inline U uniformBelow(E& engine, U bound)
+{
+    static_assert(std::is_same<U, std::uint32_t>::value || std::is_same<U, std::uint64_t>::value);
+
+    auto hi = U();
+    auto lo = U();
+    multiply(uniformBits<U>(engine), bound, hi, lo);
+    if (lo < bound)
+    {
+        auto threshold = static_cast<U>(static_cast<U>(0u - bound) % bound);
+        while (lo < threshold)
+        {
+            multiply(uniformBits<U>(engine), bound, hi, lo);
+        }
+    }
+    return hi;
+}
+
+// Map the upper 53 bits of a word to a double in [0, 1).
+constexpr double toUnitInterval(std::uint64_t word)
+{
+    return static_cast<double>(word >> 11) * 0x1.0p-53;
+}
+
+// Map the upper 53 bits of a word to a double in (0, 1).
+constexpr double toOpenUnitInterval(std::uint64_t word)
+{
+    return (static_cast<double>(word >> 11) + 0.5) * 0x1.0p-53;
+}
+
+// Compile time replacements for std::exp, std::log and std::sqrt.
+// They are only used to build lookup tables, runtime code uses <cmath>.
+constexpr double LN2 = 0.693147180559945309417232121458176568;
+
+constexpr double constexprExp(double x)
+{
+    // exp(x) = 2^k * exp(r) with |r| <= ln(2) / 2
+    auto k = static_cast<long>((x < 0.0) ? (x / LN2 - 0.5) : (x / LN2 + 0.5));
+    auto r = x - static_cast<double>(k) * LN2;
+
+    auto sum = 1.0;
+    auto term = 1.0;
+    for (auto n = 1; n < 30; ++n)
+    {
+        term *= r / n;
+        sum += term;
+    }
+
+    for (; k > 0; --k)
+    {
+        sum *= 2.0;
+    }
+    for (; k < 0; ++k)
+    {
+        sum /= 2.0;
+    }
+    return sum;
+}
+
+constexpr double constexprLog(double x)
+{
+    // log(x) = e * ln(2) + log(m) with m in [1, 2)
+    auto e = 0;
+    while (x >= 2.0)
+    {
+        x /= 2.0;
+        ++e;
+    }
+    while (x < 1.0)
+    {
+        x *= 2.0;
+        --e;
+    }
+
+    // log(m) = 2 * atanh(z) with z = (m - 1) / (m + 1) <= 1/3
+    auto z = (x - 1.0) / (x + 1.0);
+    auto zSquare = z * z;
+    auto sum = 0.0;
+    auto term = z;
+    for (auto n = 1; n < 80; n += 2)
+    {
+        sum += term / n;
+        term *= zSquare;
+    }
+    return 2.0 * sum + e * LN2;
+}
+
+constexpr double constexprSqrt(double x)
+{
+    if (x <= 0.0)
+    {
+        return 0.0;
+    }
+
+    auto guess = (x < 1.0) ? 1.0 : x;
+    for (auto i = 0; i < 2048; ++i)
+    {
+        auto next = 0.5 * (guess + x / guess);
+        if (next == guess)
+        {
+            break;
+        }
+        guess = next;
+    }
+    return guess;
+}
+
+} // namespace simons_lib::distributions::detail
+#endif // DETAIL_HPP_20190302101512
+
+/**
+ * @endcond DO_NOT_DOCUMENT
+ */
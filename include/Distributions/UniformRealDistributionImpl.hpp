@@ -0,0 +1,374 @@
+/**
+ * @file      UniformRealDistributionImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Uniform floating point distribution built directly from mantissa bits.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UNIFORM_REAL_DISTRIBUTION_IMPL_HPP_20190420093512
+#define UNIFORM_REAL_DISTRIBUTION_IMPL_HPP_20190420093512
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include "Detail.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace simons_lib::distributions
+{
+
+/// @cond DO_NOT_DOCUMENT
+namespace detail
+{
+
+// Bit pattern of 1.0 as double and float.
+constexpr std::uint64_t DOUBLE_ONE_BITS = 0x3FF0000000000000u;
+constexpr std::uint32_t FLOAT_ONE_BITS = 0x3F800000u;
+
+// Map the upper 24 bits of a word to a float in [0, 1).
+constexpr float toUnitIntervalFloat(std::uint32_t word)
+{
+    return static_cast<float>(word >> 8) * 0x1.0p-24f;
+}
+
+// Exponent trick: Place the upper 52 bits of a word in the mantissa of a
+// double in [1, 2) and subtract 1. Needs no integer to floating point conversion.
+inline double toUnitIntervalExponent(std::uint64_t word)
+{
+    auto bits = (word >> 12) | DOUBLE_ONE_BITS;
+    auto value = double();
+    std::memcpy(&value, &bits, sizeof(value));
+    return value - 1.0;
+}
+
+inline float toUnitIntervalExponent(std::uint32_t word)
+{
+    auto bits = (word >> 9) | FLOAT_ONE_BITS;
+    auto value = float();
+    std::memcpy(&value, &bits, sizeof(value));
+    return value - 1.0f;
+}
+
+// Convert a block of words to doubles in [offset, offset + scale) in one pass.
+// Uses AVX2 or SSE2 if enabled at compile time, results are identical for all paths.
+inline void toIntervalBlock(std::uint64_t const* words, double* values, std::size_t count,
+                            double offset, double scale)
+{
+    auto i = std::size_t(0);
+
+#if defined(__AVX2__)
+    auto const oneBits = _mm256_set1_epi64x(static_cast<long long>(DOUBLE_ONE_BITS));
+    auto const one = _mm256_set1_pd(1.0);
+    auto const vOffset = _mm256_set1_pd(offset);
+    auto const vScale = _mm256_set1_pd(scale);
+    for (; i + 4u <= count; i += 4u)
+    {
+        auto word = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(words + i));
+        auto bits = _mm256_or_si256(_mm256_srli_epi64(word, 12), oneBits);
+        auto unit = _mm256_sub_pd(_mm256_castsi256_pd(bits), one);
+        _mm256_storeu_pd(values + i, _mm256_add_pd(vOffset, _mm256_mul_pd(unit, vScale)));
+    }
+#elif defined(__SSE2__)
+    auto const oneBits = _mm_set1_epi64x(static_cast<long long>(DOUBLE_ONE_BITS));
+    auto const one = _mm_set1_pd(1.0);
+    auto const vOffset = _mm_set1_pd(offset);
+    auto const vScale = _mm_set1_pd(scale);
+    for (; i + 2u <= count; i += 2u)
+    {
+        auto word = _mm_loadu_si128(reinterpret_cast<__m128i const*>(words + i));
+        auto bits = _mm_or_si128(_mm_srli_epi64(word, 12), oneBits);
+        auto unit = _mm_sub_pd(_mm_castsi128_pd(bits), one);
+        _mm_storeu_pd(values + i, _mm_add_pd(vOffset, _mm_mul_pd(unit, vScale)));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        values[i] = offset + toUnitIntervalExponent(words[i]) * scale;
+    }
+}
+
+} // namespace detail
+/// @endcond
+
+/**
+ * @brief Drop-in replacement for std::uniform_real_distribution.
+ * @note Values are built directly from engine bits instead of the generic
+ *       std::generate_canonical. A double takes the upper 53 bits of a 64 bit
+ *       word multiplied by 2^-53, a float the upper 24 bits of a 32 bit word
+ *       multiplied by 2^-24. An engine delivering at least that word width
+ *       per call (e.g. std::mt19937_64, or std::mt19937 for float) is called
+ *       once. Engines with a range of [0, 2^n - 1], n >= 16, are
+ *       called ceil(64 / n) or ceil(32 / n) times to fill the word (twice for
+ *       std::mt19937 and double). All other engines, e.g. std::minstd_rand,
+ *       are adapted via std::uniform_int_distribution and may consume a
+ *       varying number of values.
+ * @note As with std::uniform_real_distribution, rounding of a + (b - a) * u
+ *       may yield b for some boundaries.
+ * @tparam T   Floating point type of generated values.
+ */
+template<typename T = double>
+class UniformRealDistribution
+{
+    static_assert(std::is_floating_point<T>::value);
+
+public:
+    /// @brief Type of generated values.
+    using result_type = T;
+
+    /**
+     * @brief Parameter set of UniformRealDistribution.
+     */
+    class param_type
+    {
+    public:
+        /// @brief Type of the owning distribution.
+        using distribution_type = UniformRealDistribution;
+
+        /**
+         * @brief Constructor.
+         * @param[in] a   Lower boundary (inclusive).
+         * @param[in] b   Upper boundary (exclusive). Must be >= @p a.
+         */
+        explicit param_type(result_type a = 0, result_type b = 1)
+            : m_a(a)
+            , m_b(b)
+        {
+        }
+
+        /// @brief Get lower boundary.
+        result_type a(void) const
+        {
+            return m_a;
+        }
+
+        /// @brief Get upper boundary.
+        result_type b(void) const
+        {
+            return m_b;
+        }
+
+        /// @brief Compare parameter sets for equality.
+        friend bool operator == (param_type const& lhs, param_type const& rhs)
+        {
+            return (lhs.m_a == rhs.m_a) && (lhs.m_b == rhs.m_b);
+        }
+
+        /// @brief Compare parameter sets for inequality.
+        friend bool operator != (param_type const& lhs, param_type const& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        result_type m_a;
+        result_type m_b;
+    };
+
+    /**
+     * @brief Constructor.
+     * @param[in] a   Lower boundary (inclusive).
+     * @param[in] b   Upper boundary (exclusive). Must be >= @p a.
+     */
+    explicit UniformRealDistribution(result_type a = 0, result_type b = 1)
+        : m_param(a, b)
+    {
+    }
+
+    /**
+     * @brief Constructor.
+     * @param[in] param   Parameter set to use.
+     */
+    explicit UniformRealDistribution(param_type const& param)
+        : m_param(param)
+    {
+    }
+
+    /// @brief Reset internal state. The distribution is stateless, this does nothing.
+    void reset(void)
+    {
+    }
+
+    /// @brief Get lower boundary.
+    result_type a(void) const
+    {
+        return m_param.a();
+    }
+
+    /// @brief Get upper boundary.
+    result_type b(void) const
+    {
+        return m_param.b();
+    }
+
+    /// @brief Get current parameter set.
+    param_type param(void) const
+    {
+        return m_param;
+    }
+
+    /// @brief Set new parameter set.
+    void param(param_type const& param)
+    {
+        m_param = param;
+    }
+
+    /// @brief Get smallest value that can be generated.
+    result_type min(void) const
+    {
+        return a();
+    }
+
+    /// @brief Get upper boundary of generated values.
+    result_type max(void) const
+    {
+        return b();
+    }
+
+    /**
+     * @brief Generate next value using the current parameter set.
+     * @param[in] engine   Random engine to draw bits from.
+     * @returns value in [a, b).
+     */
+    template<typename E>
+    result_type operator () (E& engine)
+    {
+        return (*this)(engine, m_param);
+    }
+
+    /**
+     * @brief Generate next value using a given parameter set.
+     * @param[in] engine   Random engine to draw bits from.
+     * @param[in] param    Parameter set used for this call only.
+     * @returns value in [param.a(), param.b()).
+     */
+    template<typename E>
+    result_type operator () (E& engine, param_type const& param)
+    {
+        return param.a() + (param.b() - param.a()) * unit(engine);
+    }
+
+    /**
+     * @brief Fill a range with values of the current parameter set.
+     * @note Engine words are collected block wise and converted in a single
+     *       pass. Doubles use the exponent trick, which vectorizes with
+     *       SSE2/AVX2, and therefore carry 52 instead of 53 random bits. The
+     *       produced sequence differs from calling operator () repeatedly.
+     * @param[in] first    Begin of the output range.
+     * @param[in] last     End of the output range.
+     * @param[in] engine   Random engine to draw bits from.
+     */
+    template<typename ForwardIt, typename E>
+    void generate(ForwardIt first, ForwardIt last, E& engine)
+    {
+        if constexpr (std::is_same<result_type, double>::value)
+        {
+            constexpr auto BLOCK = std::size_t(64);
+            std::uint64_t words[BLOCK];
+            double values[BLOCK];
+
+            auto remaining = static_cast<std::size_t>(std::distance(first, last));
+            while (remaining > 0)
+            {
+                auto count = (remaining < BLOCK) ? remaining : BLOCK;
+                for (auto i = std::size_t(0); i < count; ++i)
+                {
+                    words[i] = detail::uniformBits<std::uint64_t>(engine);
+                }
+
+                detail::toIntervalBlock(words, values, count, a(), b() - a());
+                first = std::copy(values, values + count, first);
+                remaining -= count;
+            }
+        }
+        else if constexpr (std::is_same<result_type, float>::value)
+        {
+            auto scale = b() - a();
+            for (; first != last; ++first)
+            {
+                *first = a() + detail::toUnitIntervalExponent(detail::uniformBits<std::uint32_t>(engine)) * scale;
+            }
+        }
+        else
+        {
+            for (; first != last; ++first)
+            {
+                *first = (*this)(engine);
+            }
+        }
+    }
+
+    /// @brief Compare distributions for equality.
+    friend bool operator == (UniformRealDistribution const& lhs, UniformRealDistribution const& rhs)
+    {
+        return lhs.m_param == rhs.m_param;
+    }
+
+    /// @brief Compare distributions for inequality.
+    friend bool operator != (UniformRealDistribution const& lhs, UniformRealDistribution const& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    // Uniform value in [0, 1) from a single engine word.
+    template<typename E>
+    static result_type unit(E& engine)
+    {
+        if constexpr (std::is_same<result_type, float>::value)
+        {
+            return detail::toUnitIntervalFloat(detail::uniformBits<std::uint32_t>(engine));
+        }
+        else
+        {
+            return static_cast<result_type>(detail::toUnitInterval(detail::uniformBits<std::uint64_t>(engine)));
+        }
+    }
+
+    param_type m_param;
+};
+
+} // namespace simons_lib::distributions
+
+#endif // UNIFORM_REAL_DISTRIBUTION_IMPL_HPP_20190420093512
@@ -0,0 +1,623 @@
+/**
+ * @file      ZigguratImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Ziggurat based normal and exponential distributions.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ZIGGURAT_IMPL_HPP_20190309143307
+#define ZIGGURAT_IMPL_HPP_20190309143307
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include "Detail.hpp"
+
+namespace simons_lib::distributions
+{
+
+/// @cond DO_NOT_DOCUMENT
+namespace detail
+{
+
+// Number of layers of the ziggurat. The layer index is taken from the lowest 8 bits.
+constexpr std::size_t ZIGGURAT_LAYERS = 256;
+
+// Layer boundaries x and pdf values f = pdf(x) for a monotone decreasing
+// density on [0, inf). x[0] is the width of the virtual base layer, x[1] = r
+// and x[ZIGGURAT_LAYERS] = 0.
+struct ZigguratTables
+{
+    double x[ZIGGURAT_LAYERS + 1];
+    double f[ZIGGURAT_LAYERS + 1];
+};
+
+// Build tables for a density pdf with inverse pdfInv, tail start r and layer area v.
+constexpr ZigguratTables makeZigguratTables(double r, double v, double (*pdf)(double), double (*pdfInv)(double))
+{
+    auto tables = ZigguratTables{{}, {}};
+    tables.x[0] = v / pdf(r);
+    tables.x[1] = r;
+    for (auto i = std::size_t(1); i < ZIGGURAT_LAYERS - 1; ++i)
+    {
+        auto y = pdf(tables.x[i]) + v / tables.x[i];
+        tables.x[i + 1] = (y < 1.0) ? pdfInv(y) : 0.0;
+    }
+    tables.x[ZIGGURAT_LAYERS] = 0.0;
+
+    for (auto i = std::size_t(0); i <= ZIGGURAT_LAYERS; ++i)
+    {
+        tables.f[i] = pdf(tables.x[i]);
+    }
+    return tables;
+}
+
+// Unnormalized standard normal density and its inverse.
+constexpr double normalPdf(double x)
+{
+    return constexprExp(-0.5 * x * x);
+}
+
+constexpr double normalPdfInv(double y)
+{
+    return constexprSqrt(-2.0 * constexprLog(y));
+}
+
+// Standard exponential density and its inverse.
+constexpr double exponentialPdf(double x)
+{
+    return constexprExp(-x);
+}
+
+constexpr double exponentialPdfInv(double y)
+{
+    return -constexprLog(y);
+}
+
+// Tail start and layer area for 256 layers (Marsaglia and Tsang, 2000).
+constexpr double ZIGGURAT_NORMAL_R = 3.6541528853610088;
+constexpr double ZIGGURAT_NORMAL_V = 0.00492867323399;
+constexpr double ZIGGURAT_EXPONENTIAL_R = 7.69711747013104972;
+constexpr double ZIGGURAT_EXPONENTIAL_V = 0.0039496598225815571993;
+
+inline constexpr ZigguratTables ZIGGURAT_NORMAL = makeZigguratTables(ZIGGURAT_NORMAL_R, ZIGGURAT_NORMAL_V,
+                                                                     normalPdf, normalPdfInv);
+inline constexpr ZigguratTables ZIGGURAT_EXPONENTIAL = makeZigguratTables(ZIGGURAT_EXPONENTIAL_R,
+                                                                          ZIGGURAT_EXPONENTIAL_V,
+                                                                          exponentialPdf,
+                                                                          exponentialPdfInv);
+
+// Ziggurat sampler for a symmetric (normal) or one sided (exponential) density.
+// Word layout: bits 0-7 layer index, bit 8 sign, bits 11-63 uniform fraction.
+template<bool Symmetric>
+class Ziggurat
+{
+public:
+    // Fast path. Returns false if the sample needs further processing by slowPath().
+    static bool fastPath(std::uint64_t word, double& value)
+    {
+        auto const& tables = Symmetric ? ZIGGURAT_NORMAL : ZIGGURAT_EXPONENTIAL;
+        auto layer = static_cast<std::size_t>(word & 0xFFu);
+        auto x = toUnitInterval(word) * tables.x[layer];
+        value = applySign(word, x);
+        return x < tables.x[layer + 1];
+    }
+
+    // Complete the sampling process for a word rejected by fastPath().
+    template<typename E>
+    static double slowPath(E& engine, std::uint64_t word)
+    {
+        auto const& tables = Symmetric ? ZIGGURAT_NORMAL : ZIGGURAT_EXPONENTIAL;
+        while (true)
+        {
+            auto layer = static_cast<std::size_t>(word & 0xFFu);
+            auto x = toUnitInterval(word) * tables.x[layer];
+            if (x < tables.x[layer + 1])
+            {
+                return applySign(word, x);
+            }
+
+            if (layer == 0)
+            {
+                return applySign(word, tail(engine));
+            }
+
+            auto y = tables.f[layer] + (tables.f[layer + 1] - tables.f[layer]) *
+                                       toUnitInterval(uniformBits<std::uint64_t>(engine));
+            if (y < pdf(x))
+            {
+                return applySign(word, x);
+            }
+            word = uniformBits<std::uint64_t>(engine);
+        }
+    }
+
+    template<typename E>
+    static double sample(E& engine)
+    {
+        auto word = uniformBits<std::uint64_t>(engine);
+        auto value = 0.0;
+        if (fastPath(word, value))
+        {
+            return value;
+        }
+        return slowPath(engine, word);
+    }
+
+private:
+    static double applySign(std::uint64_t word, double x)
+    {
+        if constexpr (Symmetric)
+        {
+            return ((word >> 8) & 1u) ? -x : x;
+        }
+        else
+        {
+            return x;
+        }
+    }
+
+    static double pdf(double x)
+    {
+        if constexpr (Symmetric)
+        {
+            return std::exp(-0.5 * x * x);
+        }
+        else
+        {
+            return std::exp(-x);
+        }
+    }
+
+    template<typename E>
+    static double tail(E& engine)
+    {
+        if constexpr (Symmetric)
+        {
+            // Marsaglia's method for the normal tail beyond r.
+            auto x = 0.0;
+            auto y = 0.0;
+            do
+            {
+                x = std::log(toOpenUnitInterval(uniformBits<std::uint64_t>(engine))) / ZIGGURAT_NORMAL_R;
+                y = std::log(toOpenUnitInterval(uniformBits<std::uint64_t>(engine)));
+            }
+            while (-2.0 * y < x * x);
+            return ZIGGURAT_NORMAL_R - x;
+        }
+        else
+        {
+            // The exponential distribution is memoryless.
+            return ZIGGURAT_EXPONENTIAL_R - std::log(toOpenUnitInterval(uniformBits<std::uint64_t>(engine)));
+        }
+    }
+};
+
+// Fill a range with samples. Candidates are produced block wise by the branch
+// free fast path, the rare rejected candidates are completed afterwards.
+template<bool Symmetric, typename ForwardIt, typename E, typename Transform>
+void zigguratGenerate(ForwardIt first, ForwardIt last, E& engine, Transform transform)
+{
+    constexpr auto BLOCK = std::size_t(64);
+    std::uint64_t words[BLOCK];
+    double values[BLOCK];
+    bool accepted[BLOCK];
+
+    auto remaining = static_cast<std::size_t>(std::distance(first, last));
+    while (remaining > 0)
+    {
+        auto count = (remaining < BLOCK) ? remaining : BLOCK;
+        auto allAccepted = true;
+        for (auto i = std::size_t(0); i < count; ++i)
+        {
+            words[i] = uniformBits<std::uint64_t>(engine);
+            accepted[i] = Ziggurat<Symmetric>::fastPath(words[i], values[i]);
+            allAccepted &= accepted[i];
+        }
+
+        if (!allAccepted)
+        {
+            for (auto i = std::size_t(0); i < count; ++i)
+            {
+                if (!accepted[i])
+                {
+                    values[i] = Ziggurat<Symmetric>::slowPath(engine, words[i]);
+                }
+            }
+        }
+
+        for (auto i = std::size_t(0); i < count; ++i, ++first)
+        {
+            *first = transform(values[i]);
+        }
+        remaining -= count;
+    }
+}
+
+} // namespace detail
+/// @endcond
+
+/**
+ * @brief Drop-in replacement for std::normal_distribution.
+ * @note Uses the Ziggurat method with 256 layers (Marsaglia and Tsang, 2000).
+ *       About 99% of all samples cost one engine call, one table lookup and
+ *       one multiplication. Lookup tables are computed at compile time.
+ * @tparam T   Floating point type of generated values.
+ */
+template<typename T = double>
+class ZigguratNormalDistribution
+{
+    static_assert(std::is_floating_point<T>::value);
+
+public:
+    /// @brief Type of generated values.
+    using result_type = T;
+
+    /**
+     * @brief Parameter set of ZigguratNormalDistribution.
+     */
+    class param_type
+    {
+    public:
+        /// @brief Type of the owning distribution.
+        using distribution_type = ZigguratNormalDistribution;
+
+        /**
+         * @brief Constructor.
+         * @param[in] mean     Mean of the distribution.
+         * @param[in] stddev   Standard deviation of the distribution.
+         */
+        explicit param_type(result_type mean = 0, result_type stddev = 1)
+            : m_mean(mean)
+            , m_stddev(stddev)
+        {
+        }
+
+        /// @brief Get mean.
+        result_type mean(void) const
+        {
+            return m_mean;
+        }
+
+        /// @brief Get standard deviation.
+        result_type stddev(void) const
+        {
+            return m_stddev;
+        }
+
+        /// @brief Compare parameter sets for equality.
+        friend bool operator == (param_type const& lhs, param_type const& rhs)
+        {
+            return (lhs.m_mean == rhs.m_mean) && (lhs.m_stddev == rhs.m_stddev);
+        }
+
+        /// @brief Compare parameter sets for inequality.
+        friend bool operator != (param_type const& lhs, param_type const& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        result_type m_mean;
+        result_type m_stddev;
+    };
+
+    /**
+     * @brief Constructor.
+     * @param[in] mean     Mean of the distribution.
+     * @param[in] stddev   Standard deviation of the distribution.
+     */
+    explicit ZigguratNormalDistribution(result_type mean = 0, result_type stddev = 1)
+        : m_param(mean, stddev)
+    {
+    }
+
+    /**
+     * @brief Constructor.
+     * @param[in] param   Parameter set to use.
+     */
+    explicit ZigguratNormalDistribution(param_type const& param)
+        : m_param(param)
+    {
+    }
+
+    /// @brief Reset internal state. The distribution is stateless, this does nothing.
+    void reset(void)
+    {
+    }
+
+    /// @brief Get mean.
+    result_type mean(void) const
+    {
+        return m_param.mean();
+    }
+
+    /// @brief Get standard deviation.
+    result_type stddev(void) const
+    {
+        return m_param.stddev();
+    }
+
+    /// @brief Get current parameter set.
+    param_type param(void) const
+    {
+        return m_param;
+    }
+
+    /// @brief Set new parameter set.
+    void param(param_type const& param)
+    {
+        m_param = param;
+    }
+
+    /// @brief Get smallest value that can be generated.
+    result_type min(void) const
+    {
+        return std::numeric_limits<result_type>::lowest();
+    }
+
+    /// @brief Get largest value that can be generated.
+    result_type max(void) const
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    /**
+     * @brief Generate next value using the current parameter set.
+     * @param[in] engine   Random engine to draw bits from.
+     * @returns normally distributed value.
+     */
+    template<typename E>
+    result_type operator () (E& engine)
+    {
+        return (*this)(engine, m_param);
+    }
+
+    /**
+     * @brief Generate next value using a given parameter set.
+     * @param[in] engine   Random engine to draw bits from.
+     * @param[in] param    Parameter set used for this call only.
+     * @returns normally distributed value.
+     */
+    template<typename E>
+    result_type operator () (E& engine, param_type const& param)
+    {
+        auto z = detail::Ziggurat<true>::sample(engine);
+        return static_cast<result_type>(param.mean() + param.stddev() * z);
+    }
+
+    /**
+     * @brief Fill a range with values of the current parameter set.
+     * @param[in] first    Begin of the output range.
+     * @param[in] last     End of the output range.
+     * @param[in] engine   Random engine to draw bits from.
+     */
+    template<typename ForwardIt, typename E>
+    void generate(ForwardIt first, ForwardIt last, E& engine)
+    {
+        auto mean = static_cast<double>(m_param.mean());
+        auto stddev = static_cast<double>(m_param.stddev());
+        detail::zigguratGenerate<true>(first, last, engine, [mean, stddev] (double z)
+        {
+            return static_cast<result_type>(mean + stddev * z);
+        });
+    }
+
+    /// @brief Compare distributions for equality.
+    friend bool operator == (ZigguratNormalDistribution const& lhs, ZigguratNormalDistribution const& rhs)
+    {
+        return lhs.m_param == rhs.m_param;
+    }
+
+    /// @brief Compare distributions for inequality.
+    friend bool operator != (ZigguratNormalDistribution const& lhs, ZigguratNormalDistribution const& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    param_type m_param;
+};
+
+/**
+ * @brief Drop-in replacement for std::exponential_distribution.
+ * @note Uses the Ziggurat method with 256 layers (Marsaglia and Tsang, 2000).
+ *       Lookup tables are computed at compile time.
+ * @tparam T   Floating point type of generated values.
+ */
+template<typename T = double>
+class ZigguratExponentialDistribution
+{
+    static_assert(std::is_floating_point<T>::value);
+
+public:
+    /// @brief Type of generated values.
+    using result_type = T;
+
+    /**
+     * @brief Parameter set of ZigguratExponentialDistribution.
+     */
+    class param_type
+    {
+    public:
+        /// @brief Type of the owning distribution.
+        using distribution_type = ZigguratExponentialDistribution;
+
+        /**
+         * @brief Constructor.
+         * @param[in] lambda   Rate of the distribution. Must be > 0.
+         */
+        explicit param_type(result_type lambda = 1)
+            : m_lambda(lambda)
+        {
+        }
+
+        /// @brief Get rate.
+        result_type lambda(void) const
+        {
+            return m_lambda;
+        }
+
+        /// @brief Compare parameter sets for equality.
+        friend bool operator == (param_type const& lhs, param_type const& rhs)
+        {
+            return lhs.m_lambda == rhs.m_lambda;
+        }
+
+        /// @brief Compare parameter sets for inequality.
+        friend bool operator != (param_type const& lhs, param_type const& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        result_type m_lambda;
+    };
+
+    /**
+     * @brief Constructor.
+     * @param[in] lambda   Rate of the distribution. Must be > 0.
+     */
+    explicit ZigguratExponentialDistribution(result_type lambda = 1)
+        : m_param(lambda)
+    {
+    }
+
+    /**
+     * @brief Constructor.
+     * @param[in] param   Parameter set to use.
+     */
+    explicit ZigguratExponentialDistribution(param_type const& param)
+        : m_param(param)
+    {
+    }
+
+    /// @brief Reset internal state. The distribution is stateless, this does nothing.
+    void reset(void)
+    {
+    }
+
+    /// @brief Get rate.
+    result_type lambda(void) const
+    {
+        return m_param.lambda();
+    }
+
+    /// @brief Get current parameter set.
+    param_type param(void) const
+    {
+        return m_param;
+    }
+
+    /// @brief Set new parameter set.
+    void param(param_type const& param)
+    {
+        m_param = param;
+    }
+
+    /// @brief Get smallest value that can be generated.
+    result_type min(void) const
+    {
+        return 0;
+    }
+
+    /// @brief Get largest value that can be generated.
+    result_type max(void) const
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    /**
+     * @brief Generate next value using the current parameter set.
+     * @param[in] engine   Random engine to draw bits from.
+     * @returns exponentially distributed value.
+     */
+    template<typename E>
+    result_type operator () (E& engine)
+    {
+        return (*this)(engine, m_param);
+    }
+
+    /**
+     * @brief Generate next value using a given parameter set.
+     * @param[in] engine   Random engine to draw bits from.
+     * @param[in] param    Parameter set used for this call only.
+     * @returns exponentially distributed value.
+     */
+    template<typename E>
+    result_type operator () (E& engine, param_type const& param)
+    {
+        return static_cast<result_type>(detail::Ziggurat<false>::sample(engine) / param.lambda());
+    }
+
+    /**
+     * @brief Fill a range with values of the current parameter set.
+     * @param[in] first    Begin of the output range.
+     * @param[in] last     End of the output range.
+     * @param[in] engine   Random engine to draw bits from.
+     */
+    template<typename ForwardIt, typename E>
+    void generate(ForwardIt first, ForwardIt last, E& engine)
+    {
+        auto scale = 1.0 / static_cast<double>(m_param.lambda());
+        detail::zigguratGenerate<false>(first, last, engine, [scale] (double z)
+        {
+            return static_cast<result_type>(scale * z);
+        });
+    }
+
+    /// @brief Compare distributions for equality.
+    friend bool operator == (ZigguratExponentialDistribution const& lhs, ZigguratExponentialDistribution const& rhs)
+    {
+        return lhs.m_param == rhs.m_param;
+    }
+
+    /// @brief Compare distributions for inequality.
+    friend bool operator != (ZigguratExponentialDistribution const& lhs, ZigguratExponentialDistribution const& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    param_type m_param;
+};
+
+} // namespace simons_lib::distributions
+
+#endif // ZIGGURAT_IMPL_HPP_20190309143307
@@ -0,0 +1,172 @@
+/**
+ * @file      Pcg32Impl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     PCG32 random engine with 16 bytes of state.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PCG32_IMPL_HPP_20190511084517
+#define PCG32_IMPL_HPP_20190511084517
+
+#include <cstdint>
+#include <limits>
+
+namespace simons_lib::engines
+{
+
+/**
+ * @brief PCG32 random engine (M. E. O'Neill, "PCG: A Family of Simple Fast
+ *        Space-Efficient Statistically Good Algorithms for Random Number
+ *        Generation", 2014).
+ * @note 64 bit LCG state with a 32 bit XSH-RR output permutation. The state is
+ *       16 bytes (state and stream increment). The only multiplication is the
+ *       low half of a 64 bit product, which 32 bit targets compute with three
+ *       32 bit multiplications. discard() jumps ahead in O(log n) steps.
+ */
+class Pcg32
+{
+public:
+    /// @brief Type of generated values.
+    using result_type = std::uint32_t;
+
+    /// @brief Seed used by the default constructor.
+    static constexpr std::uint64_t DEFAULT_SEED = 0x853C49E6748FEA9Bu;
+    /// @brief Stream used if none is given.
+    static constexpr std::uint64_t DEFAULT_STREAM = 0xDA3E39CB94B95BDBu;
+
+    /**
+     * @brief Constructor.
+     * @param[in] seed     Initial state.
+     * @param[in] stream   Stream selector. Engines with different streams produce different sequences.
+     */
+    explicit Pcg32(std::uint64_t seed = DEFAULT_SEED, std::uint64_t stream = DEFAULT_STREAM)
+        : m_state(0)
+        , m_increment(0)
+    {
+        this->seed(seed, stream);
+    }
+
+    /// @brief Get smallest value that can be generated.
+    static constexpr result_type min(void)
+    {
+        return 0;
+    }
+
+    /// @brief Get largest value that can be generated.
+    static constexpr result_type max(void)
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    /**
+     * @brief Reinitialize the engine.
+     * @param[in] seed     Initial state.
+     * @param[in] stream   Stream selector.
+     */
+    void seed(std::uint64_t seed = DEFAULT_SEED, std::uint64_t stream = DEFAULT_STREAM)
+    {
+        m_state = 0;
+        m_increment = (stream << 1) | 1u;
+        step();
+        m_state += seed;
+        step();
+    }
+
+    /**
+     * @brief Get next random number.
+     * @returns random number
+     */
+    result_type operator () (void)
+    {
+        auto old = m_state;
+        step();
+        auto xorShifted = static_cast<std::uint32_t>(((old >> 18) ^ old) >> 27);
+        auto rotation = static_cast<std::uint32_t>(old >> 59);
+        return (xorShifted >> rotation) | (xorShifted << ((0u - rotation) & 31u));
+    }
+
+    /**
+     * @brief Skip random numbers as if operator () was called @p count times.
+     * @param[in] count   Number of values to skip.
+     */
+    void discard(unsigned long long count)
+    {
+        // Square and multiply over the affine LCG step (F. Brown, "Random Number
+        // Generation with Arbitrary Stride", 1994).
+        auto multiplier = MULTIPLIER;
+        auto increment = m_increment;
+        auto accMultiplier = std::uint64_t(1);
+        auto accIncrement = std::uint64_t(0);
+        for (; count > 0; count >>= 1)
+        {
+            if (count & 1u)
+            {
+                accMultiplier *= multiplier;
+                accIncrement = accIncrement * multiplier + increment;
+            }
+            increment = (multiplier + 1u) * increment;
+            multiplier *= multiplier;
+        }
+        m_state = accMultiplier * m_state + accIncrement;
+    }
+
+    /// @brief Compare engines for equality of their state.
+    friend bool operator == (Pcg32 const& lhs, Pcg32 const& rhs)
+    {
+        return (lhs.m_state == rhs.m_state) && (lhs.m_increment == rhs.m_increment);
+    }
+
+    /// @brief Compare engines for inequality of their state.
+    friend bool operator != (Pcg32 const& lhs, Pcg32 const& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    static constexpr std::uint64_t MULTIPLIER = 6364136223846793005u;
+
+    void step(void)
+    {
+        m_state = m_state * MULTIPLIER + m_increment;
+    }
+
+    std::uint64_t m_state;
+    std::uint64_t m_increment; // Always odd.
+};
+
+} // namespace simons_lib::engines
+
+#endif // PCG32_IMPL_HPP_20190511084517
@@ -0,0 +1,139 @@
+/**
+ * @file      SplitMix64Impl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     SplitMix64 random engine with 8 bytes of state.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SPLIT_MIX64_IMPL_HPP_20190511084517
+#define SPLIT_MIX64_IMPL_HPP_20190511084517
+
+#include <cstdint>
+#include <limits>
+
+namespace simons_lib::engines
+{
+
+/**
+ * @brief SplitMix64 random engine (G. L. Steele, D. Lea and C. H. Flood,
+ *        "Fast Splittable Pseudorandom Number Generators", 2014).
+ * @note A Weyl sequence passed through a 64 bit finalizer. The state is 8 bytes,
+ *       every seed is valid and discard() is O(1). The finalizer needs two
+ *       64 bit multiplications (low halves only), which 32 bit targets compute
+ *       with three 32 bit multiplications each.
+ */
+class SplitMix64
+{
+public:
+    /// @brief Type of generated values.
+    using result_type = std::uint64_t;
+
+    /// @brief Seed used by the default constructor.
+    static constexpr result_type DEFAULT_SEED = 0;
+
+    /**
+     * @brief Constructor.
+     * @param[in] seed   Initial state.
+     */
+    explicit SplitMix64(result_type seed = DEFAULT_SEED)
+        : m_state(seed)
+    {
+    }
+
+    /// @brief Get smallest value that can be generated.
+    static constexpr result_type min(void)
+    {
+        return 0;
+    }
+
+    /// @brief Get largest value that can be generated.
+    static constexpr result_type max(void)
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    /**
+     * @brief Reinitialize the engine.
+     * @param[in] seed   Initial state.
+     */
+    void seed(result_type seed = DEFAULT_SEED)
+    {
+        m_state = seed;
+    }
+
+    /**
+     * @brief Get next random number.
+     * @returns random number
+     */
+    result_type operator () (void)
+    {
+        m_state += GAMMA;
+        auto z = m_state;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9u;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBu;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * @brief Skip random numbers as if operator () was called @p count times.
+     * @param[in] count   Number of values to skip.
+     */
+    void discard(unsigned long long count)
+    {
+        m_state += GAMMA * count;
+    }
+
+    /// @brief Compare engines for equality of their state.
+    friend bool operator == (SplitMix64 const& lhs, SplitMix64 const& rhs)
+    {
+        return lhs.m_state == rhs.m_state;
+    }
+
+    /// @brief Compare engines for inequality of their state.
+    friend bool operator != (SplitMix64 const& lhs, SplitMix64 const& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    static constexpr result_type GAMMA = 0x9E3779B97F4A7C15u;
+
+    result_type m_state;
+};
+
+} // namespace simons_lib::engines
+
+#endif // SPLIT_MIX64_IMPL_HPP_20190511084517
@@ -0,0 +1,158 @@
+/**
+ * @file      XorShiftImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Marsaglia xorshift random engines with 4 and 8 bytes of state.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef XOR_SHIFT_IMPL_HPP_20190511084517
+#define XOR_SHIFT_IMPL_HPP_20190511084517
+
+#include <cstdint>
+#include <limits>
+
+namespace simons_lib::engines
+{
+
+/**
+ * @brief Generic xorshift random engine (G. Marsaglia, "Xorshift RNGs", 2003).
+ * @note Uses shifts and XORs only, no multiplication at all. The state must
+ *       never be zero, a zero seed is therefore replaced by DEFAULT_SEED.
+ *       Each engine has a period of 2^w - 1. The lowest bits of xorshift
+ *       engines fail some statistical tests, prefer Pcg32 if quality matters.
+ * @tparam U   Unsigned word type holding the state.
+ * @tparam A   First left shift.
+ * @tparam B   Right shift.
+ * @tparam C   Second left shift.
+ * @tparam S   Seed used by the default constructor and in place of 0.
+ */
+template<typename U, unsigned A, unsigned B, unsigned C, U S>
+class XorShiftEngine
+{
+    static_assert(std::numeric_limits<U>::is_integer && !std::numeric_limits<U>::is_signed);
+    static_assert(S != 0u, "XorShiftEngine default seed must not be 0. Abort");
+
+public:
+    /// @brief Type of generated values.
+    using result_type = U;
+
+    /// @brief Seed used by the default constructor and in place of 0.
+    static constexpr result_type DEFAULT_SEED = S;
+
+    /**
+     * @brief Constructor.
+     * @param[in] seed   Initial state. 0 is replaced by DEFAULT_SEED.
+     */
+    explicit XorShiftEngine(result_type seed = DEFAULT_SEED)
+        : m_state(0)
+    {
+        this->seed(seed);
+    }
+
+    /// @brief Get lower bound of generated values.
+    /// @note 0 is never generated. Reporting 0 keeps the full power of two range
+    ///       that distributions can use without rejection.
+    static constexpr result_type min(void)
+    {
+        return 0;
+    }
+
+    /// @brief Get largest value that can be generated.
+    static constexpr result_type max(void)
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    /**
+     * @brief Reinitialize the engine.
+     * @param[in] seed   Initial state. 0 is replaced by DEFAULT_SEED.
+     */
+    void seed(result_type seed = DEFAULT_SEED)
+    {
+        m_state = (seed != 0u) ? seed : DEFAULT_SEED;
+    }
+
+    /**
+     * @brief Get next random number.
+     * @returns random number
+     */
+    result_type operator () (void)
+    {
+        auto x = m_state;
+        x = static_cast<result_type>(x ^ static_cast<result_type>(x << A));
+        x = static_cast<result_type>(x ^ static_cast<result_type>(x >> B));
+        x = static_cast<result_type>(x ^ static_cast<result_type>(x << C));
+        m_state = x;
+        return x;
+    }
+
+    /**
+     * @brief Skip random numbers as if operator () was called @p count times.
+     * @param[in] count   Number of values to skip.
+     */
+    void discard(unsigned long long count)
+    {
+        for (; count > 0; --count)
+        {
+            (*this)();
+        }
+    }
+
+    /// @brief Compare engines for equality of their state.
+    friend bool operator == (XorShiftEngine const& lhs, XorShiftEngine const& rhs)
+    {
+        return lhs.m_state == rhs.m_state;
+    }
+
+    /// @brief Compare engines for inequality of their state.
+    friend bool operator != (XorShiftEngine const& lhs, XorShiftEngine const& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    result_type m_state;
+};
+
+/// @brief xorshift32 with shifts 13, 17, 5. 4 bytes of state.
+using XorShift32 = XorShiftEngine<std::uint32_t, 13, 17, 5, 2463534242u>;
+
+/// @brief xorshift64 with shifts 13, 7, 17. 8 bytes of state.
+using XorShift64 = XorShiftEngine<std::uint64_t, 13, 7, 17, 88172645463325252u>;
+
+} // namespace simons_lib::engines
+
+#endif // XOR_SHIFT_IMPL_HPP_20190511084517
@@ -0,0 +1,262 @@
+/**
+ * @file      FlatCombinedImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Value protected by a mutex whose holder applies the pending operations of all threads.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FLAT_COMBINED_IMPL_HPP_20190810091407
+#define FLAT_COMBINED_IMPL_HPP_20190810091407
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include "../Defines.hpp"
+#include "../Detail/ThreadRecords.hpp"
+#include "../LockGuard.hpp"
+#include "../Mutex/Detail.hpp"
+
+namespace simons_lib::guarded
+{
+
+using simons_lib::lock::ADOPT_LOCK;
+using simons_lib::lock::LockGuard;
+
+/**
+ * @brief Value protected by a mutex, using flat combining to apply operations.
+ * @note A thread publishes its operation in a slot of its own and tries to
+ *       lock the mutex. The thread that gets the lock (the combiner) applies
+ *       the pending operations of all threads in one go, while the others
+ *       spin on their own slot until their operation is done. This replaces
+ *       a lock handoff per operation by one per batch and keeps the value in
+ *       the cache of the combining core. Pays off for short operations on
+ *       heavily contended values (e.g. Stack, RandomNumberGenerator).
+ *       Waiting threads poll the mutex only if no combiner is active or
+ *       after a bounded spin, so they do not pull its cache line away from
+ *       the combiner. An exception thrown by an operation is rethrown in the
+ *       thread that posted it. Operations must not call apply recursively.
+ * @tparam T   Type of the protected value.
+ * @tparam M   Mutex type (defaults to std::mutex), only try_lock is used.
+ */
+template<typename T, typename M = std::mutex>
+class FlatCombined
+{
+public:
+    /// @brief Type of the protected value.
+    using ValueType = T;
+    /// @brief Type of supplied mutex.
+    using MutexType = M;
+
+    /// @brief Maximum number of passes over all slots per lock acquisition.
+    static constexpr std::uint32_t MAX_PASSES = 4;
+
+    /**
+     * @brief Constructor. Constructs the value in place.
+     * @param[in] args   Arguments forwarded to the constructor of the value.
+     */
+    template<typename... Args>
+    explicit FlatCombined(Args&&... args)
+        : m_mutex()
+        , m_combining(false)
+        , m_value(std::forward<Args>(args)...)
+        , m_slots()
+    {
+    }
+
+    // Copying and moving is forbidden
+    FlatCombined(FlatCombined const&) = delete;
+    FlatCombined(FlatCombined&&) = delete;
+    FlatCombined& operator = (FlatCombined const&) = delete;
+    FlatCombined& operator = (FlatCombined&&) = delete;
+
+    /**
+     * @brief Run @p func on the value, possibly on another thread holding the mutex.
+     * @note Returns once @p func was applied. Results are returned by value,
+     *       references into the value would escape the mutex.
+     * @param[in] func   Callable invoked as func(ValueType&).
+     * @returns Result of @p func.
+     */
+    template<typename F>
+    auto apply(F&& func)
+    {
+        using ResultType = std::decay_t<std::invoke_result_t<F&, ValueType&>>;
+
+        using OperationType = Operation<std::remove_reference_t<F>, ResultType>;
+
+        auto operation = OperationType(func);
+        auto& slot = m_slots.local();
+        slot.operation = &operation;
+        slot.run = &OperationType::run;
+        slot.pending.store(true, std::memory_order_release);
+
+        auto spin = mutex::detail::SpinWait(YIELD_THRESHOLD);
+        auto spins = std::uint32_t(0);
+        while (slot.pending.load(std::memory_order_acquire))
+        {
+            // Spin on the own slot while a combiner is active, it likely serves us.
+            if (!m_combining.load(std::memory_order_relaxed) || (++spins >= TRY_LOCK_INTERVAL))
+            {
+                spins = 0;
+                if (m_mutex.try_lock())
+                {
+                    auto guard = LockGuard<MutexType>(m_mutex, ADOPT_LOCK);
+                    combine();
+                    continue;
+                }
+            }
+            spin.wait();
+        }
+
+#if defined(__cpp_exceptions)
+        if (slot.error)
+        {
+            std::rethrow_exception(std::exchange(slot.error, nullptr));
+        }
+#endif
+
+        if constexpr (!std::is_void_v<ResultType>)
+        {
+            return std::move(*operation.result);
+        }
+    }
+
+private:
+    static constexpr std::uint32_t YIELD_THRESHOLD = 1024;
+    static constexpr std::uint32_t TRY_LOCK_INTERVAL = 64;
+
+    // Operation of a waiting thread, lives on its stack.
+    template<typename F, typename R>
+    struct Operation
+    {
+        explicit Operation(F& func) noexcept
+            : func(func)
+            , result()
+        {
+        }
+
+        F&               func;
+        std::optional<R> result;
+
+        static void run(void* operation, ValueType& value)
+        {
+            auto& self = *static_cast<Operation*>(operation);
+            self.result.emplace(self.func(value));
+        }
+    };
+
+    template<typename F>
+    struct Operation<F, void>
+    {
+        explicit Operation(F& func) noexcept
+            : func(func)
+        {
+        }
+
+        F& func;
+
+        static void run(void* operation, ValueType& value)
+        {
+            static_cast<Operation*>(operation)->func(value);
+        }
+    };
+
+    // Publication slot of a thread. Written by its owner while not pending,
+    // by the combiner while pending.
+    struct alignas(SIMONS_LIB_CACHE_LINE_SIZE) Slot : simons_lib::detail::ThreadRecord
+    {
+        std::atomic<bool>  pending = {false};
+        void*              operation = nullptr;
+        void               (*run)(void*, ValueType&) = nullptr;
+#if defined(__cpp_exceptions)
+        std::exception_ptr error = nullptr;
+#endif
+    };
+
+    // Apply all pending operations. Requires the mutex.
+    void combine(void)
+    {
+        m_combining.store(true, std::memory_order_relaxed);
+        for (auto pass = std::uint32_t(0); pass < MAX_PASSES; ++pass)
+        {
+            auto applied = false;
+            m_slots.forEach([this, &applied] (Slot& slot)
+            {
+                if (slot.pending.load(std::memory_order_acquire))
+                {
+                    run(slot);
+                    slot.pending.store(false, std::memory_order_release);
+                    applied = true;
+                }
+            });
+
+            if (!applied)
+            {
+                break;
+            }
+        }
+        m_combining.store(false, std::memory_order_relaxed);
+    }
+
+    // Run the operation of a slot, an exception is handed to its owner.
+    void run(Slot& slot) noexcept
+    {
+#if defined(__cpp_exceptions)
+        try
+        {
+            slot.run(slot.operation, m_value);
+        }
+        catch (...)
+        {
+            slot.error = std::current_exception();
+        }
+#else
+        slot.run(slot.operation, m_value);
+#endif
+    }
+
+    MutexType                             m_mutex;
+    std::atomic<bool>                     m_combining; // Hint for waiters, set while combining.
+    ValueType                             m_value;
+    simons_lib::detail::RecordList<Slot> m_slots;
+};
+
+} // namespace simons_lib::guarded
+
+#endif // FLAT_COMBINED_IMPL_HPP_20190810091407
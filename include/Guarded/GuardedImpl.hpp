@@ -0,0 +1,190 @@
+/**
+ * @file      GuardedImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Value bundled with its mutex, accessible only while locked.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef GUARDED_IMPL_HPP_20190713084855
+#define GUARDED_IMPL_HPP_20190713084855
+
+#include <utility>
+#include "../Defines.hpp"
+#include "../LockGuard.hpp"
+#include "../NullTypes.hpp"
+
+namespace simons_lib::guarded
+{
+
+using simons_lib::null_types::NullMutex;
+using simons_lib::lock::CallSite;
+using simons_lib::lock::LockGuard;
+using simons_lib::lock::ReadLockGuard;
+
+/**
+ * @brief Pointer-like access to a value that keeps its mutex locked while alive.
+ * @tparam T   Type of the accessed value.
+ * @tparam M   Type of the locked mutex.
+ */
+template<typename T, typename M>
+class Locked
+{
+public:
+    /**
+     * @brief Constructor. Locks @p mutex.
+     * @param[in] mutex   Mutex guarding @p value.
+     * @param[in] value   Value to access.
+     * @param[in] site    Location of the acquisition.
+     */
+    Locked(M& mutex, T& value, CallSite const& site) noexcept
+        : m_guard(mutex, site)
+        , m_value(value)
+    {
+    }
+
+    // Copying and moving is forbidden
+    Locked(Locked const&) = delete;
+    Locked(Locked&&) = delete;
+    Locked& operator = (Locked const&) = delete;
+    Locked& operator = (Locked&&) = delete;
+
+    /// @brief Access the guarded value.
+    T& operator * (void) const noexcept { return m_value; }
+    /// @brief Access the guarded value.
+    T* operator -> (void) const noexcept { return &m_value; }
+
+private:
+    LockGuard<M> m_guard;
+    T&           m_value;
+};
+
+/**
+ * @brief Value bundled with the mutex guarding it.
+ * @note The value is only reachable while the mutex is held. Each instance
+ *       occupies whole cache lines (SIMONS_LIB_CACHE_LINE_SIZE), so instances
+ *       placed next to each other (e.g. per-shard arrays) never share a line
+ *       and threads working on different instances do not slow each other down.
+ * @tparam T   Type of the guarded value.
+ * @tparam M   Mutex type (defaults to NullMutex). SharedLockable mutexes
+ *             allow concurrent readers through the const accessors.
+ */
+template<typename T, typename M = NullMutex>
+class alignas(SIMONS_LIB_CACHE_LINE_SIZE) Guarded
+{
+public:
+    /// @brief Type of the guarded value.
+    using ValueType = T;
+    /// @brief Type of supplied mutex.
+    using MutexType = M;
+
+    /**
+     * @brief Constructor. Constructs the value in place.
+     * @param[in] args   Arguments forwarded to the constructor of the value.
+     */
+    template<typename... Args>
+    explicit Guarded(Args&&... args)
+        : m_mutex()
+        , m_value(std::forward<Args>(args)...)
+    {
+    }
+
+    // Copying and moving is forbidden
+    Guarded(Guarded const&) = delete;
+    Guarded(Guarded&&) = delete;
+    Guarded& operator = (Guarded const&) = delete;
+    Guarded& operator = (Guarded&&) = delete;
+
+    /**
+     * @brief Lock the mutex and access the value.
+     * @param[in] site   Location of the acquisition. Captured automatically.
+     * @returns Accessor keeping the mutex locked until it is destroyed.
+     */
+    Locked<ValueType, MutexType> lock(CallSite const& site = CallSite::current())
+    {
+        return Locked<ValueType, MutexType>(m_mutex, m_value, site);
+    }
+
+    /**
+     * @brief Run @p func on the value while the mutex is held.
+     * @param[in] func   Callable invoked as func(ValueType&).
+     * @returns Result of @p func.
+     */
+    template<typename F>
+    decltype(auto) apply(F&& func)
+    {
+        auto guard = LockGuard<MutexType>(m_mutex);
+        return std::forward<F>(func)(m_value);
+    }
+
+    /**
+     * @brief Run @p func on the value while the mutex is held for reading.
+     * @note Uses shared ownership if M is SharedLockable.
+     * @param[in] func   Callable invoked as func(ValueType const&).
+     * @returns Result of @p func.
+     */
+    template<typename F>
+    decltype(auto) apply(F&& func) const
+    {
+        auto guard = ReadLockGuard<MutexType>(m_mutex);
+        return std::forward<F>(func)(m_value);
+    }
+
+    /**
+     * @brief Copy of the value.
+     * @returns Copy taken while the mutex is held for reading.
+     */
+    ValueType load(void) const
+    {
+        return apply([] (ValueType const& value) { return value; });
+    }
+
+    /**
+     * @brief Replace the value.
+     * @param[in] value   New value.
+     */
+    void store(ValueType value)
+    {
+        apply([&value] (ValueType& current) { current = std::move(value); });
+    }
+
+private:
+    mutable MutexType m_mutex;
+    ValueType         m_value;
+};
+
+} // namespace simons_lib::guarded
+
+#endif // GUARDED_IMPL_HPP_20190713084855
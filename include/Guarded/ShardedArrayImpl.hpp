@@ -0,0 +1,167 @@
+/**
+ * @file      ShardedArrayImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Fixed number of independently locked shards.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SHARDED_ARRAY_IMPL_HPP_20190713084855
+#define SHARDED_ARRAY_IMPL_HPP_20190713084855
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include "../Mutex/Detail.hpp"
+#include "../NullTypes.hpp"
+#include "GuardedImpl.hpp"
+
+namespace simons_lib::guarded
+{
+
+/**
+ * @brief Array of Guarded values, each padded to its own cache lines.
+ * @note Spreads a contended value over independently locked shards. Threads
+ *       pick a shard by key (shardFor) or per thread (localShard).
+ *       Operations spanning all shards (forEach) lock one shard at a time and
+ *       therefore do not see a consistent snapshot of all shards.
+ * @tparam T   Type of the value of each shard. Must be default constructible.
+ * @tparam M   Mutex type of each shard (defaults to NullMutex).
+ */
+template<typename T, typename M = NullMutex>
+class ShardedArray
+{
+public:
+    /// @brief Type of a single shard.
+    using ShardType = Guarded<T, M>;
+
+    /**
+     * @brief Constructor.
+     * @param[in] shards   Number of shards. At least one shard is created.
+     */
+    explicit ShardedArray(std::size_t shards)
+        : m_size((shards == 0u) ? 1u : shards)
+        , m_shards(std::make_unique<ShardType[]>(m_size))
+    {
+    }
+
+    /**
+     * @brief Number of shards.
+     * @returns Number of shards.
+     */
+    std::size_t size(void) const noexcept
+    {
+        return m_size;
+    }
+
+    /**
+     * @brief Access a shard by index.
+     * @param[in] index   Index of the shard. Must be less than size().
+     * @returns Reference to the shard.
+     */
+    ShardType& operator [] (std::size_t index) noexcept
+    {
+        return m_shards[index];
+    }
+
+    /**
+     * @brief Access a shard by index.
+     * @param[in] index   Index of the shard. Must be less than size().
+     * @returns Reference to the shard.
+     */
+    ShardType const& operator [] (std::size_t index) const noexcept
+    {
+        return m_shards[index];
+    }
+
+    /**
+     * @brief Shard responsible for a key. Equal keys always map to the same shard.
+     * @param[in] key   Key to look up, hashed with std::hash.
+     * @returns Reference to the shard.
+     */
+    template<typename K>
+    ShardType& shardFor(K const& key) noexcept
+    {
+        // Multiplicative mixing, std::hash of integers is the identity.
+        auto hash = static_cast<std::uint64_t>(std::hash<K>()(key)) * UINT64_C(0x9E3779B97F4A7C15);
+        return m_shards[static_cast<std::size_t>(hash >> 32u) % m_size];
+    }
+
+    /**
+     * @brief Shard assigned to the calling thread.
+     * @note Shards are handed out to threads round robin, so up to size()
+     *       threads use distinct shards.
+     * @returns Reference to the shard.
+     */
+    ShardType& localShard(void) noexcept
+    {
+        return m_shards[mutex::detail::threadSlot(m_size)];
+    }
+
+    /**
+     * @brief Run @p func on every shard, locking one shard at a time.
+     * @param[in] func   Callable invoked as func(T&) for each shard.
+     */
+    template<typename F>
+    void forEach(F&& func)
+    {
+        for (auto i = std::size_t(0); i < m_size; ++i)
+        {
+            m_shards[i].apply(func);
+        }
+    }
+
+    /**
+     * @brief Run @p func on every shard, locking one shard at a time for reading.
+     * @param[in] func   Callable invoked as func(T const&) for each shard.
+     */
+    template<typename F>
+    void forEach(F&& func) const
+    {
+        for (auto i = std::size_t(0); i < m_size; ++i)
+        {
+            m_shards[i].apply(func);
+        }
+    }
+
+private:
+    std::size_t                  m_size;
+    std::unique_ptr<ShardType[]> m_shards;
+};
+
+} // namespace simons_lib::guarded
+
+#endif // SHARDED_ARRAY_IMPL_HPP_20190713084855
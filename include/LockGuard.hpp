@@ -41,6 +41,8 @@
 #ifndef LOCK_GUARD_HPP_20180825084201
 #define LOCK_GUARD_HPP_20180825084201
 
+#include "LockGuard/CallSiteImpl.hpp"
 #include "LockGuard/LockGuardImpl.hpp"
+#include "LockGuard/SharedLockGuardImpl.hpp"
 
 #endif // LOCK_GUARD_HPP_20180825084201
@@ -0,0 +1,91 @@
+/**
+ * @file      CallSiteImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Source location of lock acquisitions.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CALL_SITE_IMPL_HPP_20190622084530
+#define CALL_SITE_IMPL_HPP_20190622084530
+
+#include <type_traits>
+#include <utility>
+
+namespace simons_lib::lock
+{
+
+/**
+ * @brief Source location of a lock acquisition (stand-in for std::source_location).
+ */
+struct CallSite
+{
+    char const* file;     ///< Source file of the call site.
+    char const* function; ///< Function containing the call site.
+    int         line;     ///< Line of the call site.
+
+    /**
+     * @brief Capture the call site.
+     * @note Used as default argument, the location of the caller is captured.
+     * @returns Location of the caller.
+     */
+    static constexpr CallSite current(char const* file = __builtin_FILE(), char const* function = __builtin_FUNCTION(),
+                                      int line = __builtin_LINE()) noexcept
+    {
+        return CallSite{file, function, line};
+    }
+};
+
+/**
+ * @brief Check if a mutex type accepts the call site of an acquisition (lock(CallSite const&)).
+ * @note LockGuard passes its own call site to such mutexes, e.g. InstrumentedMutex.
+ * @tparam M   The mutex type to check.
+ */
+template<typename M, typename = void>
+struct IsCallSiteLockable : std::false_type
+{
+};
+
+/// @cond DO_NOT_DOCUMENT
+template<typename M>
+struct IsCallSiteLockable<M, std::void_t<decltype(std::declval<M&>().lock(std::declval<CallSite const&>()))>>
+    : std::true_type
+{
+};
+/// @endcond
+
+} // namespace simons_lib::lock
+
+#endif // CALL_SITE_IMPL_HPP_20190622084530
@@ -41,14 +41,29 @@
 #ifndef LOCK_GUARD_IMPL_HPP_20180825084201
 #define LOCK_GUARD_IMPL_HPP_20180825084201
 
+#include "CallSiteImpl.hpp"
+
 namespace simons_lib::lock
 {
 
+/**
+ * @brief Tag type selecting the LockGuard constructor adopting a locked mutex.
+ * @note Replacement for std::adopt_lock_t without including the mutex header.
+ */
+struct AdoptLock
+{
+};
+
+/// @brief Tag value selecting the LockGuard constructor adopting a locked mutex.
+inline constexpr auto ADOPT_LOCK = AdoptLock();
+
 /**
  * @brief Simple re-implementation of std::lock_guard.
  * @note This RAII lock guard is used throughout simons_lib
  *       with the intension, that the mutex header doesn't have to be included
  *       in cases where no thread safety is required.
+ * @note Mutexes accepting a CallSite (see IsCallSiteLockable) are told where
+ *       the guard was constructed. For all others the call site is unused.
  * @tparam M   The mutex type to lock. Must implement at least BasicLockable.
  */
 template<typename M>
@@ -61,11 +76,28 @@ public:
     /**
      * @brief Constructor.
      * @param[in] mutex   Mutex that should be used by the LockGuard
+     * @param[in] site    Location of the guard. Captured automatically.
+     */
+    LockGuard(MutexType& mutex, [[maybe_unused]] CallSite const& site = CallSite::current()) noexcept
+        : m_mutex(mutex)
+    {
+        if constexpr (IsCallSiteLockable<MutexType>::value)
+        {
+            m_mutex.lock(site);
+        }
+        else
+        {
+            m_mutex.lock();
+        }
+    }
+
+    /**
+     * @brief Constructor. Takes over a mutex already locked by the caller.
+     * @param[in] mutex   Locked mutex that should be unlocked by the LockGuard
      */
-    LockGuard(MutexType& mutex) noexcept
+    LockGuard(MutexType& mutex, AdoptLock) noexcept
         : m_mutex(mutex)
     {
-        m_mutex.lock();
     }
 
     ~LockGuard() noexcept
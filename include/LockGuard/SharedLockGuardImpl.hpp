@@ -0,0 +1,118 @@
+/**
+ * @file      SharedLockGuardImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     RAII guard for shared ownership of SharedLockable mutexes.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SHARED_LOCK_GUARD_IMPL_HPP_20190601092210
+#define SHARED_LOCK_GUARD_IMPL_HPP_20190601092210
+
+#include <type_traits>
+#include <utility>
+#include "LockGuardImpl.hpp"
+
+namespace simons_lib::lock
+{
+
+/**
+ * @brief Check if a mutex type implements SharedLockable
+ *        (lock_shared(), try_lock_shared() and unlock_shared()).
+ * @tparam M   The mutex type to check.
+ */
+template<typename M, typename = void>
+struct IsSharedLockable : std::false_type
+{
+};
+
+/// @cond DO_NOT_DOCUMENT
+template<typename M>
+struct IsSharedLockable<M, std::void_t<decltype(std::declval<M&>().lock_shared()),
+                                       decltype(std::declval<M&>().try_lock_shared()),
+                                       decltype(std::declval<M&>().unlock_shared())>> : std::true_type
+{
+};
+/// @endcond
+
+/**
+ * @brief RAII lock guard acquiring shared ownership. Counterpart of std::shared_lock.
+ * @tparam M   The mutex type to lock. Must implement SharedLockable.
+ */
+template<typename M>
+class SharedLockGuard
+{
+    static_assert(IsSharedLockable<M>::value, "SharedLockGuard requires a SharedLockable mutex. Abort");
+
+public:
+    /// @brief Type of internally used mutex.
+    using MutexType = M;
+
+    /**
+     * @brief Constructor.
+     * @param[in] mutex   Mutex that should be used by the SharedLockGuard
+     */
+    SharedLockGuard(MutexType& mutex) noexcept
+        : m_mutex(mutex)
+    {
+        m_mutex.lock_shared();
+    }
+
+    ~SharedLockGuard() noexcept
+    {
+        m_mutex.unlock_shared();
+    }
+
+    // Copying and moving is forbidden
+    SharedLockGuard(SharedLockGuard const&) = delete;
+    SharedLockGuard(SharedLockGuard&&) = delete;
+    SharedLockGuard& operator = (SharedLockGuard const&) = delete;
+    SharedLockGuard& operator = (SharedLockGuard&&) = delete;
+
+private:
+    MutexType& m_mutex;
+};
+
+/**
+ * @brief Guard for read-only sections. Takes shared ownership if the mutex
+ *        implements SharedLockable and exclusive ownership otherwise.
+ * @tparam M   The mutex type to lock. Must implement at least BasicLockable.
+ */
+template<typename M>
+using ReadLockGuard = typename std::conditional<IsSharedLockable<M>::value, SharedLockGuard<M>, LockGuard<M>>::type;
+
+} // namespace simons_lib::lock
+
+#endif // SHARED_LOCK_GUARD_IMPL_HPP_20190601092210
@@ -0,0 +1,167 @@
+/**
+ * @file      MonteCarloImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Deterministic parallel Monte Carlo driver.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MONTE_CARLO_IMPL_HPP_20190504091233
+#define MONTE_CARLO_IMPL_HPP_20190504091233
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "../RandomNumberGenerator.hpp"
+#include "../Detail/Parallel.hpp"
+
+namespace simons_lib::monte_carlo
+{
+
+using simons_lib::random_number_generator::RandomNumberGenerator;
+
+/**
+ * @brief Run Monte Carlo trials on several threads with reproducible results.
+ * @note The trials are partitioned into chunks of a fixed size. Each chunk
+ *       owns a RandomNumberGenerator seeded with a stream derived from the
+ *       seed and the chunk index, and its results are reduced in trial order.
+ *       The chunk results are finally reduced in chunk order. Neither the
+ *       partitioning nor the reduction order depends on the number of
+ *       threads, so the result is bit-identical for any thread count. Worker
+ *       threads grab the next unprocessed chunk, which balances the load
+ *       between trials of different cost.
+ * @tparam E   Random engine type to use.
+ * @tparam D   Distribution type to use.
+ */
+template<typename E, typename D>
+class MonteCarlo
+{
+public:
+    /// @brief Used random engine type.
+    using EngineType = E;
+    /// @brief Used random distribution type.
+    using DistributionType = D;
+    /// @brief Type of the per chunk generator handed to the trials.
+    using GeneratorType = RandomNumberGenerator<EngineType, DistributionType>;
+
+    /// @brief Number of trials per chunk used by default.
+    static constexpr std::uint64_t DEFAULT_CHUNK_SIZE = 4096;
+
+    /**
+     * @brief Constructor.
+     * @param[in] seed           Seed all chunk streams are derived from.
+     * @param[in] distribution   Distribution used by the per chunk generators.
+     * @param[in] chunkSize      Number of trials per chunk. 0 is treated as 1.
+     *                           Changing it changes the result.
+     * @param[in] threads        Number of threads to use. 0 uses all hardware threads.
+     */
+    explicit MonteCarlo(std::uint64_t seed,
+                        DistributionType const& distribution = DistributionType(),
+                        std::uint64_t chunkSize = DEFAULT_CHUNK_SIZE,
+                        std::size_t threads = 0)
+        : m_seed(seed)
+        , m_distribution(distribution)
+        , m_chunkSize((chunkSize != 0) ? chunkSize : 1u)
+        , m_threads(threads)
+    {
+    }
+
+    /**
+     * @brief Execute trials and reduce their results.
+     * @param[in] trials   Number of trials to execute.
+     * @param[in] init     Initial value of each reduction. Must be neutral for @p reduce.
+     * @param[in] trial    Callable R(GeneratorType&) executing a single trial.
+     * @param[in] reduce   Callable R(R, R) combining two results.
+     *                     Called concurrently for different chunks.
+     * @returns reduced result of all trials.
+     */
+    template<typename R, typename Trial, typename Reduce>
+    R run(std::uint64_t trials, R init, Trial const& trial, Reduce const& reduce) const
+    {
+        auto chunks = static_cast<std::size_t>((trials / m_chunkSize) + ((trials % m_chunkSize != 0) ? 1u : 0u));
+        auto results = std::vector<ChunkResult<R>>(chunks, ChunkResult<R>{init});
+
+        simons_lib::detail::parallelFor(chunks, m_threads, [&] (std::size_t chunk)
+        {
+            auto seed = simons_lib::detail::deriveSeed(m_seed, chunk);
+            auto rng = GeneratorType(static_cast<typename GeneratorType::SeedType>(seed), m_distribution);
+            auto begin = chunk * m_chunkSize;
+            auto end = (trials - begin < m_chunkSize) ? trials : begin + m_chunkSize;
+
+            auto& result = results[chunk].value;
+            for (auto i = begin; i < end; ++i)
+            {
+                result = reduce(std::move(result), trial(rng));
+            }
+        });
+
+        auto result = std::move(init);
+        for (auto& chunk : results)
+        {
+            result = reduce(std::move(result), std::move(chunk.value));
+        }
+        return result;
+    }
+
+    /// @brief Get seed all chunk streams are derived from.
+    std::uint64_t seed(void) const
+    {
+        return m_seed;
+    }
+
+    /// @brief Get number of trials per chunk.
+    std::uint64_t chunkSize(void) const
+    {
+        return m_chunkSize;
+    }
+
+private:
+    // Wrapper preventing std::vector<bool> and its shared bit storage.
+    template<typename R>
+    struct ChunkResult
+    {
+        R value;
+    };
+
+    std::uint64_t    m_seed;
+    DistributionType m_distribution;
+    std::uint64_t    m_chunkSize;
+    std::size_t      m_threads;
+};
+
+} // namespace simons_lib::monte_carlo
+
+#endif // MONTE_CARLO_IMPL_HPP_20190504091233
@@ -0,0 +1,157 @@
+/**
+ * @file      Detail.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Internal details of Mutex. Not intended for direct usage.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @cond DO_NOT_DOCUMENT
+ * @note Documentation for this file is suppressed to avoid
+ *       polluting the generated documentation with internal details.
+ */
+
+#ifndef DETAIL_HPP_20190518100712
+#define DETAIL_HPP_20190518100712
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace simons_lib::mutex::detail
+{
+
+// Hint to the CPU that the calling thread spins on a memory location.
+// Lowers power consumption and frees pipeline resources for a sibling
+// hyper-thread (pause on x86, yield on ARM).
+inline void cpuRelax(void) noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || (defined(__ARM_ARCH) && (__ARM_ARCH >= 7))
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+// Busy waiting helper. Pauses and starts to yield to the scheduler once the
+// spin budget is used up, so a preempted thread that others wait for can run.
+class SpinWait
+{
+public:
+    explicit SpinWait(std::uint32_t yieldThreshold) noexcept
+        : m_spun(0)
+        , m_yieldThreshold(yieldThreshold)
+    {
+    }
+
+    void wait(std::uint32_t pauses = 1) noexcept
+    {
+        for (auto i = std::uint32_t(0); i < pauses; ++i)
+        {
+            cpuRelax();
+        }
+
+        m_spun += pauses;
+        if (m_spun >= m_yieldThreshold)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    std::uint32_t m_spun;
+    std::uint32_t m_yieldThreshold;
+};
+
+// Index of the calling thread for per-CPU arrays. Handed out round robin on
+// first use, so up to N concurrently started threads get N distinct indices
+// (the CPU a thread starts on says little about where it runs later, and
+// threads started from the same CPU would share a slot forever). A thread
+// keeps its index for its lifetime, callers may rely on hitting the same slot.
+inline std::size_t threadIndex(void) noexcept
+{
+    static auto next = std::atomic<std::size_t>(0);
+    static thread_local auto const index = next.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+// Slot of the calling thread in a per-CPU array of size count.
+inline std::size_t threadSlot(std::size_t count) noexcept
+{
+    return threadIndex() % count;
+}
+
+static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t), "Futex word must be a plain 32 bit integer. Abort");
+
+// Sleep while *word equals expected (Linux futex). Returns on wake up, signal
+// or if *word differs, callers must re-check their condition. Without futex
+// support this degrades to a yield.
+inline void futexWait(std::atomic<std::uint32_t>& word, std::uint32_t expected) noexcept
+{
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+    if (word.load(std::memory_order_relaxed) == expected)
+    {
+        std::this_thread::yield();
+    }
+#endif
+}
+
+// Wake up to count threads sleeping in futexWait on word.
+inline void futexWake(std::atomic<std::uint32_t>& word, int count) noexcept
+{
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+#else
+    (void) word;
+    (void) count;
+#endif
+}
+
+} // namespace simons_lib::mutex::detail
+#endif // DETAIL_HPP_20190518100712
+
+/**
+ * @endcond DO_NOT_DOCUMENT
+ */
@@ -0,0 +1,207 @@
+/**
+ * @file      DistributedRwLockImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Writer-preferring reader-writer lock with per-CPU reader counters.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DISTRIBUTED_RW_LOCK_IMPL_HPP_20190601092210
+#define DISTRIBUTED_RW_LOCK_IMPL_HPP_20190601092210
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "../Defines.hpp"
+#include "Detail.hpp"
+
+namespace simons_lib::mutex
+{
+
+/**
+ * @brief Writer-preferring reader-writer lock. Drop-in replacement for std::shared_mutex.
+ * @note Readers increment a counter in one of S cache line sized slots,
+ *       handed out to threads round robin, so up to S reader threads do not
+ *       contend on a shared cache line. A writer announces itself with a flag and
+ *       waits until all reader counters drained. New readers back off as soon
+ *       as a writer is announced, so writers cannot starve. Writing is
+ *       expensive (all S slots are scanned), use it for read-mostly data.
+ * @tparam S   Number of reader counter slots. Should be about the number of CPUs.
+ */
+template<std::size_t S = 16>
+class alignas(SIMONS_LIB_CACHE_LINE_SIZE) DistributedRwLock
+{
+    static_assert(S > 0u, "DistributedRwLock needs at least one slot. Abort");
+
+public:
+    /// @brief Number of pause instructions after which waiters start to yield.
+    static constexpr std::uint32_t YIELD_THRESHOLD = 4096;
+
+    /**
+     * @brief Constructor. The lock is initially unlocked.
+     */
+    DistributedRwLock(void) noexcept
+        : m_writer(false)
+        , m_readers()
+    {
+        for (auto& slot : m_readers)
+        {
+            slot.count.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Copying and moving is forbidden
+    DistributedRwLock(DistributedRwLock const&) = delete;
+    DistributedRwLock(DistributedRwLock&&) = delete;
+    DistributedRwLock& operator = (DistributedRwLock const&) = delete;
+    DistributedRwLock& operator = (DistributedRwLock&&) = delete;
+
+    /**
+     * @brief Acquire exclusive ownership. Waits for other writers and active readers.
+     */
+    void lock(void) noexcept
+    {
+        auto spinWait = detail::SpinWait(YIELD_THRESHOLD);
+        while (m_writer.load(std::memory_order_relaxed) || m_writer.exchange(true, std::memory_order_seq_cst))
+        {
+            spinWait.wait();
+        }
+
+        for (auto& slot : m_readers)
+        {
+            while (slot.count.load(std::memory_order_seq_cst) != 0)
+            {
+                spinWait.wait();
+            }
+        }
+    }
+
+    /**
+     * @brief Try to acquire exclusive ownership without waiting.
+     * @returns true if the lock was acquired, false if it is held by a writer or readers.
+     */
+    bool try_lock(void) noexcept
+    {
+        if (m_writer.load(std::memory_order_relaxed) || m_writer.exchange(true, std::memory_order_seq_cst))
+        {
+            return false;
+        }
+
+        for (auto& slot : m_readers)
+        {
+            if (slot.count.load(std::memory_order_seq_cst) != 0)
+            {
+                m_writer.store(false, std::memory_order_release);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Release exclusive ownership.
+     */
+    void unlock(void) noexcept
+    {
+        m_writer.store(false, std::memory_order_release);
+    }
+
+    /**
+     * @brief Acquire shared ownership. Waits while a writer holds or waits for the lock.
+     */
+    void lock_shared(void) noexcept
+    {
+        auto& count = slot();
+        auto spinWait = detail::SpinWait(YIELD_THRESHOLD);
+        while (true)
+        {
+            count.fetch_add(1, std::memory_order_seq_cst);
+            if (!m_writer.load(std::memory_order_seq_cst))
+            {
+                return;
+            }
+
+            // Writer announced, step back and let it proceed.
+            count.fetch_sub(1, std::memory_order_release);
+            while (m_writer.load(std::memory_order_relaxed))
+            {
+                spinWait.wait();
+            }
+        }
+    }
+
+    /**
+     * @brief Try to acquire shared ownership without waiting.
+     * @returns true if the lock was acquired, false if a writer holds or waits for it.
+     */
+    bool try_lock_shared(void) noexcept
+    {
+        auto& count = slot();
+        count.fetch_add(1, std::memory_order_seq_cst);
+        if (!m_writer.load(std::memory_order_seq_cst))
+        {
+            return true;
+        }
+        count.fetch_sub(1, std::memory_order_release);
+        return false;
+    }
+
+    /**
+     * @brief Release shared ownership.
+     */
+    void unlock_shared(void) noexcept
+    {
+        slot().fetch_sub(1, std::memory_order_release);
+    }
+
+private:
+    // Reader counter of a slot, padded to a cache line.
+    struct alignas(SIMONS_LIB_CACHE_LINE_SIZE) Slot
+    {
+        std::atomic<std::uint32_t> count;
+    };
+
+    std::atomic<std::uint32_t>& slot(void) noexcept
+    {
+        return m_readers[detail::threadSlot(S)].count;
+    }
+
+    std::atomic<bool> m_writer;
+    Slot              m_readers[S];
+};
+
+} // namespace simons_lib::mutex
+
+#endif // DISTRIBUTED_RW_LOCK_IMPL_HPP_20190601092210
@@ -0,0 +1,513 @@
+/**
+ * @file      InstrumentedMutexImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Mutex wrapper collecting contention statistics.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INSTRUMENTED_MUTEX_IMPL_HPP_20190622084530
+#define INSTRUMENTED_MUTEX_IMPL_HPP_20190622084530
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "../Defines.hpp"
+#include "../LockGuard.hpp"
+
+namespace simons_lib::mutex
+{
+
+using simons_lib::lock::CallSite;
+
+/// @cond DO_NOT_DOCUMENT
+namespace detail
+{
+// Counter update by a single writer. Avoids a locked instruction,
+// concurrent readers still see untorn values.
+inline void increment(std::atomic<std::uint64_t>& counter, std::uint64_t value) noexcept
+{
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+} // namespace detail
+/// @endcond
+
+/**
+ * @brief Histogram of durations with power of two buckets.
+ * @note Bucket i counts durations in [2^(i-1), 2^i) nanoseconds, bucket 0 counts
+ *       zero durations. Recording requires a single writer at a time (e.g. the
+ *       lock holder), reading is safe concurrently.
+ */
+class LockHistogram
+{
+public:
+    /// @brief Number of buckets. The last one collects everything above 2^(BUCKETS-2) ns.
+    static constexpr std::size_t BUCKETS = 40;
+
+    /**
+     * @brief Record a duration.
+     * @param[in] ns   Duration in nanoseconds.
+     */
+    void record(std::uint64_t ns) noexcept
+    {
+        auto bucket = std::size_t(0);
+        while ((ns != 0u) && (bucket < (BUCKETS - 1u)))
+        {
+            ns >>= 1u;
+            ++bucket;
+        }
+        detail::increment(m_buckets[bucket], 1u);
+    }
+
+    /**
+     * @brief Number of recorded durations.
+     * @returns Number of recorded durations.
+     */
+    std::uint64_t count(void) const noexcept
+    {
+        auto sum = std::uint64_t(0);
+        for (auto const& bucket : m_buckets)
+        {
+            sum += bucket.load(std::memory_order_relaxed);
+        }
+        return sum;
+    }
+
+    /**
+     * @brief Upper bound of the given percentile.
+     * @param[in] p   Percentile in [0.0, 1.0].
+     * @returns Exclusive upper bound of the bucket containing the percentile in
+     *          nanoseconds, 0 if nothing was recorded or the percentile is zero.
+     */
+    std::uint64_t percentile(double p) const noexcept
+    {
+        auto total = count();
+        auto rank = static_cast<std::uint64_t>(p * static_cast<double>(total));
+        auto seen = std::uint64_t(0);
+        for (auto bucket = std::size_t(0); bucket < BUCKETS; ++bucket)
+        {
+            seen += m_buckets[bucket].load(std::memory_order_relaxed);
+            if ((seen > rank) || ((seen == total) && (seen != 0u)))
+            {
+                return (bucket == 0u) ? 0u : (std::uint64_t(1) << bucket);
+            }
+        }
+        return 0u;
+    }
+
+private:
+    std::atomic<std::uint64_t> m_buckets[BUCKETS] = {};
+};
+
+/**
+ * @brief Contention statistics of a single call site.
+ */
+struct LockSiteStats
+{
+    CallSite                   site;              ///< Location of the acquisitions.
+    std::atomic<std::uint64_t> acquisitions = {0}; ///< Acquisitions from this site.
+    std::atomic<std::uint64_t> contended = {0};    ///< Acquisitions that had to wait.
+    std::atomic<std::uint64_t> waitNs = {0};       ///< Accumulated wait time.
+};
+
+/**
+ * @brief Contention statistics of an InstrumentedMutex.
+ * @note Updated by the lock holder only, read concurrently by reports. Values read
+ *       while the mutex is in use are a consistent snapshot per counter only.
+ */
+class LockStats
+{
+public:
+    /// @brief Number of distinct call sites tracked. Further sites are not itemized.
+    static constexpr std::size_t MAX_SITES = 8;
+
+    /**
+     * @brief Constructor.
+     * @param[in] name     Name of the mutex in reports.
+     * @param[in] origin   Location the mutex was constructed at.
+     */
+    LockStats(std::string name, CallSite const& origin)
+        : m_name(std::move(name))
+        , m_origin(origin)
+    {
+    }
+
+    /// @brief Name of the mutex.
+    std::string const& name(void) const noexcept { return m_name; }
+    /// @brief Location the mutex was constructed at.
+    CallSite const& origin(void) const noexcept { return m_origin; }
+    /// @brief Number of acquisitions.
+    std::uint64_t acquisitions(void) const noexcept { return m_acquisitions.load(std::memory_order_relaxed); }
+    /// @brief Number of acquisitions that had to wait.
+    std::uint64_t contended(void) const noexcept { return m_contended.load(std::memory_order_relaxed); }
+    /// @brief Accumulated wait time in nanoseconds.
+    std::uint64_t waitNs(void) const noexcept { return m_waitNs.load(std::memory_order_relaxed); }
+    /// @brief Accumulated hold time in nanoseconds.
+    std::uint64_t holdNs(void) const noexcept { return m_holdNs.load(std::memory_order_relaxed); }
+    /// @brief Histogram of wait times of all acquisitions.
+    LockHistogram const& waitHistogram(void) const noexcept { return m_waitHistogram; }
+    /// @brief Histogram of hold times.
+    LockHistogram const& holdHistogram(void) const noexcept { return m_holdHistogram; }
+
+    /**
+     * @brief Statistics of the call sites, in order of their first acquisition.
+     * @returns Number of valid entries in @p sites.
+     */
+    std::size_t sites(LockSiteStats const*& sites) const noexcept
+    {
+        sites = m_sites;
+        return m_siteCount.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Record an acquisition. Must be called by the new lock holder.
+     * @param[in] site     Location of the acquisition.
+     * @param[in] waitNs   Time spent waiting, 0 if uncontended.
+     * @param[in] waited   True if the acquisition was contended.
+     */
+    void recordAcquisition(CallSite const& site, std::uint64_t waitNs, bool waited) noexcept
+    {
+        detail::increment(m_acquisitions, 1);
+        m_waitHistogram.record(waitNs);
+        if (waited)
+        {
+            detail::increment(m_contended, 1);
+            detail::increment(m_waitNs, waitNs);
+        }
+
+        if (auto stats = siteOf(site))
+        {
+            detail::increment(stats->acquisitions, 1);
+            if (waited)
+            {
+                detail::increment(stats->contended, 1);
+                detail::increment(stats->waitNs, waitNs);
+            }
+        }
+    }
+
+    /**
+     * @brief Record a hold time. Must be called by the lock holder before release.
+     * @param[in] holdNs   Time the lock was held.
+     */
+    void recordRelease(std::uint64_t holdNs) noexcept
+    {
+        detail::increment(m_holdNs, holdNs);
+        m_holdHistogram.record(holdNs);
+    }
+
+private:
+    // Lock holders are serialized, only readers run concurrently.
+    LockSiteStats* siteOf(CallSite const& site) noexcept
+    {
+        auto count = m_siteCount.load(std::memory_order_relaxed);
+        for (auto i = std::size_t(0); i < count; ++i)
+        {
+            auto const& known = m_sites[i].site;
+            if ((known.line == site.line) && ((known.file == site.file) || (std::strcmp(known.file, site.file) == 0)))
+            {
+                return &m_sites[i];
+            }
+        }
+
+        if (count == MAX_SITES)
+        {
+            return nullptr;
+        }
+        m_sites[count].site = site;
+        m_siteCount.store(count + 1u, std::memory_order_release);
+        return &m_sites[count];
+    }
+
+    std::string                m_name;
+    CallSite                   m_origin;
+    std::atomic<std::uint64_t> m_acquisitions = {0};
+    std::atomic<std::uint64_t> m_contended = {0};
+    std::atomic<std::uint64_t> m_waitNs = {0};
+    std::atomic<std::uint64_t> m_holdNs = {0};
+    LockHistogram              m_waitHistogram;
+    LockHistogram              m_holdHistogram;
+    std::atomic<std::size_t>   m_siteCount = {0};
+    LockSiteStats              m_sites[MAX_SITES];
+};
+
+/**
+ * @brief Process wide registry of the statistics of all InstrumentedMutex instances.
+ * @note Statistics outlive their mutex, so short lived mutexes show up in reports.
+ */
+class LockRegistry
+{
+public:
+    /**
+     * @brief Access the process wide registry.
+     * @returns Reference to the registry.
+     */
+    static LockRegistry& instance(void)
+    {
+        static auto registry = LockRegistry();
+        return registry;
+    }
+
+    /**
+     * @brief Create and register statistics for a new mutex.
+     * @param[in] name     Name of the mutex in reports.
+     * @param[in] origin   Location the mutex was constructed at.
+     * @returns Statistics to be updated by the mutex.
+     */
+    std::shared_ptr<LockStats> create(std::string name, CallSite const& origin)
+    {
+        auto stats = std::make_shared<LockStats>(std::move(name), origin);
+        auto guard = std::lock_guard<std::mutex>(m_mutex);
+        m_stats.push_back(stats);
+        return stats;
+    }
+
+    /**
+     * @brief Statistics of all registered mutexes, ranked by accumulated wait time.
+     * @returns Ranked statistics, the most contended mutex first.
+     */
+    std::vector<std::shared_ptr<LockStats const>> ranked(void) const
+    {
+        auto guard = std::lock_guard<std::mutex>(m_mutex);
+        auto ranked = std::vector<std::shared_ptr<LockStats const>>(m_stats.begin(), m_stats.end());
+        std::stable_sort(ranked.begin(), ranked.end(), [] (auto const& lhs, auto const& rhs)
+        {
+            return (lhs->waitNs() != rhs->waitNs()) ? (lhs->waitNs() > rhs->waitNs())
+                                                    : (lhs->contended() > rhs->contended());
+        });
+        return ranked;
+    }
+
+    /**
+     * @brief Human readable report of the most contended mutexes.
+     * @param[in] top   Maximum number of mutexes in the report.
+     * @returns Report with one block per mutex and one line per call site.
+     */
+    std::string report(std::size_t top = 10) const
+    {
+        auto out = std::string();
+        auto line = [&out] (char const* format, auto... args)
+        {
+            char buffer[512];
+            std::snprintf(buffer, sizeof(buffer), format, args...);
+            out += buffer;
+        };
+
+        auto rank = std::size_t(0);
+        for (auto const& stats : ranked())
+        {
+            if (rank == top)
+            {
+                break;
+            }
+            ++rank;
+
+            auto acquisitions = stats->acquisitions();
+            auto contended = stats->contended();
+            line("#%zu %s (%s:%d)\n", rank, stats->name().c_str(), stats->origin().file, stats->origin().line);
+            line("    acquisitions %llu, contended %llu (%.1f%%), wait %llu ns, hold %llu ns\n",
+                 static_cast<unsigned long long>(acquisitions), static_cast<unsigned long long>(contended),
+                 (acquisitions == 0u) ? 0.0 : 100.0 * static_cast<double>(contended) / static_cast<double>(acquisitions),
+                 static_cast<unsigned long long>(stats->waitNs()), static_cast<unsigned long long>(stats->holdNs()));
+            line("    wait p50 < %llu ns, p99 < %llu ns; hold p50 < %llu ns, p99 < %llu ns\n",
+                 static_cast<unsigned long long>(stats->waitHistogram().percentile(0.5)),
+                 static_cast<unsigned long long>(stats->waitHistogram().percentile(0.99)),
+                 static_cast<unsigned long long>(stats->holdHistogram().percentile(0.5)),
+                 static_cast<unsigned long long>(stats->holdHistogram().percentile(0.99)));
+
+            LockSiteStats const* sites = nullptr;
+            auto count = stats->sites(sites);
+            for (auto i = std::size_t(0); i < count; ++i)
+            {
+                line("    %s:%d %s: acquisitions %llu, contended %llu, wait %llu ns\n", sites[i].site.file,
+                     sites[i].site.line, sites[i].site.function,
+                     static_cast<unsigned long long>(sites[i].acquisitions.load(std::memory_order_relaxed)),
+                     static_cast<unsigned long long>(sites[i].contended.load(std::memory_order_relaxed)),
+                     static_cast<unsigned long long>(sites[i].waitNs.load(std::memory_order_relaxed)));
+            }
+        }
+        return out;
+    }
+
+    /**
+     * @brief Forget all registered statistics. Live mutexes keep updating their own.
+     */
+    void clear(void)
+    {
+        auto guard = std::lock_guard<std::mutex>(m_mutex);
+        m_stats.clear();
+    }
+
+private:
+    LockRegistry(void) = default;
+
+    mutable std::mutex                      m_mutex;
+    std::vector<std::shared_ptr<LockStats>> m_stats;
+};
+
+/**
+ * @brief Wrapper around any mutex type recording contention statistics.
+ * @note Each acquisition first calls try_lock. If that fails the acquisition
+ *       counts as contended and the time spent in lock is recorded. Hold times
+ *       are recorded on unlock. LockGuard supplies the call site of every
+ *       acquisition. The statistics are registered in the LockRegistry.
+ * @note Use ProfiledMutex<M> to enable instrumentation at build time only.
+ * @tparam M   The wrapped mutex type. Must implement Lockable.
+ */
+template<typename M>
+class InstrumentedMutex
+{
+public:
+    /// @brief Type of the wrapped mutex.
+    using MutexType = M;
+
+    /**
+     * @brief Constructor.
+     * @param[in] origin   Location of the mutex in reports. Captured automatically.
+     */
+    explicit InstrumentedMutex(CallSite const& origin = CallSite::current())
+        : InstrumentedMutex(origin.function, origin)
+    {
+    }
+
+    /**
+     * @brief Constructor.
+     * @param[in] name     Name of the mutex in reports.
+     * @param[in] origin   Location of the mutex in reports. Captured automatically.
+     */
+    explicit InstrumentedMutex(std::string name, CallSite const& origin = CallSite::current())
+        : m_mutex()
+        , m_stats(LockRegistry::instance().create(std::move(name), origin))
+        , m_acquiredAt()
+    {
+    }
+
+    // Copying and moving is forbidden
+    InstrumentedMutex(InstrumentedMutex const&) = delete;
+    InstrumentedMutex(InstrumentedMutex&&) = delete;
+    InstrumentedMutex& operator = (InstrumentedMutex const&) = delete;
+    InstrumentedMutex& operator = (InstrumentedMutex&&) = delete;
+
+    /**
+     * @brief Acquire the wrapped mutex.
+     * @param[in] site   Location of the acquisition. Captured automatically.
+     */
+    void lock(CallSite const& site = CallSite::current())
+    {
+        if (m_mutex.try_lock())
+        {
+            acquired(site, 0u, false);
+            return;
+        }
+
+        auto start = Clock::now();
+        m_mutex.lock();
+        auto waited = Clock::now() - start;
+        acquired(site, static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(waited).count()),
+                 true);
+    }
+
+    /**
+     * @brief Try to acquire the wrapped mutex without waiting.
+     * @param[in] site   Location of the acquisition. Captured automatically.
+     * @returns true if the mutex was acquired, false if it is held by someone else.
+     */
+    bool try_lock(CallSite const& site = CallSite::current())
+    {
+        if (!m_mutex.try_lock())
+        {
+            return false;
+        }
+        acquired(site, 0u, false);
+        return true;
+    }
+
+    /**
+     * @brief Release the wrapped mutex.
+     */
+    void unlock(void)
+    {
+        auto held = Clock::now() - m_acquiredAt;
+        m_stats->recordRelease(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(held).count()));
+        m_mutex.unlock();
+    }
+
+    /**
+     * @brief Statistics of this mutex.
+     * @returns Reference to the statistics.
+     */
+    LockStats const& stats(void) const noexcept
+    {
+        return *m_stats;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void acquired(CallSite const& site, std::uint64_t waitNs, bool waited)
+    {
+        m_acquiredAt = Clock::now();
+        m_stats->recordAcquisition(site, waitNs, waited);
+    }
+
+    MutexType                  m_mutex;
+    std::shared_ptr<LockStats> m_stats;
+    Clock::time_point          m_acquiredAt;
+};
+
+/**
+ * @brief InstrumentedMutex<M> if SIMONS_LIB_PROFILE_LOCKS is defined, plain M otherwise.
+ * @note Lets call sites stay instrumentable without any cost in regular builds.
+ * @tparam M   The wrapped mutex type.
+ */
+#ifdef SIMONS_LIB_PROFILE_LOCKS
+template<typename M>
+using ProfiledMutex = InstrumentedMutex<M>;
+#else
+template<typename M>
+using ProfiledMutex = M;
+#endif // SIMONS_LIB_PROFILE_LOCKS
+
+} // namespace simons_lib::mutex
+
+#endif // INSTRUMENTED_MUTEX_IMPL_HPP_20190622084530
@@ -0,0 +1,235 @@
+/**
+ * @file      McsLockImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     MCS queue lock.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MCS_LOCK_IMPL_HPP_20190525093041
+#define MCS_LOCK_IMPL_HPP_20190525093041
+
+#include <atomic>
+#include <cstdint>
+#include "../Defines.hpp"
+#include "Detail.hpp"
+
+namespace simons_lib::mutex
+{
+
+/// @cond DO_NOT_DOCUMENT
+namespace detail
+{
+
+// Queue node of McsLock. Each waiter spins on the flag of its own node.
+struct alignas(SIMONS_LIB_CACHE_LINE_SIZE) McsNode
+{
+    std::atomic<McsNode*> next;
+    std::atomic<bool>     locked;
+    McsNode*              free; // Link in the free list of the owning thread.
+};
+
+// Per thread free list of queue nodes. A thread needs one node per McsLock it
+// holds or waits for. Nodes are allocated on first use and released on thread exit.
+class McsNodePool
+{
+public:
+    McsNodePool(void) noexcept
+        : m_free(nullptr)
+    {
+    }
+
+    ~McsNodePool(void)
+    {
+        while (m_free != nullptr)
+        {
+            auto node = m_free;
+            m_free = node->free;
+            delete node;
+        }
+    }
+
+    McsNodePool(McsNodePool const&) = delete;
+    McsNodePool& operator = (McsNodePool const&) = delete;
+
+    McsNode* take(void)
+    {
+        if (m_free == nullptr)
+        {
+            return new McsNode{{nullptr}, {false}, nullptr};
+        }
+        auto node = m_free;
+        m_free = node->free;
+        return node;
+    }
+
+    void give(McsNode* node) noexcept
+    {
+        node->free = m_free;
+        m_free = node;
+    }
+
+    static McsNodePool& local(void)
+    {
+        static thread_local auto pool = McsNodePool();
+        return pool;
+    }
+
+private:
+    McsNode* m_free;
+};
+
+} // namespace detail
+/// @endcond
+
+/**
+ * @brief MCS queue lock (J. M. Mellor-Crummey and M. L. Scott, "Algorithms for
+ *        Scalable Synchronization on Shared-Memory Multiprocessors", 1991).
+ *        Drop-in replacement for std::mutex with FIFO fairness.
+ * @note Waiters form a linked queue. Each waiter spins on a flag in its own
+ *       cache line and the lock holder hands over by writing the flag of its
+ *       successor only, so a release causes a single cache line transfer
+ *       regardless of the number of waiters.
+ * @note Queue nodes are taken from a thread local pool, so lock() and unlock()
+ *       need no arguments and the lock works with LockGuard. Waiters yield to
+ *       the scheduler after spinning for a while, since a preempted thread whose
+ *       turn has come blocks all threads behind it.
+ */
+class alignas(SIMONS_LIB_CACHE_LINE_SIZE) McsLock
+{
+public:
+    /// @brief Number of pause instructions after which waiters start to yield.
+    static constexpr std::uint32_t YIELD_THRESHOLD = 4096;
+
+    /**
+     * @brief Constructor. The lock is initially unlocked.
+     */
+    McsLock(void) noexcept
+        : m_tail(nullptr)
+        , m_holder(nullptr)
+    {
+    }
+
+    // Copying and moving is forbidden
+    McsLock(McsLock const&) = delete;
+    McsLock(McsLock&&) = delete;
+    McsLock& operator = (McsLock const&) = delete;
+    McsLock& operator = (McsLock&&) = delete;
+
+    /**
+     * @brief Acquire the lock. Waits until all earlier waiters are served.
+     */
+    void lock(void)
+    {
+        auto node = detail::McsNodePool::local().take();
+        node->next.store(nullptr, std::memory_order_relaxed);
+        node->locked.store(true, std::memory_order_relaxed);
+
+        auto pred = m_tail.exchange(node, std::memory_order_acq_rel);
+        if (pred != nullptr)
+        {
+            pred->next.store(node, std::memory_order_release);
+            auto spinWait = detail::SpinWait(YIELD_THRESHOLD);
+            while (node->locked.load(std::memory_order_acquire))
+            {
+                spinWait.wait();
+            }
+        }
+        m_holder = node;
+    }
+
+    /**
+     * @brief Try to acquire the lock without waiting.
+     * @returns true if the lock was acquired, false if it is held or waited for.
+     */
+    bool try_lock(void)
+    {
+        if (m_tail.load(std::memory_order_relaxed) != nullptr)
+        {
+            return false;
+        }
+
+        auto& pool = detail::McsNodePool::local();
+        auto node = pool.take();
+        node->next.store(nullptr, std::memory_order_relaxed);
+        node->locked.store(true, std::memory_order_relaxed);
+
+        auto expected = static_cast<detail::McsNode*>(nullptr);
+        if (!m_tail.compare_exchange_strong(expected, node, std::memory_order_acq_rel, std::memory_order_relaxed))
+        {
+            pool.give(node);
+            return false;
+        }
+        m_holder = node;
+        return true;
+    }
+
+    /**
+     * @brief Release the lock and hand it to the next waiter.
+     */
+    void unlock(void) noexcept
+    {
+        auto node = m_holder;
+        auto next = node->next.load(std::memory_order_acquire);
+        if (next == nullptr)
+        {
+            // No known successor. Either the queue is empty or a successor is just enqueuing.
+            auto expected = node;
+            if (m_tail.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel,
+                                               std::memory_order_relaxed))
+            {
+                detail::McsNodePool::local().give(node);
+                return;
+            }
+
+            auto spinWait = detail::SpinWait(YIELD_THRESHOLD);
+            while ((next = node->next.load(std::memory_order_acquire)) == nullptr)
+            {
+                spinWait.wait();
+            }
+        }
+
+        next->locked.store(false, std::memory_order_release);
+        detail::McsNodePool::local().give(node);
+    }
+
+private:
+    std::atomic<detail::McsNode*> m_tail;   // Last node of the queue, nullptr if unlocked.
+    detail::McsNode*              m_holder; // Node of the current holder. Only accessed by the holder.
+};
+
+} // namespace simons_lib::mutex
+
+#endif // MCS_LOCK_IMPL_HPP_20190525093041
@@ -0,0 +1,138 @@
+/**
+ * @file      SpinLockImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Test-and-test-and-set spinlock with exponential backoff.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SPIN_LOCK_IMPL_HPP_20190518100712
+#define SPIN_LOCK_IMPL_HPP_20190518100712
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include "../Defines.hpp"
+#include "Detail.hpp"
+
+namespace simons_lib::mutex
+{
+
+/**
+ * @brief Test-and-test-and-set spinlock. Drop-in replacement for std::mutex.
+ * @note Waiting threads spin on a plain load, so the cache line is shared
+ *       until the lock is released instead of bouncing between cores with
+ *       every attempt. After a failed attempt the spin count between two
+ *       loads doubles from MIN_BACKOFF up to MAX_BACKOFF pause instructions.
+ *       Once the maximum is reached, waiting threads additionally yield to
+ *       the scheduler, so a preempted lock holder can make progress.
+ * @note The lock occupies a whole cache line (SIMONS_LIB_CACHE_LINE_SIZE) to
+ *       avoid false sharing with surrounding data. Meant for short critical
+ *       sections, long ones are better served by std::mutex.
+ */
+class alignas(SIMONS_LIB_CACHE_LINE_SIZE) SpinLock
+{
+public:
+    /// @brief Number of pause instructions after the first failed attempt.
+    static constexpr std::uint32_t MIN_BACKOFF = 4;
+    /// @brief Largest number of pause instructions between two attempts.
+    static constexpr std::uint32_t MAX_BACKOFF = 1024;
+
+    /**
+     * @brief Constructor. The lock is initially unlocked.
+     */
+    SpinLock(void) noexcept
+        : m_locked(false)
+    {
+    }
+
+    // Copying and moving is forbidden
+    SpinLock(SpinLock const&) = delete;
+    SpinLock(SpinLock&&) = delete;
+    SpinLock& operator = (SpinLock const&) = delete;
+    SpinLock& operator = (SpinLock&&) = delete;
+
+    /**
+     * @brief Acquire the lock. Spins until it is available.
+     */
+    void lock(void) noexcept
+    {
+        auto backoff = MIN_BACKOFF;
+        while (m_locked.exchange(true, std::memory_order_acquire))
+        {
+            do
+            {
+                for (auto i = std::uint32_t(0); i < backoff; ++i)
+                {
+                    detail::cpuRelax();
+                }
+
+                if (backoff < MAX_BACKOFF)
+                {
+                    backoff *= 2u;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+            while (m_locked.load(std::memory_order_relaxed));
+        }
+    }
+
+    /**
+     * @brief Try to acquire the lock without waiting.
+     * @returns true if the lock was acquired, false if it is held by someone else.
+     */
+    bool try_lock(void) noexcept
+    {
+        return !m_locked.load(std::memory_order_relaxed) && !m_locked.exchange(true, std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Release the lock.
+     */
+    void unlock(void) noexcept
+    {
+        m_locked.store(false, std::memory_order_release);
+    }
+
+private:
+    std::atomic<bool> m_locked;
+};
+
+} // namespace simons_lib::mutex
+
+#endif // SPIN_LOCK_IMPL_HPP_20190518100712
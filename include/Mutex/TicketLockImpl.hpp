@@ -0,0 +1,126 @@
+/**
+ * @file      TicketLockImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     FIFO ticket lock with proportional backoff.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TICKET_LOCK_IMPL_HPP_20190525093041
+#define TICKET_LOCK_IMPL_HPP_20190525093041
+
+#include <atomic>
+#include <cstdint>
+#include "../Defines.hpp"
+#include "Detail.hpp"
+
+namespace simons_lib::mutex
+{
+
+/**
+ * @brief Ticket lock. Drop-in replacement for std::mutex with FIFO fairness.
+ * @note Each thread draws a ticket and waits until it is served, so no thread
+ *       starves. Waiters pause proportionally to the number of threads in
+ *       front of them, which keeps traffic on the shared cache line low.
+ *       Waiters yield to the scheduler after spinning for a while, since a
+ *       preempted thread whose turn has come blocks all threads behind it.
+ * @note The lock occupies a whole cache line (SIMONS_LIB_CACHE_LINE_SIZE).
+ */
+class alignas(SIMONS_LIB_CACHE_LINE_SIZE) TicketLock
+{
+public:
+    /// @brief Number of pause instructions per waiting thread in front.
+    static constexpr std::uint32_t BACKOFF_PER_WAITER = 32;
+    /// @brief Number of pause instructions after which waiters start to yield.
+    static constexpr std::uint32_t YIELD_THRESHOLD = 4096;
+
+    /**
+     * @brief Constructor. The lock is initially unlocked.
+     */
+    TicketLock(void) noexcept
+        : m_next(0)
+        , m_serving(0)
+    {
+    }
+
+    // Copying and moving is forbidden
+    TicketLock(TicketLock const&) = delete;
+    TicketLock(TicketLock&&) = delete;
+    TicketLock& operator = (TicketLock const&) = delete;
+    TicketLock& operator = (TicketLock&&) = delete;
+
+    /**
+     * @brief Acquire the lock. Waits until all earlier tickets are served.
+     */
+    void lock(void) noexcept
+    {
+        auto ticket = m_next.fetch_add(1u, std::memory_order_relaxed);
+        auto spinWait = detail::SpinWait(YIELD_THRESHOLD);
+        for (auto serving = m_serving.load(std::memory_order_acquire); serving != ticket;
+             serving = m_serving.load(std::memory_order_acquire))
+        {
+            spinWait.wait((ticket - serving) * BACKOFF_PER_WAITER);
+        }
+    }
+
+    /**
+     * @brief Try to acquire the lock without waiting.
+     * @returns true if the lock was acquired, false if it is held or waited for.
+     */
+    bool try_lock(void) noexcept
+    {
+        // Acquire pairs with the release in unlock(), nothing releases m_next.
+        auto serving = m_serving.load(std::memory_order_acquire);
+        auto expected = serving;
+        return m_next.compare_exchange_strong(expected, serving + 1u, std::memory_order_relaxed,
+                                              std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Release the lock and hand it to the next ticket.
+     */
+    void unlock(void) noexcept
+    {
+        m_serving.store(m_serving.load(std::memory_order_relaxed) + 1u, std::memory_order_release);
+    }
+
+private:
+    std::atomic<std::uint32_t> m_next;    // Next ticket to draw.
+    std::atomic<std::uint32_t> m_serving; // Ticket currently holding the lock.
+};
+
+} // namespace simons_lib::mutex
+
+#endif // TICKET_LOCK_IMPL_HPP_20190525093041
@@ -43,5 +43,6 @@
 
 #include "NullTypes/NullObjImpl.hpp"
 #include "NullTypes/NullMutexImpl.hpp"
+#include "NullTypes/NullBarrierImpl.hpp"
 
 #endif // NULL_TYPES_HPP_20180825084201
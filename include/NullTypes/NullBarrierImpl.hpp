@@ -0,0 +1,149 @@
+/**
+ * @file      NullBarrierImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Dummy implementation of the SpinBarrier and SpinLatch interfaces.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef NULL_BARRIER_IMPL_HPP_20190803083112
+#define NULL_BARRIER_IMPL_HPP_20190803083112
+
+#include <chrono>
+#include <cstdint>
+
+namespace simons_lib::null_types
+{
+
+/**
+ * @brief Dummy implementation of the SpinBarrier interface.
+ * @note This class is intended to be optimized out, in cases
+ *       where a single thread runs all phases.
+ */
+class NullBarrier
+{
+public:
+    /**
+     * @brief Constructor. Same signature as SpinBarrier.
+     * @param[in] count   Number of threads, reported by count(). Never waited for.
+     */
+    explicit NullBarrier(std::uint32_t count = 1, std::chrono::nanoseconds = {}) noexcept
+        : m_count(count)
+        , m_phase(0)
+    {
+    }
+
+    /**
+     * @brief Arrive at null barrier. Completes the current phase.
+     * @returns always true, the caller is the only thread.
+     */
+    bool arrive_and_wait(void) noexcept
+    {
+        ++m_phase;
+        return true;
+    }
+
+    /**
+     * @brief Number of threads given on construction.
+     * @returns Number of threads.
+     */
+    std::uint32_t count(void) const noexcept
+    {
+        return m_count;
+    }
+
+    /**
+     * @brief Number of completed phases.
+     * @returns Number of arrive_and_wait() calls (wraps around at 2^32).
+     */
+    std::uint32_t phase(void) const noexcept
+    {
+        return m_phase;
+    }
+
+private:
+    std::uint32_t m_count;
+    std::uint32_t m_phase;
+};
+
+/**
+ * @brief Dummy implementation of the SpinLatch interface.
+ * @note This class is intended to be optimized out, in cases
+ *       where no other thread has to be waited for.
+ */
+class NullLatch
+{
+public:
+    /**
+     * @brief Constructor. Same signature as SpinLatch, the latch is always open.
+     */
+    explicit NullLatch(std::uint32_t = 0, std::chrono::nanoseconds = {}) noexcept
+    {
+    }
+
+    /**
+     * @brief Count down null latch. Does nothing.
+     */
+    void count_down(std::uint32_t = 1) const noexcept
+    {
+    }
+
+    /**
+     * @brief Checks null latch.
+     * @returns always true.
+     */
+    bool try_wait(void) const noexcept
+    {
+        return true;
+    }
+
+    /**
+     * @brief Waits for null latch. Does nothing.
+     */
+    void wait(void) const noexcept
+    {
+    }
+
+    /**
+     * @brief Count down and wait for null latch. Does nothing.
+     */
+    void arrive_and_wait(std::uint32_t = 1) const noexcept
+    {
+    }
+};
+
+} // namespace simons_lib::null_types
+
+#endif // NULL_BARRIER_IMPL_HPP_20190803083112
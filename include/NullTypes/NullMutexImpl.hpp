@@ -45,7 +45,7 @@ namespace simons_lib::null_types
 {
 
 /**
- * @brief Dummy implementation of the std::mutex interface.
+ * @brief Dummy implementation of the std::shared_mutex interface.
  * @note This class is intended to be optimized out, in cases
  *       where thread safety is not required.
  */
@@ -74,6 +74,29 @@ public:
     void unlock(void) const noexcept
     {
     }
+
+    /**
+     * @brief locks null mutex for shared ownership. Does nothing.
+     */
+    void lock_shared(void) const noexcept
+    {
+    }
+
+    /**
+     * @brief try_locks null mutex for shared ownership. Does nothing.
+     * @returns always true;
+     */
+    bool try_lock_shared(void) const noexcept
+    {
+        return true;
+    }
+
+    /**
+     * @brief unlocks null mutex from shared ownership. Does nothing.
+     */
+    void unlock_shared(void) const noexcept
+    {
+    }
 };
 
 } // namespace simons_lib::null_types
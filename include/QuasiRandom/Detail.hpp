@@ -0,0 +1,168 @@
+/**
+ * @file      Detail.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Internal details of QuasiRandom. Not intended for direct usage.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @cond DO_NOT_DOCUMENT
+ * @note Documentation for this file is suppressed to avoid
+ *       polluting the generated documentation with internal details.
+ */
+
+#ifndef DETAIL_HPP_20190413101024
+#define DETAIL_HPP_20190413101024
+
+#include <cstddef>
+#include <cstdint>
+
+namespace simons_lib::quasi_random::detail
+{
+
+// Number of bits per Sobol coordinate.
+constexpr std::size_t SOBOL_BITS = 32;
+
+// Number of dimensions with built-in direction numbers.
+constexpr std::size_t SOBOL_MAX_DIMENSIONS = 21;
+
+// Primitive polynomial of degree s with inner coefficients a and initial
+// direction numbers m[0..s-1] (S. Joe and F. Y. Kuo, new-joe-kuo-6.21201).
+struct SobolPolynomial
+{
+    std::uint32_t s;
+    std::uint32_t a;
+    std::uint32_t m[7];
+};
+
+// Polynomials for dimensions 2 to SOBOL_MAX_DIMENSIONS. Dimension 1 is the
+// van der Corput sequence in base 2 and needs no polynomial.
+constexpr SobolPolynomial SOBOL_POLYNOMIALS[SOBOL_MAX_DIMENSIONS - 1] =
+{
+    {1,  0, {1}},
+    {2,  1, {1, 3}},
+    {3,  1, {1, 3, 1}},
+    {3,  2, {1, 1, 1}},
+    {4,  1, {1, 1, 3, 3}},
+    {4,  4, {1, 3, 5, 13}},
+    {5,  2, {1, 1, 5, 5, 17}},
+    {5,  4, {1, 1, 5, 5, 5}},
+    {5,  7, {1, 1, 7, 11, 19}},
+    {5, 11, {1, 1, 5, 1, 1}},
+    {5, 13, {1, 1, 1, 3, 11}},
+    {5, 14, {1, 3, 5, 5, 31}},
+    {6,  1, {1, 3, 3, 9, 7, 49}},
+    {6, 13, {1, 1, 1, 15, 21, 21}},
+    {6, 16, {1, 3, 1, 13, 27, 49}},
+    {6, 19, {1, 1, 1, 15, 7, 5}},
+    {6, 22, {1, 3, 1, 15, 13, 25}},
+    {6, 25, {1, 1, 5, 5, 19, 61}},
+    {7,  1, {1, 3, 7, 11, 23, 15, 103}},
+    {7,  4, {1, 3, 7, 13, 13, 15, 69}},
+};
+
+// Direction numbers v[d][k] for dimension d and bit k (k = 0 is the most
+// significant bit).
+struct SobolDirections
+{
+    std::uint32_t v[SOBOL_MAX_DIMENSIONS][SOBOL_BITS];
+};
+
+constexpr SobolDirections makeSobolDirections(void)
+{
+    auto directions = SobolDirections{{}};
+    for (auto k = std::size_t(0); k < SOBOL_BITS; ++k)
+    {
+        directions.v[0][k] = std::uint32_t(1) << (SOBOL_BITS - 1 - k);
+    }
+
+    for (auto d = std::size_t(1); d < SOBOL_MAX_DIMENSIONS; ++d)
+    {
+        auto const& poly = SOBOL_POLYNOMIALS[d - 1];
+        auto* v = directions.v[d];
+        for (auto k = std::size_t(0); k < SOBOL_BITS; ++k)
+        {
+            if (k < poly.s)
+            {
+                v[k] = poly.m[k] << (SOBOL_BITS - 1 - k);
+                continue;
+            }
+
+            auto x = v[k - poly.s] ^ (v[k - poly.s] >> poly.s);
+            for (auto i = std::size_t(1); i < poly.s; ++i)
+            {
+                if ((poly.a >> (poly.s - 1 - i)) & 1u)
+                {
+                    x ^= v[k - i];
+                }
+            }
+            v[k] = x;
+        }
+    }
+    return directions;
+}
+
+inline constexpr SobolDirections SOBOL_DIRECTIONS = makeSobolDirections();
+
+// Index of the lowest zero bit of n. Determines the Gray code bit flipped
+// when stepping from point n to point n + 1.
+constexpr std::size_t lowestZeroBit(std::uint64_t n)
+{
+    auto bit = std::size_t(0);
+    while (n & 1u)
+    {
+        n >>= 1;
+        ++bit;
+    }
+    return bit;
+}
+
+// Number of dimensions with built-in Halton bases.
+constexpr std::size_t HALTON_MAX_DIMENSIONS = 32;
+
+// Halton bases are the first HALTON_MAX_DIMENSIONS primes.
+constexpr std::uint32_t HALTON_BASES[HALTON_MAX_DIMENSIONS] =
+{
+      2,   3,   5,   7,  11,  13,  17,  19,  23,  29,  31,  37,  41,  43,  47,  53,
+     59,  61,  67,  71,  73,  79,  83,  89,  97, 101, 103, 107, 109, 113, 127, 131,
+};
+
+} // namespace simons_lib::quasi_random::detail
+#endif // DETAIL_HPP_20190413101024
+
+/**
+ * @endcond DO_NOT_DOCUMENT
+ */
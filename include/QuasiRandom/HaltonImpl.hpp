@@ -0,0 +1,207 @@
+/**
+ * @file      HaltonImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Halton low-discrepancy sequence.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HALTON_IMPL_HPP_20190413101024
+#define HALTON_IMPL_HPP_20190413101024
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include "Detail.hpp"
+
+namespace simons_lib::quasi_random
+{
+
+/**
+ * @brief Halton sequence generator with a random engine interface.
+ * @note Dimension d is the radical inverse of the point index in base of the
+ *       d-th prime. Coordinates are scaled to 32 bit integers like the ones of
+ *       SobolEngine, so both engines are interchangeable. Halton sequences need
+ *       no direction numbers and are free of a period, but their quality
+ *       degrades in high dimensions faster than the one of Sobol sequences.
+ * @tparam D   Number of dimensions. Must be in [1, HaltonEngine::MAX_DIMENSIONS].
+ */
+template<std::size_t D>
+class HaltonEngine
+{
+    static_assert(D > 0u, "HaltonEngine needs at least one dimension. Abort");
+    static_assert(D <= detail::HALTON_MAX_DIMENSIONS, "HaltonEngine dimension not supported. Abort");
+
+public:
+    /// @brief Type of generated coordinates. Coordinate c represents c * 2^-32.
+    using result_type = std::uint32_t;
+    /// @brief Type of a point of the sequence.
+    using PointType = std::array<result_type, D>;
+
+    /// @brief Number of dimensions of each point.
+    static constexpr std::size_t DIMENSIONS = D;
+    /// @brief Largest number of dimensions supported.
+    static constexpr std::size_t MAX_DIMENSIONS = detail::HALTON_MAX_DIMENSIONS;
+
+    /**
+     * @brief Constructor.
+     * @param[in] index   Index of the first point to generate.
+     */
+    explicit HaltonEngine(std::uint64_t index = 0)
+        : m_index(0)
+        , m_dimension(0)
+        , m_point()
+    {
+        seek(index);
+    }
+
+    /// @brief Get smallest value that can be generated.
+    static constexpr result_type min(void)
+    {
+        return 0;
+    }
+
+    /// @brief Get largest value that can be generated.
+    static constexpr result_type max(void)
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    /**
+     * @brief Restart the sequence at a given point. Allows usage as RandomNumberGenerator engine.
+     * @param[in] index   Index of the first point to generate.
+     */
+    void seed(result_type index = 0)
+    {
+        seek(index);
+    }
+
+    /**
+     * @brief Get next coordinate of the current point.
+     * @returns coordinate in [0, 2^32).
+     */
+    result_type operator () (void)
+    {
+        auto value = m_point[m_dimension];
+        if (++m_dimension == D)
+        {
+            advance();
+        }
+        return value;
+    }
+
+    /**
+     * @brief Skip coordinates as if operator () was called @p count times.
+     * @param[in] count   Number of coordinates to skip.
+     */
+    void discard(unsigned long long count)
+    {
+        auto position = m_dimension + (count % D);
+        seek(m_index + (count / D) + (position / D));
+        m_dimension = position % D;
+    }
+
+    /// @brief Advance to the next point.
+    void advance(void)
+    {
+        seek(m_index + 1u);
+    }
+
+    /**
+     * @brief Jump directly to a point. Used to split a sequence across threads.
+     * @param[in] index   Index of the point to jump to.
+     */
+    void seek(std::uint64_t index)
+    {
+        m_index = index;
+        m_dimension = 0;
+        for (auto d = std::size_t(0); d < D; ++d)
+        {
+            m_point[d] = radicalInverse(index, detail::HALTON_BASES[d]);
+        }
+    }
+
+    /// @brief Get index of the current point.
+    std::uint64_t index(void) const
+    {
+        return m_index;
+    }
+
+    /// @brief Get all coordinates of the current point.
+    PointType const& point(void) const
+    {
+        return m_point;
+    }
+
+    /// @brief Compare engines for equality of their state.
+    friend bool operator == (HaltonEngine const& lhs, HaltonEngine const& rhs)
+    {
+        return (lhs.m_index == rhs.m_index) && (lhs.m_dimension == rhs.m_dimension);
+    }
+
+    /// @brief Compare engines for inequality of their state.
+    friend bool operator != (HaltonEngine const& lhs, HaltonEngine const& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    // Mirror the base b digits of index at the radix point, scaled by 2^32.
+    static result_type radicalInverse(std::uint64_t index, std::uint32_t base)
+    {
+        constexpr auto SCALE = 4294967296.0;
+
+        auto value = 0.0;
+        auto factor = 1.0 / base;
+        while (index != 0)
+        {
+            value += static_cast<double>(index % base) * factor;
+            index /= base;
+            factor /= base;
+        }
+
+        auto scaled = value * SCALE;
+        return (scaled < SCALE) ? static_cast<result_type>(scaled) : max();
+    }
+
+    std::uint64_t m_index;     // Index of the current point.
+    std::size_t   m_dimension; // Next coordinate of the current point handed out by operator ().
+    PointType     m_point;     // Coordinates of the current point.
+};
+
+} // namespace simons_lib::quasi_random
+
+#endif // HALTON_IMPL_HPP_20190413101024
@@ -0,0 +1,224 @@
+/**
+ * @file      QuasiUniformRealDistributionImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Uniform real distribution consuming exactly one engine value per call.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef QUASI_UNIFORM_REAL_DISTRIBUTION_IMPL_HPP_20190413101024
+#define QUASI_UNIFORM_REAL_DISTRIBUTION_IMPL_HPP_20190413101024
+
+#include <cmath>
+#include <type_traits>
+
+namespace simons_lib::quasi_random
+{
+
+/**
+ * @brief Uniform real distribution for low-discrepancy engines.
+ * @note std::uniform_real_distribution may consume several engine values per
+ *       generated number, which mixes up the dimensions of SobolEngine and
+ *       HaltonEngine. This distribution maps exactly one engine value to [a, b).
+ * @tparam T   Floating point type of generated values.
+ */
+template<typename T = double>
+class QuasiUniformRealDistribution
+{
+    static_assert(std::is_floating_point<T>::value);
+
+public:
+    /// @brief Type of generated values.
+    using result_type = T;
+
+    /**
+     * @brief Parameter set of QuasiUniformRealDistribution.
+     */
+    class param_type
+    {
+    public:
+        /// @brief Type of the owning distribution.
+        using distribution_type = QuasiUniformRealDistribution;
+
+        /**
+         * @brief Constructor.
+         * @param[in] a   Lower boundary (inclusive).
+         * @param[in] b   Upper boundary (exclusive). Must be >= @p a.
+         */
+        explicit param_type(result_type a = 0, result_type b = 1)
+            : m_a(a)
+            , m_b(b)
+        {
+        }
+
+        /// @brief Get lower boundary.
+        result_type a(void) const
+        {
+            return m_a;
+        }
+
+        /// @brief Get upper boundary.
+        result_type b(void) const
+        {
+            return m_b;
+        }
+
+        /// @brief Compare parameter sets for equality.
+        friend bool operator == (param_type const& lhs, param_type const& rhs)
+        {
+            return (lhs.m_a == rhs.m_a) && (lhs.m_b == rhs.m_b);
+        }
+
+        /// @brief Compare parameter sets for inequality.
+        friend bool operator != (param_type const& lhs, param_type const& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        result_type m_a;
+        result_type m_b;
+    };
+
+    /**
+     * @brief Constructor.
+     * @param[in] a   Lower boundary (inclusive).
+     * @param[in] b   Upper boundary (exclusive). Must be >= @p a.
+     */
+    explicit QuasiUniformRealDistribution(result_type a = 0, result_type b = 1)
+        : m_param(a, b)
+    {
+    }
+
+    /**
+     * @brief Constructor.
+     * @param[in] param   Parameter set to use.
+     */
+    explicit QuasiUniformRealDistribution(param_type const& param)
+        : m_param(param)
+    {
+    }
+
+    /// @brief Reset internal state. The distribution is stateless, this does nothing.
+    void reset(void)
+    {
+    }
+
+    /// @brief Get lower boundary.
+    result_type a(void) const
+    {
+        return m_param.a();
+    }
+
+    /// @brief Get upper boundary.
+    result_type b(void) const
+    {
+        return m_param.b();
+    }
+
+    /// @brief Get current parameter set.
+    param_type param(void) const
+    {
+        return m_param;
+    }
+
+    /// @brief Set new parameter set.
+    void param(param_type const& param)
+    {
+        m_param = param;
+    }
+
+    /// @brief Get smallest value that can be generated.
+    result_type min(void) const
+    {
+        return a();
+    }
+
+    /// @brief Get upper boundary of generated values.
+    result_type max(void) const
+    {
+        return b();
+    }
+
+    /**
+     * @brief Generate next value using the current parameter set.
+     * @param[in] engine   Engine to draw exactly one value from.
+     * @returns value in [a, b).
+     */
+    template<typename E>
+    result_type operator () (E& engine)
+    {
+        return (*this)(engine, m_param);
+    }
+
+    /**
+     * @brief Generate next value using a given parameter set.
+     * @param[in] engine   Engine to draw exactly one value from.
+     * @param[in] param    Parameter set used for this call only.
+     * @returns value in [param.a(), param.b()).
+     */
+    template<typename E>
+    result_type operator () (E& engine, param_type const& param)
+    {
+        constexpr auto RANGE = static_cast<result_type>(E::max() - E::min()) + result_type(1);
+
+        auto unit = static_cast<result_type>(engine() - E::min()) / RANGE;
+        if (unit >= result_type(1))
+        {
+            // Rounding of wide engine values to narrow floating point types.
+            unit = std::nextafter(result_type(1), result_type(0));
+        }
+        return param.a() + (param.b() - param.a()) * unit;
+    }
+
+    /// @brief Compare distributions for equality.
+    friend bool operator == (QuasiUniformRealDistribution const& lhs, QuasiUniformRealDistribution const& rhs)
+    {
+        return lhs.m_param == rhs.m_param;
+    }
+
+    /// @brief Compare distributions for inequality.
+    friend bool operator != (QuasiUniformRealDistribution const& lhs, QuasiUniformRealDistribution const& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    param_type m_param;
+};
+
+} // namespace simons_lib::quasi_random
+
+#endif // QUASI_UNIFORM_REAL_DISTRIBUTION_IMPL_HPP_20190413101024
@@ -41,24 +41,44 @@
 #ifndef RANDOM_NUMBER_GENERATOR_IMPL_HPP_20180923091648
 #define RANDOM_NUMBER_GENERATOR_IMPL_HPP_20180923091648
 
+#include <cstdint>
 #include <random>
+#include <type_traits>
 #include "../LockGuard.hpp"
 #include "../NullTypes.hpp"
+#include "../SyncPolicy.hpp"
 
 namespace simons_lib::random_number_generator
 {
 
 using simons_lib::null_types::NullMutex;
 using simons_lib::lock::LockGuard;
+using simons_lib::sync_policy::PolicyOf;
+using simons_lib::sync_policy::SyncKind;
+
+/// @cond DO_NOT_DOCUMENT
+namespace detail
+{
+// Per-thread engines for sync_policy::ThreadLocal, defined in ThreadLocalImpl.hpp.
+template<typename E, typename D, typename M>
+class ThreadLocalStreams;
+} // namespace detail
+/// @endcond DO_NOT_DOCUMENT
 
 /**
  * @brief Thin wrapper around the STL random number generator facilities.
  * @tparam E   Random engine type to use.
  * @tparam D   Distribution type to use.
- * @tparam M   Mutex used for synchronization, defaults to NullMutex.
- *             If thread safety is required, supply std::mutex
+ * @tparam P   Synchronization policy or mutex type, defaults to NullMutex.
+ *             If thread safety is required, supply std::mutex.
+ *             With sync_policy::ThreadLocal every thread draws from its own
+ *             engine and distribution, seeded with a stream derived from the
+ *             seed. Threads never share state on the hot path, but the
+ *             sequence of values depends on the order threads first draw.
+ *             It requires RandomNumberGenerator/ThreadLocalImpl.hpp.
+ *             sync_policy::Atomic is not supported.
  */
-template <typename E, typename D, typename M = NullMutex>
+template <typename E, typename D, typename P = NullMutex>
 class RandomNumberGenerator
 {
 public:
@@ -66,12 +86,73 @@ public:
     using EngineType = E;
     /// @brief Used random distribution type.
     using DistributionType = D;
+    /// @brief Used synchronization policy.
+    using PolicyType = typename PolicyOf<P>::type;
     /// @brief Used mutex type for synchronization.
-    using MutexType = M;
+    using MutexType = typename PolicyType::MutexType;
     /// @brief type of resulting values generated by RNG
     using ResultType = typename DistributionType::result_type;
     /// @brief type of RNG seed
     using SeedType = typename EngineType::result_type;
+    /// @brief type of distribution parameters accepted per call
+    using ParamType = typename DistributionType::param_type;
+
+    static_assert(PolicyType::KIND != SyncKind::ATOMIC,
+                  "RandomNumberGenerator does not support sync_policy::Atomic, use sync_policy::ThreadLocal");
+
+    /**
+     * @brief Synchronized view on the random engine of a RandomNumberGenerator.
+     * @note Satisfies UniformRandomBitGenerator. The mutex is held for a
+     *       single engine step only, so the view can be handed to any
+     *       distribution without holding the lock during value shaping.
+     */
+    class EngineView
+    {
+    public:
+        /// @brief type of values generated by the engine
+        using result_type = typename EngineType::result_type;
+
+        /**
+         * @brief Constructor.
+         * @param[in] rng   RandomNumberGenerator whose engine should be used.
+         */
+        explicit EngineView(RandomNumberGenerator& rng) noexcept
+            : m_rng(rng)
+        {
+        }
+
+        /// @returns smallest value the engine can produce.
+        static constexpr result_type min(void)
+        {
+            return EngineType::min();
+        }
+
+        /// @returns largest value the engine can produce.
+        static constexpr result_type max(void)
+        {
+            return EngineType::max();
+        }
+
+        /**
+         * @brief Advance the engine by a single step.
+         * @returns raw engine output
+         */
+        result_type operator () (void)
+        {
+            if constexpr (THREAD_LOCAL)
+            {
+                return m_rng.localStream().engine();
+            }
+            else
+            {
+                auto guard = LockGuard<MutexType>(m_rng.m_mutex);
+                return m_rng.m_engine();
+            }
+        }
+
+    private:
+        RandomNumberGenerator& m_rng;
+    };
 
     /**
      * @brief Constructor. Create RNG with a given seed.
@@ -80,7 +161,24 @@ public:
     RandomNumberGenerator(SeedType seed)
         : m_engine()
         , m_distribution()
+        , m_paramDistribution()
         , m_mutex()
+        , m_streams(seed)
+    {
+        m_engine.seed(seed);
+    }
+
+    /**
+     * @brief Constructor. Create RNG with a given seed and distribution.
+     * @param[in] seed           The seed used to initialize RNGs random engine.
+     * @param[in] distribution   The distribution used to shape generated values.
+     */
+    RandomNumberGenerator(SeedType seed, DistributionType const& distribution)
+        : m_engine()
+        , m_distribution(distribution)
+        , m_paramDistribution()
+        , m_mutex()
+        , m_streams(seed)
     {
         m_engine.seed(seed);
     }
@@ -99,6 +197,11 @@ public:
             return false;
         }
         m_distribution.param(typename DistributionType::param_type(lowerBound, upperBound));
+        if constexpr (THREAD_LOCAL)
+        {
+            // Threads pick up the new boundaries on their next draw.
+            m_streams.invalidate();
+        }
         return true;
     }
 
@@ -108,14 +211,79 @@ public:
      */
     ResultType operator () (void)
     {
-        auto guard = LockGuard<MutexType>(m_mutex);
-        return m_distribution(m_engine);
+        if constexpr (THREAD_LOCAL)
+        {
+            auto& stream = localStream();
+            return stream.distribution(stream.engine);
+        }
+        else
+        {
+            auto guard = LockGuard<MutexType>(m_mutex);
+            return m_distribution(m_engine);
+        }
+    }
+
+    /**
+     * @brief Get next random number shaped by the given parameters.
+     * @note The configured distribution is left untouched. This allows
+     *       concurrent callers to draw from different ranges without calling
+     *       setBoundries. Values are shaped by a second distribution owned by
+     *       this RandomNumberGenerator via its param overload, so @p param is
+     *       never copied and RNGs with equal seeds yield equal sequences even
+     *       for stateful distributions. The mutex is held for the whole call.
+     * @param[in] param   Distribution parameters used for this call only.
+     * @returns random number
+     */
+    ResultType operator () (ParamType const& param)
+    {
+        if constexpr (THREAD_LOCAL)
+        {
+            auto& stream = localStream();
+            return stream.distribution(stream.engine, param);
+        }
+        else
+        {
+            auto guard = LockGuard<MutexType>(m_mutex);
+            return m_paramDistribution(m_engine, param);
+        }
+    }
+
+    /**
+     * @brief Get synchronized access to the random engine.
+     * @note The returned view must not outlive this RandomNumberGenerator.
+     * @returns view on the engine, usable with any distribution.
+     */
+    EngineView engine(void) noexcept
+    {
+        return EngineView(*this);
     }
 
 private:
+    static constexpr bool THREAD_LOCAL = (PolicyType::KIND == SyncKind::THREAD_LOCAL);
+
+    // Placeholder for the per-thread streams with all other policies.
+    struct NoStreams
+    {
+        explicit NoStreams(SeedType) noexcept
+        {
+        }
+    };
+
+    // Stream of the calling thread, seeded and updated under the mutex.
+    auto& localStream(void)
+    {
+        return m_streams.local(m_mutex, m_distribution);
+    }
+
+    // Using sync_policy::ThreadLocal without including
+    // RandomNumberGenerator/ThreadLocalImpl.hpp fails here with an incomplete type.
+    using StreamsType = std::conditional_t<THREAD_LOCAL, detail::ThreadLocalStreams<E, D, MutexType>, NoStreams>;
+
     EngineType       m_engine;
     DistributionType m_distribution;
+    DistributionType m_paramDistribution; // Shapes values of per-call parameters.
     MutexType        m_mutex;
+    StreamsType      m_streams;
 };
 
 } // namespace simons_lib::random_number_generator
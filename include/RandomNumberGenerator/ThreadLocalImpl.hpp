@@ -0,0 +1,113 @@
+/**
+ * @file      ThreadLocalImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Support of sync_policy::ThreadLocal for RandomNumberGenerator.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef THREAD_LOCAL_IMPL_HPP_20190811120312
+#define THREAD_LOCAL_IMPL_HPP_20190811120312
+
+#include <atomic>
+#include <cstdint>
+#include "../Detail/Parallel.hpp"
+#include "../Detail/ThreadRecords.hpp"
+#include "../LockGuard.hpp"
+#include "RandomNumberGeneratorImpl.hpp"
+
+namespace simons_lib::random_number_generator
+{
+
+/// @cond DO_NOT_DOCUMENT
+namespace detail
+{
+
+// Engines and distributions owned by single threads. Each thread's engine
+// is seeded with a stream derived from the seed on its first draw.
+template<typename E, typename D, typename M>
+class ThreadLocalStreams
+{
+public:
+    // Engine and distribution owned by a single thread.
+    struct Stream : simons_lib::detail::ThreadRecord
+    {
+        E             engine;
+        D             distribution;
+        std::uint64_t version = 0; // Version of the copied distribution, 0 if unseeded.
+    };
+
+    explicit ThreadLocalStreams(std::uint64_t seed)
+        : m_seed(seed)
+    {
+    }
+
+    // Stream of the calling thread. Seeding and copying the distribution
+    // happens under mutex, which guards distribution.
+    Stream& local(M& mutex, D const& distribution)
+    {
+        auto& stream = m_records.local();
+        if (stream.version != m_version.load(std::memory_order_acquire))
+        {
+            auto guard = simons_lib::lock::LockGuard<M>(mutex);
+            if (stream.version == 0u)
+            {
+                stream.engine.seed(static_cast<typename E::result_type>(simons_lib::detail::deriveSeed(m_seed, m_next++)));
+            }
+            stream.distribution = distribution;
+            stream.version = m_version.load(std::memory_order_relaxed);
+        }
+        return stream;
+    }
+
+    // Make threads copy the distribution again on their next draw.
+    void invalidate(void)
+    {
+        m_version.fetch_add(1, std::memory_order_release);
+    }
+
+private:
+    std::uint64_t                          m_seed;
+    std::uint64_t                          m_next = 0;      // Index of the next derived stream.
+    std::atomic<std::uint64_t>             m_version = {1}; // Bumped on boundary changes.
+    simons_lib::detail::RecordList<Stream> m_records;
+};
+
+} // namespace detail
+/// @endcond DO_NOT_DOCUMENT
+
+} // namespace simons_lib::random_number_generator
+
+#endif // THREAD_LOCAL_IMPL_HPP_20190811120312
@@ -0,0 +1,143 @@
+/**
+ * @file      Detail.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Internal details of Reclamation. Not intended for direct usage.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @cond DO_NOT_DOCUMENT
+ * @note Documentation for this file is suppressed to avoid
+ *       polluting the generated documentation with internal details.
+ */
+
+#ifndef DETAIL_HPP_20190629091512
+#define DETAIL_HPP_20190629091512
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "../Detail/ThreadRecords.hpp"
+
+#if defined(__linux__)
+#include <linux/membarrier.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace simons_lib::reclamation::detail
+{
+
+// Asymmetric fences: readers issue a compiler barrier only (lightFence), while
+// reclaimers force a full barrier on every thread of the process (heavyFence,
+// Linux membarrier). Together they order like a seq_cst fence on both sides.
+// Without membarrier both degrade to regular seq_cst fences.
+inline bool membarrierAvailable(void) noexcept
+{
+#if defined(__linux__) && defined(SYS_membarrier)
+    static auto const available =
+        (syscall(SYS_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0, 0) == 0);
+    return available;
+#else
+    return false;
+#endif
+}
+
+inline void lightFence(void) noexcept
+{
+    if (membarrierAvailable())
+    {
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+    }
+    else
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+}
+
+inline void heavyFence(void) noexcept
+{
+#if defined(__linux__) && defined(SYS_membarrier)
+    if (membarrierAvailable())
+    {
+        syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0);
+        return;
+    }
+#endif
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+// Object waiting to be freed.
+struct Retired
+{
+    void*         ptr;
+    void          (*deleter)(void*);
+    std::uint64_t epoch;
+};
+
+template<typename T>
+void deleteObject(void* ptr)
+{
+    delete static_cast<T*>(ptr);
+}
+
+inline void freeAll(std::vector<Retired>& retired)
+{
+    for (auto const& item : retired)
+    {
+        item.deleter(item.ptr);
+    }
+    retired.clear();
+}
+
+// Per-thread state of a domain. Records of exited threads are reused by new
+// threads, which also inherit their pending retired objects.
+struct RecordBase : simons_lib::detail::ThreadRecord
+{
+    std::vector<Retired> retired;
+};
+
+// Lock-free iterable list of per-thread records of a domain.
+template<typename R>
+using RecordList = simons_lib::detail::RecordList<R>;
+
+} // namespace simons_lib::reclamation::detail
+
+#endif // DETAIL_HPP_20190629091512
+
+/**
+ * @endcond DO_NOT_DOCUMENT
+ */
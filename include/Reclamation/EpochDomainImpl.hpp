@@ -0,0 +1,343 @@
+/**
+ * @file      EpochDomainImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Epoch based memory reclamation.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EPOCH_DOMAIN_IMPL_HPP_20190629091512
+#define EPOCH_DOMAIN_IMPL_HPP_20190629091512
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "../LockGuard.hpp"
+#include "../Mutex/Detail.hpp"
+#include "../Mutex/SpinLockImpl.hpp"
+#include "Detail.hpp"
+
+namespace simons_lib::reclamation
+{
+
+using simons_lib::lock::LockGuard;
+
+class EpochDomain;
+
+/**
+ * @brief RAII guard marking the calling thread as reader of an EpochDomain.
+ * @note Objects reachable while the guard is alive are not freed before the
+ *       guard is destroyed. Guards can be nested. Obtain guards via EpochDomain::pin().
+ */
+class EpochGuard
+{
+public:
+    ~EpochGuard(void) noexcept;
+
+    // Copying and moving is forbidden
+    EpochGuard(EpochGuard const&) = delete;
+    EpochGuard(EpochGuard&&) = delete;
+    EpochGuard& operator = (EpochGuard const&) = delete;
+    EpochGuard& operator = (EpochGuard&&) = delete;
+
+private:
+    friend class EpochDomain;
+
+    struct Record;
+
+    explicit EpochGuard(Record& record) noexcept
+        : m_record(record)
+    {
+    }
+
+    Record& m_record;
+};
+
+/// @cond DO_NOT_DOCUMENT
+struct EpochGuard::Record : detail::RecordBase
+{
+    static constexpr auto QUIESCENT = std::numeric_limits<std::uint64_t>::max();
+
+    std::atomic<std::uint64_t> epoch = {QUIESCENT}; // Epoch the thread is pinned in.
+    std::uint32_t              nesting = 0;         // Number of alive guards.
+    mutex::SpinLock            retiredLock;         // Guards retired, synchronize() drains other threads.
+};
+/// @endcond
+
+/**
+ * @brief Epoch based reclamation (EBR) domain.
+ * @note Readers pin the current global epoch with an EpochGuard, which costs
+ *       a few loads and stores to thread private memory. The matching memory
+ *       barrier is issued by reclaiming threads on behalf of all readers
+ *       (membarrier on Linux, a regular fence per pin elsewhere). Writers
+ *       unlink an object and retire it instead of deleting it. The global
+ *       epoch advances once every pinned reader has observed it. Objects
+ *       retired in epoch e are freed as soon as the global epoch reached e + 2,
+ *       then no reader can hold a reference anymore. Retired objects are freed
+ *       in batches by the retiring thread, or earlier via reclaim().
+ * @note Garbage is unbounded if a reader stays pinned forever. Use HazardDomain
+ *       if readers might block while holding references.
+ */
+class EpochDomain
+{
+public:
+    /// @brief Default number of retired objects per thread that trigger a reclamation attempt.
+    static constexpr std::size_t DEFAULT_BATCH_SIZE = 64;
+
+    /**
+     * @brief Constructor.
+     * @param[in] batchSize   Number of objects a thread retires before trying to free them.
+     */
+    explicit EpochDomain(std::size_t batchSize = DEFAULT_BATCH_SIZE)
+        : m_epoch(0)
+        , m_batchSize((batchSize == 0u) ? 1u : batchSize)
+        , m_records()
+    {
+    }
+
+    /**
+     * @brief Destructor. Frees all retired objects.
+     * @note No thread may use the domain concurrently or afterwards.
+     */
+    ~EpochDomain(void)
+    {
+        m_records.forEach([] (Record& record)
+        {
+            detail::freeAll(record.retired);
+        });
+    }
+
+    // Copying and moving is forbidden
+    EpochDomain(EpochDomain const&) = delete;
+    EpochDomain(EpochDomain&&) = delete;
+    EpochDomain& operator = (EpochDomain const&) = delete;
+    EpochDomain& operator = (EpochDomain&&) = delete;
+
+    /**
+     * @brief Process wide default domain.
+     * @returns Reference to the default domain.
+     */
+    static EpochDomain& global(void)
+    {
+        static auto domain = EpochDomain();
+        return domain;
+    }
+
+    /**
+     * @brief Enter a read-side critical section.
+     * @returns Guard protecting all objects reachable until it is destroyed.
+     */
+    EpochGuard pin(void)
+    {
+        auto& record = m_records.local();
+        if (record.nesting++ == 0u)
+        {
+            record.epoch.store(m_epoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+            // Publish the pin before any shared pointer is read. Pairs with heavyFence in tryAdvance.
+            detail::lightFence();
+        }
+        return EpochGuard(record);
+    }
+
+    /**
+     * @brief Retire an object allocated with new. It is deleted once no reader can access it.
+     * @note The object must already be unreachable for new readers.
+     * @param[in] ptr   Object to retire.
+     */
+    template<typename T>
+    void retire(T* ptr)
+    {
+        retire(static_cast<void*>(ptr), &detail::deleteObject<T>);
+    }
+
+    /**
+     * @brief Retire an object with a custom deleter.
+     * @param[in] ptr       Object to retire.
+     * @param[in] deleter   Function freeing @p ptr.
+     */
+    void retire(void* ptr, void (*deleter)(void*))
+    {
+        auto& record = m_records.local();
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto full = false;
+        {
+            auto guard = LockGuard<mutex::SpinLock>(record.retiredLock);
+            record.retired.push_back(detail::Retired{ptr, deleter, m_epoch.load(std::memory_order_relaxed)});
+            full = (record.retired.size() >= m_batchSize);
+        }
+        if (full)
+        {
+            tryAdvance();
+            collect(record);
+        }
+    }
+
+    /**
+     * @brief Try to free the objects retired by the calling thread without waiting.
+     * @note Advances the global epoch up to two times if no reader lags behind,
+     *       then frees everything retired before. Useful for rare retires of
+     *       large objects that should not wait for a full batch.
+     */
+    void reclaim(void)
+    {
+        if (tryAdvance())
+        {
+            tryAdvance();
+        }
+        collect(m_records.local());
+    }
+
+    /**
+     * @brief Wait until all objects retired so far by any thread are freed.
+     * @note Must not be called while the calling thread holds an EpochGuard.
+     *       Objects retired by other threads are freed by the calling thread.
+     */
+    void synchronize(void)
+    {
+        auto target = m_epoch.load(std::memory_order_seq_cst) + 2u;
+        auto spinWait = mutex::detail::SpinWait(YIELD_THRESHOLD);
+        while (m_epoch.load(std::memory_order_seq_cst) < target)
+        {
+            if (!tryAdvance())
+            {
+                spinWait.wait();
+            }
+        }
+
+        m_records.forEach([this] (Record& record)
+        {
+            collect(record);
+        });
+    }
+
+    /**
+     * @brief Number of retired objects of the calling thread waiting to be freed.
+     * @returns Number of pending objects.
+     */
+    std::size_t pending(void)
+    {
+        auto& record = m_records.local();
+        auto guard = LockGuard<mutex::SpinLock>(record.retiredLock);
+        return record.retired.size();
+    }
+
+    /**
+     * @brief Current global epoch.
+     * @returns Global epoch, advances over time.
+     */
+    std::uint64_t epoch(void) const noexcept
+    {
+        return m_epoch.load(std::memory_order_relaxed);
+    }
+
+private:
+    using Record = EpochGuard::Record;
+
+    static constexpr std::uint32_t YIELD_THRESHOLD = 4096;
+
+    // Advance the global epoch if all pinned readers observed the current one.
+    bool tryAdvance(void)
+    {
+        // A reader visibly pinned in an older epoch blocks anyway, skip the
+        // heavy fence (an interrupt on every CPU running the process) then.
+        if (!observed(m_epoch.load(std::memory_order_seq_cst)))
+        {
+            return false;
+        }
+
+        detail::heavyFence();
+        auto epoch = m_epoch.load(std::memory_order_seq_cst);
+        return observed(epoch) && m_epoch.compare_exchange_strong(epoch, epoch + 1u, std::memory_order_seq_cst);
+    }
+
+    // Check if no reader is pinned in an epoch before the given one.
+    bool observed(std::uint64_t epoch)
+    {
+        auto observed = true;
+        m_records.forEach([epoch, &observed] (Record& record)
+        {
+            auto pinned = record.epoch.load(std::memory_order_seq_cst);
+            observed = observed && ((pinned == Record::QUIESCENT) || (pinned == epoch));
+        });
+        return observed;
+    }
+
+    // Free all objects of a record retired two or more epochs ago. Records
+    // of other threads may be passed as well. Deleters run after the lock is
+    // released, they may retire further objects.
+    void collect(Record& record)
+    {
+        auto freeable = std::vector<detail::Retired>();
+        {
+            auto guard = LockGuard<mutex::SpinLock>(record.retiredLock);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            auto epoch = m_epoch.load(std::memory_order_relaxed);
+            auto& retired = record.retired;
+            auto kept = std::size_t(0);
+            for (auto i = std::size_t(0); i < retired.size(); ++i)
+            {
+                if (retired[i].epoch + 2u <= epoch)
+                {
+                    freeable.push_back(retired[i]);
+                }
+                else
+                {
+                    retired[kept++] = retired[i];
+                }
+            }
+            retired.resize(kept);
+        }
+        detail::freeAll(freeable);
+    }
+
+    std::atomic<std::uint64_t> m_epoch;
+    std::size_t                m_batchSize;
+    detail::RecordList<Record> m_records;
+};
+
+inline EpochGuard::~EpochGuard(void) noexcept
+{
+    if (--m_record.nesting == 0u)
+    {
+        m_record.epoch.store(Record::QUIESCENT, std::memory_order_release);
+    }
+}
+
+} // namespace simons_lib::reclamation
+
+#endif // EPOCH_DOMAIN_IMPL_HPP_20190629091512
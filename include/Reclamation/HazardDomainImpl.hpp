@@ -0,0 +1,312 @@
+/**
+ * @file      HazardDomainImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Hazard pointer based memory reclamation.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HAZARD_DOMAIN_IMPL_HPP_20190629091512
+#define HAZARD_DOMAIN_IMPL_HPP_20190629091512
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+#include "Detail.hpp"
+
+namespace simons_lib::reclamation
+{
+
+class HazardDomain;
+
+/**
+ * @brief Slot publishing a single pointer that must not be freed.
+ * @note Obtain slots via HazardDomain::makeHazardPointer(). Claiming a slot
+ *       scans the slots of the domain, keep hazard pointers around and reuse
+ *       them for many protect() calls.
+ */
+class HazardPointer
+{
+public:
+    ~HazardPointer(void) noexcept;
+
+    // Copying and moving is forbidden
+    HazardPointer(HazardPointer const&) = delete;
+    HazardPointer(HazardPointer&&) = delete;
+    HazardPointer& operator = (HazardPointer const&) = delete;
+    HazardPointer& operator = (HazardPointer&&) = delete;
+
+    /**
+     * @brief Protect the object @p source points to.
+     * @note Replaces the previously protected object.
+     * @param[in] source   Shared pointer to load and protect.
+     * @returns Loaded pointer, safe to dereference until reset() or the next protect().
+     */
+    template<typename T>
+    T* protect(std::atomic<T*> const& source) noexcept
+    {
+        auto ptr = source.load(std::memory_order_relaxed);
+        while (true)
+        {
+            m_slot.ptr.store(ptr, std::memory_order_relaxed);
+
+            // Still reachable after publishing, so no reclaimer can miss it.
+            // Pairs with heavyFence in HazardDomain::scan.
+            detail::lightFence();
+            auto current = source.load(std::memory_order_acquire);
+            if (current == ptr)
+            {
+                return ptr;
+            }
+            ptr = current;
+        }
+    }
+
+    /**
+     * @brief Stop protecting the current object.
+     */
+    void reset(void) noexcept
+    {
+        m_slot.ptr.store(nullptr, std::memory_order_release);
+    }
+
+private:
+    friend class HazardDomain;
+
+    struct Slot
+    {
+        std::atomic<void*> ptr = {nullptr};
+        std::atomic<bool>  claimed = {true};
+        Slot*              next = nullptr; // Immutable once published.
+    };
+
+    explicit HazardPointer(Slot& slot) noexcept
+        : m_slot(slot)
+    {
+    }
+
+    Slot& m_slot;
+};
+
+/**
+ * @brief Hazard pointer domain.
+ * @note Readers publish each pointer they dereference in a HazardPointer.
+ *       Writers unlink an object and retire it. Once a thread retired a batch
+ *       of objects it frees all of them that are not published by any hazard
+ *       pointer. Unlike EpochDomain, a blocked reader holds back only the
+ *       objects it protects, so garbage per thread is bounded by the batch
+ *       size plus the number of hazard pointers. Readers pay a store per object,
+ *       the memory barrier is issued by scanning threads (membarrier on Linux).
+ */
+class HazardDomain
+{
+public:
+    /// @brief Default number of retired objects per thread that trigger a scan.
+    static constexpr std::size_t DEFAULT_BATCH_SIZE = 64;
+
+    /**
+     * @brief Constructor.
+     * @param[in] batchSize   Number of objects a thread retires before scanning hazard pointers.
+     */
+    explicit HazardDomain(std::size_t batchSize = DEFAULT_BATCH_SIZE)
+        : m_batchSize((batchSize == 0u) ? 1u : batchSize)
+        , m_slots(nullptr)
+        , m_records()
+    {
+    }
+
+    /**
+     * @brief Destructor. Frees all retired objects.
+     * @note No thread may use the domain concurrently or afterwards,
+     *       all hazard pointers must have been destroyed.
+     */
+    ~HazardDomain(void)
+    {
+        m_records.forEach([] (Record& record)
+        {
+            detail::freeAll(record.retired);
+        });
+
+        auto slot = m_slots.load(std::memory_order_acquire);
+        while (slot)
+        {
+            auto next = slot->next;
+            delete slot;
+            slot = next;
+        }
+    }
+
+    // Copying and moving is forbidden
+    HazardDomain(HazardDomain const&) = delete;
+    HazardDomain(HazardDomain&&) = delete;
+    HazardDomain& operator = (HazardDomain const&) = delete;
+    HazardDomain& operator = (HazardDomain&&) = delete;
+
+    /**
+     * @brief Process wide default domain.
+     * @returns Reference to the default domain.
+     */
+    static HazardDomain& global(void)
+    {
+        static auto domain = HazardDomain();
+        return domain;
+    }
+
+    /**
+     * @brief Claim a hazard pointer. It is released on destruction.
+     * @returns Unused hazard pointer.
+     */
+    HazardPointer makeHazardPointer(void)
+    {
+        for (auto slot = m_slots.load(std::memory_order_acquire); slot; slot = slot->next)
+        {
+            auto expected = false;
+            if (!slot->claimed.load(std::memory_order_relaxed) &&
+                slot->claimed.compare_exchange_strong(expected, true, std::memory_order_acquire))
+            {
+                return HazardPointer(*slot);
+            }
+        }
+
+        auto slot = new Slot();
+        slot->next = m_slots.load(std::memory_order_relaxed);
+        while (!m_slots.compare_exchange_weak(slot->next, slot, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+        return HazardPointer(*slot);
+    }
+
+    /**
+     * @brief Retire an object allocated with new. It is deleted once no hazard pointer protects it.
+     * @note The object must already be unreachable for new readers.
+     * @param[in] ptr   Object to retire.
+     */
+    template<typename T>
+    void retire(T* ptr)
+    {
+        retire(static_cast<void*>(ptr), &detail::deleteObject<T>);
+    }
+
+    /**
+     * @brief Retire an object with a custom deleter.
+     * @param[in] ptr       Object to retire.
+     * @param[in] deleter   Function freeing @p ptr.
+     */
+    void retire(void* ptr, void (*deleter)(void*))
+    {
+        auto& record = m_records.local();
+        record.retired.push_back(detail::Retired{ptr, deleter, 0u});
+        if (record.retired.size() >= m_batchSize)
+        {
+            scan(record);
+        }
+    }
+
+    /**
+     * @brief Free all retired objects of the calling thread and of exited threads
+     *        that are not protected right now.
+     */
+    void reclaim(void)
+    {
+        scan(m_records.local());
+        m_records.forEach([this] (Record& record)
+        {
+            auto expected = false;
+            if (record.inUse.compare_exchange_strong(expected, true, std::memory_order_acquire))
+            {
+                scan(record);
+                record.inUse.store(false, std::memory_order_release);
+            }
+        });
+    }
+
+    /**
+     * @brief Number of retired objects of the calling thread waiting to be freed.
+     * @returns Number of pending objects.
+     */
+    std::size_t pending(void)
+    {
+        return m_records.local().retired.size();
+    }
+
+private:
+    using Slot = HazardPointer::Slot;
+    using Record = detail::RecordBase;
+
+    // Free all retired objects of a record not published in any slot.
+    void scan(Record& record)
+    {
+        detail::heavyFence();
+        auto hazards = std::vector<void*>();
+        for (auto slot = m_slots.load(std::memory_order_acquire); slot; slot = slot->next)
+        {
+            if (auto ptr = slot->ptr.load(std::memory_order_seq_cst))
+            {
+                hazards.push_back(ptr);
+            }
+        }
+        std::sort(hazards.begin(), hazards.end());
+
+        auto& retired = record.retired;
+        auto kept = std::size_t(0);
+        for (auto i = std::size_t(0); i < retired.size(); ++i)
+        {
+            if (std::binary_search(hazards.begin(), hazards.end(), retired[i].ptr))
+            {
+                retired[kept++] = retired[i];
+            }
+            else
+            {
+                retired[i].deleter(retired[i].ptr);
+            }
+        }
+        retired.resize(kept);
+    }
+
+    std::size_t                m_batchSize;
+    std::atomic<Slot*>         m_slots;
+    detail::RecordList<Record> m_records;
+};
+
+inline HazardPointer::~HazardPointer(void) noexcept
+{
+    m_slot.ptr.store(nullptr, std::memory_order_release);
+    m_slot.claimed.store(false, std::memory_order_release);
+}
+
+} // namespace simons_lib::reclamation
+
+#endif // HAZARD_DOMAIN_IMPL_HPP_20190629091512
@@ -0,0 +1,202 @@
+/**
+ * @file      RcuImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Read-copy-update holder of immutable snapshots.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RCU_IMPL_HPP_20190706090213
+#define RCU_IMPL_HPP_20190706090213
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include "../LockGuard.hpp"
+#include "../NullTypes.hpp"
+#include "EpochDomainImpl.hpp"
+
+namespace simons_lib::reclamation
+{
+
+using simons_lib::null_types::NullMutex;
+using simons_lib::lock::LockGuard;
+
+/**
+ * @brief Read-copy-update holder for rarely replaced, frequently read objects.
+ * @note Readers obtain an immutable snapshot without any lock. A read pins
+ *       the EpochDomain (a store to a thread private record and a compiler
+ *       barrier, see EpochDomain) and loads the current version, it never
+ *       writes memory shared with other readers. Writers publish a new version
+ *       with a single exchange, retire the old one and try to reclaim right
+ *       away. A replaced version is deleted after all readers holding it
+ *       moved on, by a later update() on the same thread or by synchronize()
+ *       on any thread.
+ * @tparam T   Type of the held object.
+ * @tparam M   Mutex serializing modify() calls (defaults to NullMutex).
+ *             Readers and update() never lock it.
+ */
+template<typename T, typename M = NullMutex>
+class Rcu
+{
+public:
+    /// @brief Type of the held object.
+    using ValueType = T;
+    /// @brief Type of supplied mutex.
+    using MutexType = M;
+
+    /**
+     * @brief Pinned read-only view of a version. Valid until destruction.
+     * @note Keep snapshots short lived, a pinned reader delays the reclamation
+     *       of all objects retired in the same EpochDomain.
+     */
+    class Snapshot
+    {
+    public:
+        // Copying and moving is forbidden
+        Snapshot(Snapshot const&) = delete;
+        Snapshot(Snapshot&&) = delete;
+        Snapshot& operator = (Snapshot const&) = delete;
+        Snapshot& operator = (Snapshot&&) = delete;
+
+        /// @brief Access the pinned version.
+        ValueType const& operator * (void) const noexcept { return *m_ptr; }
+        /// @brief Access the pinned version.
+        ValueType const* operator -> (void) const noexcept { return m_ptr; }
+        /// @brief Access the pinned version.
+        ValueType const* get(void) const noexcept { return m_ptr; }
+
+    private:
+        friend class Rcu;
+
+        Snapshot(EpochDomain& domain, std::atomic<ValueType const*> const& current) noexcept
+            : m_guard(domain.pin())
+            , m_ptr(current.load(std::memory_order_acquire))
+        {
+        }
+
+        EpochGuard       m_guard;
+        ValueType const* m_ptr;
+    };
+
+    /**
+     * @brief Constructor.
+     * @param[in] initial   Initial version. Must not be null.
+     * @param[in] domain    Domain used to reclaim old versions.
+     */
+    explicit Rcu(std::unique_ptr<ValueType const> initial, EpochDomain& domain = EpochDomain::global()) noexcept
+        : m_domain(domain)
+        , m_current(initial.release())
+        , m_mutex()
+    {
+    }
+
+    /**
+     * @brief Destructor. Retires the current version.
+     * @note No snapshot of this holder may be alive.
+     */
+    ~Rcu(void)
+    {
+        retire(m_current.load(std::memory_order_relaxed));
+    }
+
+    // Copying and moving is forbidden
+    Rcu(Rcu const&) = delete;
+    Rcu(Rcu&&) = delete;
+    Rcu& operator = (Rcu const&) = delete;
+    Rcu& operator = (Rcu&&) = delete;
+
+    /**
+     * @brief Get the current version. Wait-free.
+     * @returns Snapshot pinning the current version.
+     */
+    Snapshot read(void) const noexcept
+    {
+        return Snapshot(m_domain, m_current);
+    }
+
+    /**
+     * @brief Publish a new version. The previous one is reclaimed once unused.
+     * @note Also frees earlier versions no reader holds anymore, so at most
+     *       the versions still read are kept alive between updates.
+     * @param[in] next   New version. Must not be null.
+     */
+    void update(std::unique_ptr<ValueType const> next)
+    {
+        retire(m_current.exchange(next.release(), std::memory_order_acq_rel));
+        m_domain.reclaim();
+    }
+
+    /**
+     * @brief Publish a modified copy of the current version.
+     * @note Concurrent modify() calls are serialized through M, so no
+     *       modification is lost. Concurrent update() calls are not
+     *       serialized and may be overwritten.
+     * @param[in] func   Callable invoked as func(ValueType&) on the copy.
+     */
+    template<typename F>
+    void modify(F&& func)
+    {
+        auto guard = LockGuard<MutexType>(m_mutex);
+        auto next = std::make_unique<ValueType>(*read());
+        func(*next);
+        update(std::move(next));
+    }
+
+    /**
+     * @brief Wait until all replaced versions are deleted.
+     * @note Must not be called while the calling thread holds a snapshot.
+     *       Versions replaced by update() on other threads are deleted by
+     *       the calling thread.
+     */
+    void synchronize(void)
+    {
+        m_domain.synchronize();
+    }
+
+private:
+    void retire(ValueType const* ptr)
+    {
+        m_domain.retire(const_cast<ValueType*>(ptr));
+    }
+
+    EpochDomain&                  m_domain;
+    std::atomic<ValueType const*> m_current;
+    MutexType                     m_mutex;
+};
+
+} // namespace simons_lib::reclamation
+
+#endif // RCU_IMPL_HPP_20190706090213
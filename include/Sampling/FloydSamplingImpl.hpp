@@ -0,0 +1,88 @@
+/**
+ * @file      FloydSamplingImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Sampling without replacement (Robert Floyd's algorithm).
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FLOYD_SAMPLING_IMPL_HPP_20190330101744
+#define FLOYD_SAMPLING_IMPL_HPP_20190330101744
+
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+#include "../Distributions/Detail.hpp"
+
+namespace simons_lib::sampling
+{
+
+/**
+ * @brief Draw @p k distinct values out of [0, @p n) (Robert Floyd's algorithm).
+ * @note Needs exactly k engine draws and O(k) memory, [0, n) is never materialized.
+ *       Every k-subset is equally likely, the order of the returned values is
+ *       however not uniformly random. Shuffle the result if required.
+ * @param[in] n        Size of the population.
+ * @param[in] k        Number of values to draw. Values larger than @p n are clamped to @p n.
+ * @param[in] engine   Random engine to draw bits from.
+ * @returns k distinct values in [0, n).
+ */
+template<typename E>
+std::vector<std::uint64_t> floydSample(std::uint64_t n, std::uint64_t k, E& engine)
+{
+    k = (k < n) ? k : n;
+
+    auto selected = std::unordered_set<std::uint64_t>();
+    auto result = std::vector<std::uint64_t>();
+    selected.reserve(static_cast<std::size_t>(k));
+    result.reserve(static_cast<std::size_t>(k));
+
+    for (auto j = n - k; j < n; ++j)
+    {
+        auto t = simons_lib::distributions::detail::uniformBelow<std::uint64_t>(engine, j + 1u);
+        if (!selected.insert(t).second)
+        {
+            // t was already drawn, j is new for sure.
+            t = j;
+            selected.insert(t);
+        }
+        result.push_back(t);
+    }
+    return result;
+}
+
+} // namespace simons_lib::sampling
+
+#endif // FLOYD_SAMPLING_IMPL_HPP_20190330101744
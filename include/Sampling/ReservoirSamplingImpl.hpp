@@ -0,0 +1,427 @@
+/**
+ * @file      ReservoirSamplingImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Uniform (Algorithm L) and weighted (A-ExpJ) reservoir sampling.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RESERVOIR_SAMPLING_IMPL_HPP_20190427113015
+#define RESERVOIR_SAMPLING_IMPL_HPP_20190427113015
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../Distributions/Detail.hpp"
+
+namespace simons_lib::sampling
+{
+
+/**
+ * @brief Uniform sample of up to k items of a stream of unknown length (Algorithm L).
+ * @note After the reservoir is filled, the sampler draws the number of items
+ *       to skip until the next replacement (K.-H. Li, "Reservoir-Sampling
+ *       Algorithms of Time Complexity O(n(1 + log(N/n)))", 1994). Skipped
+ *       items cost a decrement only, the engine is used O(k * log(n / k)) times
+ *       for a stream of n items.
+ * @note The sampler is not synchronized. Use one sampler per thread.
+ * @tparam T   Type of sampled items.
+ * @tparam E   Random engine type to use.
+ */
+template<typename T, typename E>
+class ReservoirSampler
+{
+public:
+    /// @brief Type of sampled items.
+    using ValueType = T;
+    /// @brief Used random engine type.
+    using EngineType = E;
+
+    /**
+     * @brief Constructor.
+     * @param[in] capacity   Number of items to sample (k).
+     * @param[in] engine     Random engine to draw bits from.
+     */
+    ReservoirSampler(std::size_t capacity, EngineType engine)
+        : m_engine(std::move(engine))
+        , m_capacity(capacity)
+        , m_seen(0)
+        , m_skip(0)
+        , m_w(1.0)
+        , m_items()
+    {
+        m_items.reserve(capacity);
+    }
+
+    /**
+     * @brief Offer the next item of the stream.
+     * @param[in] item   Item to offer.
+     */
+    void push(ValueType const& item)
+    {
+        offer([&item] () -> ValueType const& { return item; });
+    }
+
+    /**
+     * @brief Offer the next item of the stream.
+     * @param[in] item   Item to offer. Only moved from if it enters the reservoir.
+     */
+    void push(ValueType&& item)
+    {
+        offer([&item] () -> ValueType&& { return std::move(item); });
+    }
+
+    /**
+     * @brief Offer a range of items.
+     * @note For random access iterators skipped items are not visited at all.
+     * @param[in] first   Begin of the range.
+     * @param[in] last    End of the range.
+     */
+    template<typename InputIt>
+    void push(InputIt first, InputIt last)
+    {
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+
+        while (first != last)
+        {
+            if constexpr (std::is_base_of<std::random_access_iterator_tag, Category>::value)
+            {
+                if (m_skip > 0)
+                {
+                    auto available = static_cast<std::uint64_t>(last - first);
+                    auto step = (m_skip < available) ? m_skip : available;
+                    first += static_cast<typename std::iterator_traits<InputIt>::difference_type>(step);
+                    m_skip -= step;
+                    m_seen += step;
+                    continue;
+                }
+            }
+            push(*first);
+            ++first;
+        }
+    }
+
+    /// @brief Get currently sampled items. Their order is unspecified.
+    std::vector<ValueType> const& samples(void) const
+    {
+        return m_items;
+    }
+
+    /// @brief Get number of items offered so far.
+    std::uint64_t seen(void) const
+    {
+        return m_seen;
+    }
+
+    /// @brief Get number of items to sample.
+    std::size_t capacity(void) const
+    {
+        return m_capacity;
+    }
+
+    /// @brief Drop all samples and start over with a new stream.
+    void reset(void)
+    {
+        m_seen = 0;
+        m_skip = 0;
+        m_w = 1.0;
+        m_items.clear();
+    }
+
+private:
+    template<typename Get>
+    void offer(Get get)
+    {
+        ++m_seen;
+        if (m_capacity == 0)
+        {
+            return;
+        }
+
+        if (m_items.size() < m_capacity)
+        {
+            m_items.push_back(get());
+            if (m_items.size() == m_capacity)
+            {
+                m_w = nextW();
+                m_skip = nextSkip();
+            }
+            return;
+        }
+
+        if (m_skip > 0)
+        {
+            --m_skip;
+            return;
+        }
+
+        auto slot = distributions::detail::uniformBelow<std::uint64_t>(m_engine, m_capacity);
+        m_items[static_cast<std::size_t>(slot)] = get();
+        m_w *= nextW();
+        m_skip = nextSkip();
+    }
+
+    // Random factor exp(log(u) / k) shrinking the replacement probability.
+    double nextW(void)
+    {
+        return std::exp(std::log(uniform()) / static_cast<double>(m_capacity));
+    }
+
+    // Geometric number of items to skip before the next replacement.
+    std::uint64_t nextSkip(void)
+    {
+        auto skip = std::floor(std::log(uniform()) / std::log1p(-m_w));
+        constexpr auto LIMIT = 18446744073709549568.0; // Largest double below 2^64.
+        return (skip < LIMIT) ? static_cast<std::uint64_t>(skip) : static_cast<std::uint64_t>(LIMIT);
+    }
+
+    double uniform(void)
+    {
+        return distributions::detail::toOpenUnitInterval(distributions::detail::uniformBits<std::uint64_t>(m_engine));
+    }
+
+    EngineType             m_engine;
+    std::size_t            m_capacity;
+    std::uint64_t          m_seen;  // Items offered so far.
+    std::uint64_t          m_skip;  // Items left to skip until the next replacement.
+    double                 m_w;     // Current largest key of Algorithm L.
+    std::vector<ValueType> m_items;
+};
+
+/**
+ * @brief Weighted sample of up to k items of a stream of unknown length (A-ExpJ).
+ * @note Each item receives the key u^(1/w) and the k items with the largest
+ *       keys are kept (P. S. Efraimidis and P. G. Spirakis, "Weighted random
+ *       sampling with a reservoir", 2006). Instead of drawing a key per item,
+ *       the sampler draws the amount of weight to skip until the next item
+ *       enters the reservoir, so the engine is used O(k * log(n / k)) times.
+ *       Keys are stored as log(u) / w to avoid underflow for small weights.
+ * @note The sampler is not synchronized. Use one sampler per thread.
+ * @tparam T   Type of sampled items.
+ * @tparam E   Random engine type to use.
+ */
+template<typename T, typename E>
+class WeightedReservoirSampler
+{
+public:
+    /// @brief Type of sampled items.
+    using ValueType = T;
+    /// @brief Used random engine type.
+    using EngineType = E;
+
+    /**
+     * @brief Constructor.
+     * @param[in] capacity   Number of items to sample (k).
+     * @param[in] engine     Random engine to draw bits from.
+     */
+    WeightedReservoirSampler(std::size_t capacity, EngineType engine)
+        : m_engine(std::move(engine))
+        , m_capacity(capacity)
+        , m_seen(0)
+        , m_skipWeight(0.0)
+        , m_heap()
+        , m_items()
+    {
+        m_heap.reserve(capacity);
+        m_items.reserve(capacity);
+    }
+
+    /**
+     * @brief Offer the next item of the stream.
+     * @param[in] item     Item to offer.
+     * @param[in] weight   Weight of the item. Must be finite and > 0.
+     * @returns true in case of success, false if @p weight is invalid. Invalid items are ignored.
+     */
+    bool push(ValueType const& item, double weight)
+    {
+        return offer([&item] () -> ValueType const& { return item; }, weight);
+    }
+
+    /**
+     * @brief Offer the next item of the stream.
+     * @param[in] item     Item to offer. Only moved from if it enters the reservoir.
+     * @param[in] weight   Weight of the item. Must be finite and > 0.
+     * @returns true in case of success, false if @p weight is invalid. Invalid items are ignored.
+     */
+    bool push(ValueType&& item, double weight)
+    {
+        return offer([&item] () -> ValueType&& { return std::move(item); }, weight);
+    }
+
+    /// @brief Get currently sampled items. Their order is unspecified.
+    std::vector<ValueType> const& samples(void) const
+    {
+        return m_items;
+    }
+
+    /// @brief Get number of valid items offered so far.
+    std::uint64_t seen(void) const
+    {
+        return m_seen;
+    }
+
+    /// @brief Get number of items to sample.
+    std::size_t capacity(void) const
+    {
+        return m_capacity;
+    }
+
+    /// @brief Drop all samples and start over with a new stream.
+    void reset(void)
+    {
+        m_seen = 0;
+        m_skipWeight = 0.0;
+        m_heap.clear();
+        m_items.clear();
+    }
+
+private:
+    // Reservoir slot ordered by key, the smallest key is at the front of the heap.
+    struct Key
+    {
+        double      key;
+        std::size_t slot;
+    };
+
+    template<typename Get>
+    bool offer(Get get, double weight)
+    {
+        if (!(weight > 0.0) || !std::isfinite(weight))
+        {
+            return false;
+        }
+
+        ++m_seen;
+        if (m_capacity == 0)
+        {
+            return true;
+        }
+
+        if (m_items.size() < m_capacity)
+        {
+            m_heap.push_back(Key{std::log(uniform()) / weight, m_items.size()});
+            siftUp(m_heap.size() - 1u);
+            m_items.push_back(get());
+            if (m_items.size() == m_capacity)
+            {
+                m_skipWeight = nextSkipWeight();
+            }
+            return true;
+        }
+
+        m_skipWeight -= weight;
+        if (m_skipWeight > 0.0)
+        {
+            return true;
+        }
+
+        // The item enters the reservoir, its key is drawn from (minKey, 0).
+        auto threshold = std::exp(weight * m_heap.front().key);
+        auto u = threshold + (1.0 - threshold) * uniform();
+        m_heap.front().key = std::log(u) / weight;
+        m_items[m_heap.front().slot] = get();
+        siftDown(0);
+
+        m_skipWeight = nextSkipWeight();
+        return true;
+    }
+
+    // Min-heap maintenance. Written out instead of std::push_heap/pop_heap
+    // since the replacement of the smallest key needs a single sift down.
+    void siftUp(std::size_t index)
+    {
+        while (index > 0)
+        {
+            auto parent = (index - 1u) / 2u;
+            if (m_heap[parent].key <= m_heap[index].key)
+            {
+                break;
+            }
+            std::swap(m_heap[parent], m_heap[index]);
+            index = parent;
+        }
+    }
+
+    void siftDown(std::size_t index)
+    {
+        auto size = m_heap.size();
+        while (true)
+        {
+            auto smallest = index;
+            auto left = 2u * index + 1u;
+            auto right = left + 1u;
+            if (left < size && m_heap[left].key < m_heap[smallest].key)
+            {
+                smallest = left;
+            }
+            if (right < size && m_heap[right].key < m_heap[smallest].key)
+            {
+                smallest = right;
+            }
+            if (smallest == index)
+            {
+                break;
+            }
+            std::swap(m_heap[smallest], m_heap[index]);
+            index = smallest;
+        }
+    }
+
+    // Amount of weight to skip until the next item enters the reservoir.
+    double nextSkipWeight(void)
+    {
+        return std::log(uniform()) / m_heap.front().key;
+    }
+
+    double uniform(void)
+    {
+        return distributions::detail::toOpenUnitInterval(distributions::detail::uniformBits<std::uint64_t>(m_engine));
+    }
+
+    EngineType             m_engine;
+    std::size_t            m_capacity;
+    std::uint64_t          m_seen;       // Valid items offered so far.
+    double                 m_skipWeight; // Weight left to skip until the next replacement.
+    std::vector<Key>       m_heap;
+    std::vector<ValueType> m_items;
+};
+
+} // namespace simons_lib::sampling
+
+#endif // RESERVOIR_SAMPLING_IMPL_HPP_20190427113015
@@ -0,0 +1,188 @@
+/**
+ * @file      ShuffleImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Sequential and parallel (MergeShuffle) random permutation.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SHUFFLE_IMPL_HPP_20190330101744
+#define SHUFFLE_IMPL_HPP_20190330101744
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <utility>
+#include "../Detail/Parallel.hpp"
+#include "../Distributions/Detail.hpp"
+
+namespace simons_lib::sampling
+{
+
+/**
+ * @brief Fisher-Yates shuffle. Replacement for std::shuffle.
+ * @note Indices are drawn with Lemire's nearly divisionless method instead of
+ *       std::uniform_int_distribution.
+ * @param[in] first    Begin of the range to shuffle.
+ * @param[in] last     End of the range to shuffle.
+ * @param[in] engine   Random engine to draw bits from.
+ */
+template<typename RandomIt, typename E>
+void shuffle(RandomIt first, RandomIt last, E& engine)
+{
+    using std::swap;
+
+    auto n = static_cast<std::uint64_t>(std::distance(first, last));
+    for (auto i = n; i > 1u; --i)
+    {
+        auto j = simons_lib::distributions::detail::uniformBelow<std::uint64_t>(engine, i);
+        swap(first[static_cast<std::ptrdiff_t>(i - 1)], first[static_cast<std::ptrdiff_t>(j)]);
+    }
+}
+
+/// @cond DO_NOT_DOCUMENT
+namespace detail
+{
+
+// Merge two adjacent, uniformly shuffled ranges [first, mid) and [mid, last)
+// into a uniformly shuffled range (Bacher et al., "MergeShuffle", 2015).
+template<typename RandomIt, typename E>
+void mergeShuffled(RandomIt first, RandomIt mid, RandomIt last, E& engine)
+{
+    using std::swap;
+
+    auto i = first;
+    auto j = mid;
+    auto bits = std::uint64_t(0);
+    auto bitsLeft = 0;
+    while (true)
+    {
+        if (bitsLeft == 0)
+        {
+            bits = simons_lib::distributions::detail::uniformBits<std::uint64_t>(engine);
+            bitsLeft = 64;
+        }
+        auto coin = bits & 1u;
+        bits >>= 1;
+        --bitsLeft;
+
+        if (coin == 0u)
+        {
+            if (i == j)
+            {
+                break;
+            }
+        }
+        else
+        {
+            if (j == last)
+            {
+                break;
+            }
+            swap(*i, *j);
+            ++j;
+        }
+        ++i;
+    }
+
+    // Insert the remaining elements at random positions.
+    for (; i != last; ++i)
+    {
+        auto bound = static_cast<std::uint64_t>(std::distance(first, i)) + 1u;
+        auto k = simons_lib::distributions::detail::uniformBelow<std::uint64_t>(engine, bound);
+        swap(*i, first[static_cast<std::ptrdiff_t>(k)]);
+    }
+}
+
+} // namespace detail
+/// @endcond
+
+/**
+ * @brief Parallel, cache-blocked shuffle (MergeShuffle).
+ * @note The range is split into cache sized blocks which are shuffled in
+ *       parallel. Afterwards adjacent blocks are merged pairwise in parallel,
+ *       level by level. Every block and merge step draws from its own engine
+ *       seeded deterministically from @p seed, so the result only depends on
+ *       @p seed and never on the number of threads.
+ * @tparam E   Random engine type used for all blocks and merge steps.
+ * @param[in] first     Begin of the range to shuffle.
+ * @param[in] last      End of the range to shuffle.
+ * @param[in] seed      Seed of the permutation.
+ * @param[in] threads   Number of threads to use, 0 selects the hardware concurrency.
+ */
+template<typename E = std::mt19937_64, typename RandomIt>
+void parallelShuffle(RandomIt first, RandomIt last, std::uint64_t seed, std::size_t threads = 0)
+{
+    using ValueType = typename std::iterator_traits<RandomIt>::value_type;
+    constexpr auto BLOCK_BYTES = std::size_t(256 * 1024);
+    constexpr auto BLOCK_SIZE = (BLOCK_BYTES / sizeof(ValueType) > 0u) ? BLOCK_BYTES / sizeof(ValueType) : 1u;
+
+    auto n = static_cast<std::size_t>(std::distance(first, last));
+    auto blocks = std::size_t(1);
+    while (blocks * BLOCK_SIZE < n)
+    {
+        blocks *= 2u;
+    }
+
+    auto boundary = [first, n, blocks] (std::size_t block)
+    {
+        return first + static_cast<std::ptrdiff_t>(block * n / blocks);
+    };
+
+    auto stream = std::uint64_t(0);
+    simons_lib::detail::parallelFor(blocks, threads, [&] (std::size_t block)
+    {
+        auto engine = simons_lib::detail::makeEngine<E>(seed, stream + block);
+        shuffle(boundary(block), boundary(block + 1), engine);
+    });
+    stream += blocks;
+
+    for (auto width = std::size_t(1); width < blocks; width *= 2u)
+    {
+        auto merges = blocks / (2u * width);
+        simons_lib::detail::parallelFor(merges, threads, [&] (std::size_t merge)
+        {
+            auto engine = simons_lib::detail::makeEngine<E>(seed, stream + merge);
+            auto block = merge * 2u * width;
+            detail::mergeShuffled(boundary(block), boundary(block + width), boundary(block + 2u * width), engine);
+        });
+        stream += merges;
+    }
+}
+
+} // namespace simons_lib::sampling
+
+#endif // SHUFFLE_IMPL_HPP_20190330101744
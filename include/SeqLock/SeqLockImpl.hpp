@@ -0,0 +1,216 @@
+/**
+ * @file      SeqLockImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Sequence lock container. Readers never write shared memory.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SEQ_LOCK_IMPL_HPP_20190608083115
+#define SEQ_LOCK_IMPL_HPP_20190608083115
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "../Defines.hpp"
+#include "../LockGuard.hpp"
+#include "../Mutex/Detail.hpp"
+#include "../NullTypes.hpp"
+
+namespace simons_lib::seq_lock
+{
+
+using simons_lib::null_types::NullMutex;
+using simons_lib::lock::LockGuard;
+
+/**
+ * @brief Container for small trivially copyable values that are read often and written rarely.
+ * @note Readers take a snapshot of the value and retry if a writer was active
+ *       in the meantime. They never write shared memory, so readers on different
+ *       CPUs do not bounce cache lines between each other. Writers are
+ *       serialized through M and make readers retry, keep T small and writes rare.
+ * @tparam T   Stored value type. Must be trivially copyable and default constructible.
+ * @tparam M   Mutex serializing writers (defaults to NullMutex).
+ *             NullMutex is sufficient if there is only a single writing thread.
+ */
+template<typename T, typename M = NullMutex>
+class SeqLock
+{
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock requires a trivially copyable T. Abort");
+
+public:
+    /// @brief Type of the stored value.
+    using ValueType = T;
+    /// @brief Type of supplied mutex.
+    using MutexType = M;
+
+    /// @brief Number of pause instructions after which waiting readers start to yield.
+    static constexpr std::uint32_t YIELD_THRESHOLD = 4096;
+
+    /**
+     * @brief Constructor.
+     * @param[in] value   Initially stored value.
+     */
+    explicit SeqLock(ValueType const& value = ValueType()) noexcept
+        : m_seq(0)
+        , m_words()
+        , m_mutex()
+    {
+        storeWords(value);
+    }
+
+    // Copying and moving is forbidden
+    SeqLock(SeqLock const&) = delete;
+    SeqLock(SeqLock&&) = delete;
+    SeqLock& operator = (SeqLock const&) = delete;
+    SeqLock& operator = (SeqLock&&) = delete;
+
+    /**
+     * @brief Get a consistent snapshot of the stored value.
+     * @note Waits while a writer is active.
+     * @returns Copy of the stored value.
+     */
+    ValueType load(void) const noexcept
+    {
+        auto spinWait = mutex::detail::SpinWait(YIELD_THRESHOLD);
+        auto value = ValueType();
+        while (!tryLoad(value))
+        {
+            spinWait.wait();
+        }
+        return value;
+    }
+
+    /**
+     * @brief Try to get a consistent snapshot of the stored value without waiting.
+     * @param[out] value   Receives the snapshot on success. Unchanged otherwise.
+     * @returns true on success, false if a writer was active during the read.
+     */
+    bool tryLoad(ValueType& value) const noexcept
+    {
+        auto seq = m_seq.load(std::memory_order_acquire);
+        if (seq & 1u)
+        {
+            return false;
+        }
+
+        Words words;
+        loadWords(words);
+
+        // Order the data loads before the validating sequence load.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_seq.load(std::memory_order_relaxed) != seq)
+        {
+            return false;
+        }
+
+        std::memcpy(&value, words, sizeof(ValueType));
+        return true;
+    }
+
+    /**
+     * @brief Replace the stored value.
+     * @param[in] value   New value.
+     */
+    void store(ValueType const& value) noexcept
+    {
+        auto guard = LockGuard<MutexType>(m_mutex);
+        publish(value);
+    }
+
+    /**
+     * @brief Modify the stored value.
+     * @note @p func runs on a private copy while holding the writer mutex.
+     *       Readers are disturbed only while the result is published.
+     * @param[in] func   Callable invoked as func(ValueType&).
+     */
+    template<typename F>
+    void update(F&& func)
+    {
+        auto guard = LockGuard<MutexType>(m_mutex);
+
+        // Writers are serialized, the current value can be read without validation.
+        Words words;
+        loadWords(words);
+        auto value = ValueType();
+        std::memcpy(&value, words, sizeof(ValueType));
+
+        func(value);
+        publish(value);
+    }
+
+private:
+    // Value is kept in atomic words, so concurrent reads and writes are no data race.
+    static constexpr auto WORDS = (sizeof(ValueType) + sizeof(std::uintptr_t) - 1u) / sizeof(std::uintptr_t);
+    using Words = std::uintptr_t[WORDS];
+
+    void loadWords(Words& words) const noexcept
+    {
+        for (auto i = std::size_t(0); i < WORDS; ++i)
+        {
+            words[i] = m_words[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    void storeWords(ValueType const& value) noexcept
+    {
+        Words words = {};
+        std::memcpy(words, &value, sizeof(ValueType));
+        for (auto i = std::size_t(0); i < WORDS; ++i)
+        {
+            m_words[i].store(words[i], std::memory_order_relaxed);
+        }
+    }
+
+    void publish(ValueType const& value) noexcept
+    {
+        // Odd sequence number marks an active writer.
+        auto seq = m_seq.load(std::memory_order_relaxed);
+        m_seq.store(seq + 1u, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        storeWords(value);
+        m_seq.store(seq + 2u, std::memory_order_release);
+    }
+
+    alignas(SIMONS_LIB_CACHE_LINE_SIZE) std::atomic<std::uint32_t> m_seq;
+    std::atomic<std::uintptr_t> m_words[WORDS];
+    MutexType                   m_mutex;
+};
+
+} // namespace simons_lib::seq_lock
+
+#endif // SEQ_LOCK_IMPL_HPP_20190608083115
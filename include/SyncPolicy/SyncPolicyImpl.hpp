@@ -0,0 +1,162 @@
+/**
+ * @file      SyncPolicyImpl.hpp
+ * @author    Simon Brummer (<simon.brummer@posteo.de>)
+ * @brief     Synchronization policies and the mapping of raw mutex types onto them.
+ * @copyright 2018 Simon Brummer. All rights reserved.\n
+ *            This project is released under the BSD 3-Clause License.
+ */
+
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2018, Simon Brummer
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SYNC_POLICY_IMPL_HPP_20190727101533
+#define SYNC_POLICY_IMPL_HPP_20190727101533
+
+#include <type_traits>
+#include "../NullTypes.hpp"
+
+namespace simons_lib::sync_policy
+{
+
+using simons_lib::null_types::NullMutex;
+
+/**
+ * @brief Kinds of synchronization a class can specialize on.
+ */
+enum class SyncKind
+{
+    SINGLE_THREADED, ///< No synchronization at all.
+    MUTEX,           ///< All access is serialized by a mutex.
+    ATOMIC,          ///< Shared state is published with atomics, no locks on the hot path.
+    THREAD_LOCAL     ///< Each thread works on its own state.
+};
+
+/**
+ * @brief Policy for objects used by a single thread only.
+ * @note Equivalent to passing NullMutex.
+ */
+struct SingleThreaded
+{
+    /// @brief Kind of synchronization.
+    static constexpr SyncKind KIND = SyncKind::SINGLE_THREADED;
+    /// @brief Mutex type, nothing is locked.
+    using MutexType = NullMutex;
+};
+
+/**
+ * @brief Policy serializing all access with a mutex.
+ * @note Equivalent to passing the mutex type itself.
+ * @tparam M   Mutex type to use (e.g. std::mutex, SpinLock).
+ */
+template<typename M>
+struct MutexPolicy
+{
+    /// @brief Kind of synchronization.
+    static constexpr SyncKind KIND = SyncKind::MUTEX;
+    /// @brief Mutex type to use.
+    using MutexType = M;
+};
+
+/**
+ * @brief Policy publishing shared state with atomics.
+ * @note Readers never lock. Writers may race and the loser discards its work.
+ */
+struct Atomic
+{
+    /// @brief Kind of synchronization.
+    static constexpr SyncKind KIND = SyncKind::ATOMIC;
+    /// @brief Mutex type, nothing is locked.
+    using MutexType = NullMutex;
+};
+
+/**
+ * @brief Policy giving each thread its own state.
+ * @note The hot path touches thread private memory only. MutexType guards
+ *       the rarely changed state threads copy their own state from.
+ * @tparam M   Mutex type guarding the shared state (e.g. std::mutex, SpinLock).
+ */
+template<typename M>
+struct ThreadLocal
+{
+    /// @brief Kind of synchronization.
+    static constexpr SyncKind KIND = SyncKind::THREAD_LOCAL;
+    /// @brief Mutex guarding the shared state.
+    using MutexType = M;
+};
+
+/**
+ * @brief Check if type P is a synchronization policy.
+ * @tparam P   Type to check.
+ */
+template<typename P, typename = void>
+struct IsSyncPolicy : std::false_type
+{
+};
+
+/// @cond DO_NOT_DOCUMENT
+template<typename P>
+struct IsSyncPolicy<P, std::void_t<decltype(P::KIND)>> : std::is_same<SyncKind const, decltype(P::KIND)>
+{
+};
+/// @endcond DO_NOT_DOCUMENT
+
+/**
+ * @brief Map a template argument onto a synchronization policy.
+ * @note Policies map onto themselves, NullMutex onto SingleThreaded and any
+ *       other type is treated as mutex and maps onto MutexPolicy. This keeps
+ *       classes that used to take a raw mutex type source compatible.
+ * @tparam P   Policy or mutex type.
+ */
+template<typename P, bool = IsSyncPolicy<P>::value>
+struct PolicyOf
+{
+    /// @brief Resulting policy.
+    using type = P;
+};
+
+/// @cond DO_NOT_DOCUMENT
+template<typename M>
+struct PolicyOf<M, false>
+{
+    using type = MutexPolicy<M>;
+};
+
+template<>
+struct PolicyOf<NullMutex, false>
+{
+    using type = SingleThreaded;
+};
+/// @endcond DO_NOT_DOCUMENT
+
+} // namespace simons_lib::sync_policy
+
+#endif // SYNC_POLICY_IMPL_HPP_20190727101533